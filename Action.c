@@ -21,10 +21,13 @@ in the source distribution for its full text.
 #include "CommandScreen.h"
 #include "DynamicColumn.h"
 #include "EnvScreen.h"
+#include "ExitLogScreen.h"
+#include "FileLocksScreen.h"
 #include "FunctionBar.h"
 #include "Hashtable.h"
 #include "IncSet.h"
 #include "InfoScreen.h"
+#include "IODevicesScreen.h"
 #include "ListItem.h"
 #include "Macros.h"
 #include "MainPanel.h"
@@ -35,6 +38,8 @@ in the source distribution for its full text.
 #include "Platform.h"
 #include "Process.h"
 #include "ProcessLocksScreen.h"
+#include "Profiler.h"
+#include "ProfilerScreen.h"
 #include "ProvideCurses.h"
 #include "Row.h"
 #include "RowField.h"
@@ -43,6 +48,7 @@ in the source distribution for its full text.
 #include "SignalsPanel.h"
 #include "Table.h"
 #include "TraceScreen.h"
+#include "UserStatsScreen.h"
 #include "UsersTable.h"
 #include "Vector.h"
 #include "XUtils.h"
@@ -578,7 +584,7 @@ static Htop_Reaction actionFilterByUser(State* st) {
       if (picked == allUsers) {
          host->userId = (uid_t)-1;
       } else {
-         Action_setUserOnly(ListItem_getRef(picked), &host->userId);
+         host->userId = (uid_t)picked->key;
       }
    }
    Panel_delete((Object*)usersPanel);
@@ -639,21 +645,86 @@ static Htop_Reaction actionShowLocks(State* st) {
    return HTOP_REFRESH | HTOP_REDRAW_BAR;
 }
 
+static Htop_Reaction actionShowAllLocks(State* st) {
+   FileLocksScreen* fls = FileLocksScreen_new((ProcessTable*)st->host->processTable);
+   InfoScreen_run((InfoScreen*)fls);
+   FileLocksScreen_delete((Object*)fls);
+   clear();
+   CRT_enableDelay();
+   return HTOP_REFRESH | HTOP_REDRAW_BAR;
+}
+
+static Htop_Reaction actionShowIODevices(ATTR_UNUSED State* st) {
+   IODevicesScreen* ds = IODevicesScreen_new();
+   InfoScreen_run((InfoScreen*)ds);
+   IODevicesScreen_delete((Object*)ds);
+   clear();
+   CRT_enableDelay();
+   return HTOP_REFRESH | HTOP_REDRAW_BAR;
+}
+
+static Htop_Reaction actionShowExitLog(State* st) {
+   ExitLogScreen* els = ExitLogScreen_new(st->host, st->pauseUpdate);
+   InfoScreen_run((InfoScreen*)els);
+   ExitLogScreen_delete((Object*)els);
+   clear();
+   CRT_enableDelay();
+   return HTOP_REFRESH | HTOP_REDRAW_BAR;
+}
+
+static Htop_Reaction actionShowUserStats(State* st) {
+   UserStatsScreen* uss = UserStatsScreen_new(st->host, st->pauseUpdate);
+   InfoScreen_run((InfoScreen*)uss);
+   UserStatsScreen_delete((Object*)uss);
+   clear();
+   CRT_enableDelay();
+   return HTOP_REFRESH | HTOP_REDRAW_BAR;
+}
+
+static Htop_Reaction actionShowProfiler(ATTR_UNUSED State* st) {
+   Profiler_enable();
+
+   ProfilerScreen* ps = ProfilerScreen_new();
+   InfoScreen_run((InfoScreen*)ps);
+   ProfilerScreen_delete((Object*)ps);
+   clear();
+   CRT_enableDelay();
+   return HTOP_REFRESH | HTOP_REDRAW_BAR;
+}
+
 #if defined(HAVE_BACKTRACE_SCREEN)
 static Htop_Reaction actionBacktrace(State *st) {
    Process* selectedProcess = (Process *) Panel_getSelected((Panel *)st->mainPanel);
    const Vector* allProcesses = st->mainPanel->super.items;
 
    Vector* processes = Vector_new(Class(Process), false, VECTOR_DEFAULT_SIZE);
-   if (selectedProcess && !Process_isUserlandThread(selectedProcess)) {
-      for (int i = 0; i < Vector_size(allProcesses); i++) {
-         Process* process = (Process *)Vector_get(allProcesses, i);
-         if (process && Process_getThreadGroup(process) == Process_getThreadGroup(selectedProcess)) {
-            Vector_add(processes, process);
+
+   /* tagged processes, with their threads, are shown together */
+   Hashtable* taggedGroups = Hashtable_new(16, false);
+   for (int i = 0; i < Vector_size(allProcesses); i++) {
+      Process* process = (Process *)Vector_get(allProcesses, i);
+      if (process && process->super.tag && !Process_isUserlandThread(process))
+         Hashtable_put(taggedGroups, (ht_key_t)Process_getThreadGroup(process), process);
+   }
+   for (int i = 0; i < Vector_size(allProcesses); i++) {
+      Process* process = (Process *)Vector_get(allProcesses, i);
+      if (process && (process->super.tag || Hashtable_get(taggedGroups, (ht_key_t)Process_getThreadGroup(process)))) {
+         Vector_add(processes, process);
+      }
+   }
+   Hashtable_delete(taggedGroups);
+
+   if (Vector_size(processes) == 0) {
+      if (selectedProcess && !Process_isUserlandThread(selectedProcess)) {
+         for (int i = 0; i < Vector_size(allProcesses); i++) {
+            Process* process = (Process *)Vector_get(allProcesses, i);
+            if (process && Process_getThreadGroup(process) == Process_getThreadGroup(selectedProcess)) {
+               Vector_add(processes, process);
+            }
          }
+      } else {
+         Vector_add(processes, selectedProcess);
       }
-   } else {
-      Vector_add(processes, selectedProcess);
    }
 
    BacktracePanel* panel = BacktracePanel_new(processes, st->host->settings);
@@ -762,10 +833,21 @@ static const struct {
 #endif
    { .key = "      e: ", .roInactive = false, .info = "show process environment" },
    { .key = "      i: ", .roInactive = true,  .info = "set IO priority" },
-   { .key = "      l: ", .roInactive = true,  .info = "list open files with lsof" },
+   { .key = "      l: ", .roInactive = true,  .info = "list open files" },
    { .key = "      x: ", .roInactive = false, .info = "list file locks of process" },
+   { .key = "      X: ", .roInactive = false, .info = "list all file locks" },
    { .key = "      s: ", .roInactive = true,  .info = "trace syscalls with strace" },
    { .key = "      w: ", .roInactive = false, .info = "wrap process command in multiple lines" },
+   { .key = "      o: ", .roInactive = false, .info = "show per-device IO rates" },
+   { .key = "      A: ", .roInactive = false, .info = "show resource usage per user" },
+   { .key = "      E: ", .roInactive = false, .info = "show recently exited processes" },
+   { .key = "      D: ", .roInactive = false, .info = "show htop self-profile" },
+#ifdef HTOP_LINUX
+   { .key = "      B: ", .roInactive = false, .info = "show kernel stack of blocked threads" },
+   { .key = "      G: ", .roInactive = false, .info = "show pressure stall per cgroup" },
+   { .key = "      R: ", .roInactive = false, .info = "show resource usage per container" },
+   { .key = "      W: ", .roInactive = false, .info = "show wait channels of blocked tasks" },
+#endif
 #ifdef SCHEDULER_SUPPORT
    { .key = "      Y: ", .roInactive = true,  .info = "set scheduling policy" },
 #endif
@@ -989,7 +1071,10 @@ void Action_setBindings(Htop_Action* keys) {
    keys['='] = actionExpandOrCollapse;
    keys['>'] = actionSetSortColumn;
    keys['?'] = actionHelp;
+   keys['A'] = actionShowUserStats;
    keys['C'] = actionSetup;
+   keys['D'] = actionShowProfiler;
+   keys['E'] = actionShowExitLog;
    keys['F'] = Action_follow;
    keys['H'] = actionToggleUserlandThreads;
    keys['I'] = actionInvertSortOrder;
@@ -1001,6 +1086,7 @@ void Action_setBindings(Htop_Action* keys) {
    keys['S'] = actionSetup;
    keys['T'] = actionSortByTime;
    keys['U'] = actionUntagAll;
+   keys['X'] = actionShowAllLocks;
 #ifdef SCHEDULER_SUPPORT
    keys['Y'] = actionSetSchedPolicy;
 #endif
@@ -1020,6 +1106,7 @@ void Action_setBindings(Htop_Action* keys) {
    keys['k'] = actionKill;
    keys['l'] = actionLsof;
    keys['m'] = actionToggleMergedCommand;
+   keys['o'] = actionShowIODevices;
    keys['p'] = actionToggleProgramPath;
    keys['q'] = actionQuit;
    keys['s'] = actionStrace;
@@ -12,9 +12,11 @@ in the source distribution for its full text.
 #include <assert.h>
 #include <limits.h> // IWYU pragma: keep
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include <sys/wait.h>
 
 #include "CRT.h"
@@ -22,6 +24,7 @@ in the source distribution for its full text.
 #include "Macros.h"
 #include "Object.h"
 #include "Panel.h"
+#include "Platform.h"
 #include "Process.h"
 #include "ProvideCurses.h"
 #include "RichString.h"
@@ -38,7 +41,11 @@ static const char* const BacktraceScreenFunctions[] = {
    "Mangle  ",
 #endif
    "Full Path",
+   "Top    ",
    "Refresh",
+   "Sample ",
+   "On-CPU ",
+   "Group  ",
    "Done   ",
    NULL
 };
@@ -48,7 +55,11 @@ static const char* const BacktraceScreenKeys[] = {
    "F2",
 #endif
    "F3",
+   "F4",
    "F5",
+   "F6",
+   "F7",
+   "F8",
    "Esc",
    NULL
 };
@@ -58,15 +69,25 @@ static const int BacktraceScreenEvents[] = {
    KEY_F(2),
 #endif
    KEY_F(3),
+   KEY_F(4),
    KEY_F(5),
+   KEY_F(6),
+   KEY_F(7),
+   KEY_F(8),
    27,
 };
 
 typedef enum BacktraceScreenDisplayOptions_ {
    DEMANGLE_NAME_FUNCTION = 1 << 0,
    SHOW_FULL_PATH_OBJECT = 1 << 1,
+   SHOW_PROFILE_TOP = 1 << 2,
+   SHOW_PROFILE_RUNNING = 1 << 3,
+   GROUP_IDENTICAL_STACKS = 1 << 4,
 } BacktraceScreenDisplayOptions;
 
+/* Profile entries below this share (in per mille of the stacks) are not listed */
+#define BACKTRACE_PROFILE_MIN_PERMILLE 5
+
 BacktraceFrameData* BacktraceFrameData_new(void) {
    BacktraceFrameData* this = AllocThis(BacktraceFrameData);
    this->address = 0;
@@ -76,6 +97,7 @@ BacktraceFrameData* BacktraceFrameData_new(void) {
    this->objectPath = NULL;
    this->index = 0;
    this->isSignalFrame = false;
+   this->symbolHash = 0;
    return this;
 }
 
@@ -87,12 +109,164 @@ void BacktraceFrameData_delete(Object* object) {
    free(this);
 }
 
+/* FNV-1a over the function name and the object path */
+void BacktraceFrameData_hashSymbol(BacktraceFrameData* this) {
+   uint32_t hash = 2166136261U;
+   for (const char* p = this->functionName ? this->functionName : ""; *p; p++)
+      hash = (hash ^ (unsigned char)*p) * 16777619U;
+   hash = (hash ^ (this->functionName ? 1U : 0U)) * 16777619U;
+   for (const char* p = this->objectPath ? this->objectPath : ""; *p; p++)
+      hash = (hash ^ (unsigned char)*p) * 16777619U;
+   this->symbolHash = hash * 2654435761U;
+}
+
+static void BacktraceProfileNode_done(BacktraceProfileNode* this) {
+   for (size_t i = 0; i < this->childCount; i++)
+      BacktraceProfileNode_done(&this->children[i]);
+
+   free(this->index);
+   free(this->children);
+   free(this->functionName);
+   free(this->demangleFunctionName);
+   free(this->objectPath);
+   *this = (BacktraceProfileNode) { .functionName = NULL };
+}
+
+#ifdef HAVE_LIBUNWIND_PTRACE
+static bool BacktraceProfileNode_matches(const BacktraceProfileNode* this, const BacktraceFrameData* frame) {
+   if (!this->functionName || !frame->functionName)
+      return !this->functionName && !frame->functionName && String_eq_nullable(this->objectPath, frame->objectPath);
+
+   return String_eq(this->functionName, frame->functionName) && String_eq_nullable(this->objectPath, frame->objectPath);
+}
+
+static void BacktraceProfileNode_indexChild(BacktraceProfileNode* this, size_t position) {
+   size_t mask = this->indexSize - 1;
+   size_t i = this->children[position].hash & mask;
+   while (this->index[i])
+      i = (i + 1) & mask;
+   this->index[i] = position + 1;
+}
+
+/* The child for the function of frame, added if new; found through the index rather than a scan */
+static BacktraceProfileNode* BacktraceProfileNode_child(BacktraceProfileNode* this, const BacktraceFrameData* frame) {
+   if (this->indexSize) {
+      size_t mask = this->indexSize - 1;
+      for (size_t i = frame->symbolHash & mask; this->index[i]; i = (i + 1) & mask) {
+         BacktraceProfileNode* child = &this->children[this->index[i] - 1];
+         if (child->hash == frame->symbolHash && BacktraceProfileNode_matches(child, frame))
+            return child;
+      }
+   }
+
+   if (this->childCount == this->childSize) {
+      this->childSize = this->childSize ? this->childSize * 2 : 4;
+      this->children = xReallocArray(this->children, this->childSize, sizeof(BacktraceProfileNode));
+   }
+
+   BacktraceProfileNode* child = &this->children[this->childCount++];
+   *child = (BacktraceProfileNode) {
+      .functionName = frame->functionName ? xStrdup(frame->functionName) : NULL,
+      .demangleFunctionName = frame->demangleFunctionName ? xStrdup(frame->demangleFunctionName) : NULL,
+      .objectPath = frame->objectPath ? xStrdup(frame->objectPath) : NULL,
+      .lastStack = SIZE_MAX,
+      .hash = frame->symbolHash,
+   };
+
+   if (this->childCount * 2 > this->indexSize) {
+      free(this->index);
+      this->indexSize = this->indexSize ? this->indexSize * 2 : 8;
+      this->index = xCalloc(this->indexSize, sizeof(size_t));
+      for (size_t i = 0; i < this->childCount; i++)
+         BacktraceProfileNode_indexChild(this, i);
+   } else {
+      BacktraceProfileNode_indexChild(this, this->childCount - 1);
+   }
+   return child;
+}
+
+/* Sorting moves the children, so the index is dropped once sampling is done */
+static void BacktraceProfileNode_dropIndex(BacktraceProfileNode* this) {
+   free(this->index);
+   this->index = NULL;
+   this->indexSize = 0;
+}
+
+static void BacktraceProfile_add(BacktraceProfile* this, const BacktraceFrameData* const* frames, size_t depth) {
+   size_t stack = this->stacks++;
+
+   BacktraceProfileNode* node = &this->tree;
+   node->total++;
+   for (size_t i = depth; i > 0; i--) {
+      node = BacktraceProfileNode_child(node, frames[i - 1]);
+      node->total++;
+   }
+   node->self++;
+
+   this->top.total++;
+   for (size_t i = 0; i < depth; i++) {
+      BacktraceProfileNode* function = BacktraceProfileNode_child(&this->top, frames[i]);
+      if (function->lastStack != stack) {
+         function->lastStack = stack;
+         function->total++;
+      }
+      if (i == 0)
+         function->self++;
+   }
+}
+
+static int BacktraceProfileNode_compareByTotal(const void* a, const void* b) {
+   const BacktraceProfileNode* na = a;
+   const BacktraceProfileNode* nb = b;
+   return SPACESHIP_NUMBER(nb->total, na->total);
+}
+
+static int BacktraceProfileNode_compareBySelf(const void* a, const void* b) {
+   const BacktraceProfileNode* na = a;
+   const BacktraceProfileNode* nb = b;
+   int result = SPACESHIP_NUMBER(nb->self, na->self);
+   return result ? result : SPACESHIP_NUMBER(nb->total, na->total);
+}
+
+static void BacktraceProfileNode_sortTree(BacktraceProfileNode* this) {
+   BacktraceProfileNode_dropIndex(this);
+   qsort(this->children, this->childCount, sizeof(BacktraceProfileNode), BacktraceProfileNode_compareByTotal);
+   for (size_t i = 0; i < this->childCount; i++)
+      BacktraceProfileNode_sortTree(&this->children[i]);
+}
+#endif
+
+static void BacktraceProfile_done(BacktraceProfile* this) {
+   BacktraceProfileNode_done(&this->tree);
+   BacktraceProfileNode_done(&this->top);
+   this->stacks = 0;
+}
+
 static void BacktracePanel_displayHeader(BacktracePanel* this) {
    const BacktracePanelPrintingHelper* printingHelper = &this->printingHelper;
    const int displayOptions = this->displayOptions;
 
    bool showDemangledNames = (displayOptions & DEMANGLE_NAME_FUNCTION) && printingHelper->hasDemangledNames;
 
+   if (this->hasProfile) {
+      char processes[32] = "";
+      if (this->sampledProcesses > 1)
+         xSnprintf(processes, sizeof(processes), " in %zu processes", this->sampledProcesses);
+
+      char line[256];
+      xSnprintf(line, sizeof(line), "TOTAL%%  SELF%%  %s - %zu samples of %zu threads%s, %.1f s, %s, %s",
+         showDemangledNames ? "NAME (demangled)" : "NAME",
+         this->samples,
+         this->threads,
+         processes,
+         this->sampledSeconds,
+         (displayOptions & SHOW_PROFILE_RUNNING) ? "on-CPU threads" : "all threads",
+         (displayOptions & SHOW_PROFILE_TOP) ? "top functions" : "call tree"
+      );
+      Panel_setHeader((Panel*)this, line);
+      return;
+   }
+
    bool showFullPathObject = !!(displayOptions & SHOW_FULL_PATH_OBJECT);
    size_t maxObjLen = showFullPathObject ? printingHelper->maxObjPathLen : printingHelper->maxObjNameLen;
 
@@ -130,6 +304,9 @@ static void BacktracePanel_makePrintingHelper(const BacktracePanel* this, Backtr
 
    for (int i = 0; i < Vector_size(lines); i++) {
       const BacktracePanelRow* row = (const BacktracePanelRow*)Vector_get(lines, i);
+      if (row->type == BACKTRACE_PANEL_ROW_PROFILE && row->data.node->demangleFunctionName)
+         printingHelper->hasDemangledNames = true;
+
       if (row->type != BACKTRACE_PANEL_ROW_DATA_FRAME) {
          continue;
       }
@@ -155,54 +332,419 @@ static void BacktracePanel_makePrintingHelper(const BacktracePanel* this, Backtr
    printingHelper->maxAddrLen = MAXIMUM(countDigits(longestAddress, 16), printingHelper->maxAddrLen);
 }
 
-static void BacktracePanel_makeBacktrace(Vector* frames, pid_t pid, char** error) {
+static void BacktracePanel_makeBacktraces(BacktracePanel* this, Vector** stacks, char** errors, size_t count) {
 #ifdef HAVE_LIBUNWIND_PTRACE
-   UnwindPtrace_makeBacktrace(frames, pid, error);
+   UnwindPtraceTask* tasks = xCalloc(count, sizeof(UnwindPtraceTask));
+   for (size_t i = 0; i < count; i++) {
+      const Process* process = (const Process*)Vector_get(this->processes, (int)i);
+      tasks[i] = (UnwindPtraceTask) {
+         .pid = Process_getPid(process),
+         .tgid = Process_getThreadGroup(process),
+         .frames = stacks[i],
+      };
+   }
+
+   UnwindPtrace_makeBacktraces(this->unwindCache, tasks, count);
+
+   for (size_t i = 0; i < count; i++)
+      errors[i] = tasks[i].error;
+   free(tasks);
 #else
-   (void)frames;
-   (void)pid;
-   xAsprintf(error, "The backtrace screen is not implemented");
+   (void)this;
+   (void)stacks;
+   for (size_t i = 0; i < count; i++)
+      xAsprintf(&errors[i], "The backtrace screen is not implemented");
 #endif
 }
 
-static void BacktracePanel_populateFrames(BacktracePanel* this) {
-   char* error = NULL;
+/* For stacks not shown; the rows own the frames of the shown ones */
+static void BacktracePanel_discardFrames(Vector* frames) {
+   for (int i = 0; i < Vector_size(frames); i++)
+      BacktraceFrameData_delete(Vector_get(frames, i));
+   Vector_prune(frames);
+}
+
+static void BacktracePanel_addFrames(BacktracePanel* this, const Process* process, Vector* frames) {
+   for (int j = 0; j < Vector_size(frames); j++) {
+      BacktracePanelRow* row = BacktracePanelRow_new(this);
+      row->process = process;
+      row->type = BACKTRACE_PANEL_ROW_DATA_FRAME;
+      row->data.frame = (BacktraceFrameData*)Vector_get(frames, j);
+
+      Panel_add((Panel*)this, (Object*)row);
+   }
+}
+
+static void BacktracePanel_addError(BacktracePanel* this, const Process* process, char* error) {
+   BacktracePanelRow* errorRow = BacktracePanelRow_new(this);
+   errorRow->process = process;
+   errorRow->type = BACKTRACE_PANEL_ROW_ERROR;
+   errorRow->data.error = error;
+   Panel_add((Panel*)this, (Object*)errorRow);
+}
+
+/* Frames are the same if they are at the same place of the same function */
+static bool BacktraceFrameData_sameLocation(const BacktraceFrameData* a, const BacktraceFrameData* b) {
+   if (!a->functionName || !b->functionName)
+      return !a->functionName && !b->functionName && a->address == b->address;
+
+   return a->offset == b->offset &&
+          String_eq(a->functionName, b->functionName) &&
+          String_eq_nullable(a->objectPath, b->objectPath);
+}
+
+static uint32_t BacktracePanel_hashStack(const Vector* frames) {
+   uint32_t hash = 2166136261U;
+   for (int i = 0; i < Vector_size(frames); i++) {
+      const BacktraceFrameData* frame = (const BacktraceFrameData*)Vector_get(frames, i);
+      if (frame->functionName) {
+         for (const unsigned char* p = (const unsigned char*)frame->functionName; *p; p++)
+            hash = (hash ^ *p) * 16777619U;
+         hash = (hash ^ (uint32_t)frame->offset) * 16777619U;
+      } else {
+         hash = (hash ^ (uint32_t)frame->address) * 16777619U;
+      }
+   }
+   return hash;
+}
+
+static bool BacktracePanel_sameStack(const Vector* a, const Vector* b) {
+   if (Vector_size(a) != Vector_size(b))
+      return false;
+
+   for (int i = 0; i < Vector_size(a); i++) {
+      if (!BacktraceFrameData_sameLocation((const BacktraceFrameData*)Vector_get(a, i), (const BacktraceFrameData*)Vector_get(b, i)))
+         return false;
+   }
+   return true;
+}
+
+typedef struct BacktraceStackGroup_ {
+   size_t first;        /* index of the stack shown for the group */
+   size_t last;         /* to append members in order */
+   size_t count;
+   uint32_t hash;
+} BacktraceStackGroup;
+
+static int BacktraceStackGroup_compare(const void* a, const void* b) {
+   const BacktraceStackGroup* ga = a;
+   const BacktraceStackGroup* gb = b;
+   int result = SPACESHIP_NUMBER(gb->count, ga->count);
+   return result ? result : SPACESHIP_NUMBER(ga->first, gb->first);
+}
+
+/* Shows every distinct stack once, with the threads sharing it, most shared first */
+static void BacktracePanel_addGroupedStacks(BacktracePanel* this, Vector** stacks, char** errors, size_t count) {
+   BacktraceStackGroup* groups = xCalloc(count, sizeof(BacktraceStackGroup));
+   size_t* nextMember = xMallocArray(count, sizeof(size_t));
+   size_t groupCount = 0;
+
+   for (size_t i = 0; i < count; i++) {
+      nextMember[i] = SIZE_MAX;
+      if (errors[i])
+         continue;
+
+      uint32_t hash = BacktracePanel_hashStack(stacks[i]);
+      size_t g = 0;
+      while (g < groupCount && !(groups[g].hash == hash && BacktracePanel_sameStack(stacks[groups[g].first], stacks[i])))
+         g++;
+
+      if (g == groupCount) {
+         groups[groupCount++] = (BacktraceStackGroup) { .first = i, .last = i, .count = 1, .hash = hash };
+      } else {
+         nextMember[groups[g].last] = i;
+         groups[g].last = i;
+         groups[g].count++;
+      }
+   }
+
+   qsort(groups, groupCount, sizeof(BacktraceStackGroup), BacktraceStackGroup_compare);
+
+   for (size_t g = 0; g < groupCount; g++) {
+      const BacktraceStackGroup* group = &groups[g];
+      const Process* process = (const Process*)Vector_get(this->processes, (int)group->first);
 
-   Vector* data = Vector_new(Class(BacktraceFrameData), false, VECTOR_DEFAULT_SIZE);
-   for (int i = 0; i < Vector_size(this->processes); i++) {
-      const Process* process = (Process*)Vector_get(this->processes, i);
-      BacktracePanel_makeBacktrace(data, Process_getPid(process), &error);
+      char label[256];
+      size_t len = (size_t)xSnprintf(label, sizeof(label), "%zu thread%s in this stack:", group->count, group->count == 1 ? "" : "s");
+      bool truncated = false;
+      for (size_t i = group->first; i != SIZE_MAX; i = nextMember[i]) {
+         if (i != group->first)
+            BacktracePanel_discardFrames(stacks[i]);
 
+         if (truncated)
+            continue;
+
+         if (len + 16 >= sizeof(label)) {
+            xSnprintf(label + len, sizeof(label) - len, " ...");
+            truncated = true;
+            continue;
+         }
+         const Process* member = (const Process*)Vector_get(this->processes, (int)i);
+         len += (size_t)xSnprintf(label + len, sizeof(label) - len, " %d", Process_getPid(member));
+      }
+
+      BacktracePanelRow* header = BacktracePanelRow_new(this);
+      header->process = process;
+      header->type = BACKTRACE_PANEL_ROW_STACK_GROUP;
+      header->data.label = xStrdup(label);
+      Panel_add((Panel*)this, (Object*)header);
+
+      BacktracePanel_addFrames(this, process, stacks[group->first]);
+   }
+
+   for (size_t i = 0; i < count; i++) {
+      if (!errors[i])
+         continue;
+
+      const Process* process = (const Process*)Vector_get(this->processes, (int)i);
       BacktracePanelRow* header = BacktracePanelRow_new(this);
       header->process = process;
       header->type = BACKTRACE_PANEL_ROW_PROCESS_INFORMATION;
       Panel_add((Panel*)this, (Object*)header);
 
-      if (!error) {
-         for (int j = 0; j < Vector_size(data); j++) {
-            BacktracePanelRow* row = BacktracePanelRow_new(this);
-            row->process = process;
-            row->type = BACKTRACE_PANEL_ROW_DATA_FRAME;
-            row->data.frame = (BacktraceFrameData*)Vector_get(data, j);
+      BacktracePanel_addError(this, process, errors[i]);
+      BacktracePanel_discardFrames(stacks[i]);
+   }
 
-            Panel_add((Panel*)this, (Object*)row);
+   free(nextMember);
+   free(groups);
+}
+
+static void BacktracePanel_populateFrames(BacktracePanel* this) {
+   size_t count = (size_t)Vector_size(this->processes);
+   Vector** stacks = xCalloc(count ? count : 1, sizeof(Vector*));
+   char** errors = xCalloc(count ? count : 1, sizeof(char*));
+   for (size_t i = 0; i < count; i++)
+      stacks[i] = Vector_new(Class(BacktraceFrameData), false, VECTOR_DEFAULT_SIZE);
+
+   BacktracePanel_makeBacktraces(this, stacks, errors, count);
+
+   if (this->displayOptions & GROUP_IDENTICAL_STACKS) {
+      BacktracePanel_addGroupedStacks(this, stacks, errors, count);
+   } else {
+      for (size_t i = 0; i < count; i++) {
+         const Process* process = (const Process*)Vector_get(this->processes, (int)i);
+
+         BacktracePanelRow* header = BacktracePanelRow_new(this);
+         header->process = process;
+         header->type = BACKTRACE_PANEL_ROW_PROCESS_INFORMATION;
+         Panel_add((Panel*)this, (Object*)header);
+
+         if (!errors[i]) {
+            BacktracePanel_addFrames(this, process, stacks[i]);
+         } else {
+            BacktracePanel_addError(this, process, errors[i]);
+            BacktracePanel_discardFrames(stacks[i]);
          }
-      } else {
+      }
+   }
+
+   for (size_t i = 0; i < count; i++)
+      Vector_delete(stacks[i]);
+   free(errors);
+   free(stacks);
+
+   BacktracePanelPrintingHelper* printingHelper = &this->printingHelper;
+   BacktracePanel_makePrintingHelper(this, printingHelper);
+   BacktracePanel_displayHeader(this);
+}
+
+static void BacktracePanel_addProfileRows(BacktracePanel* this, const BacktraceProfileNode* node, const BacktraceProfile* profile, unsigned int depth, bool recurse) {
+   for (size_t i = 0; i < node->childCount; i++) {
+      const BacktraceProfileNode* child = &node->children[i];
+      if (child->total * 1000 < profile->stacks * BACKTRACE_PROFILE_MIN_PERMILLE)
+         continue;
+
+      BacktracePanelRow* row = BacktracePanelRow_new(this);
+      row->type = BACKTRACE_PANEL_ROW_PROFILE;
+      row->data.node = child;
+      row->depth = depth;
+      Panel_add((Panel*)this, (Object*)row);
+
+      if (recurse)
+         BacktracePanel_addProfileRows(this, child, profile, depth + 1, true);
+   }
+}
+
+static void BacktracePanel_populateProfile(BacktracePanel* this) {
+   const BacktraceProfile* profile = &this->profiles[(this->displayOptions & SHOW_PROFILE_RUNNING) ? BACKTRACE_PROFILE_RUNNING : BACKTRACE_PROFILE_ALL];
+
+   if (!profile->stacks) {
+      BacktracePanelRow* errorRow = BacktracePanelRow_new(this);
+      errorRow->type = BACKTRACE_PANEL_ROW_ERROR;
+      errorRow->data.error = xStrdup("No stacks were sampled");
+      Panel_add((Panel*)this, (Object*)errorRow);
+   } else if (this->displayOptions & SHOW_PROFILE_TOP) {
+      BacktracePanel_addProfileRows(this, &profile->top, profile, 0, false);
+   } else {
+      BacktracePanel_addProfileRows(this, &profile->tree, profile, 0, true);
+   }
+
+   BacktracePanel_makePrintingHelper(this, &this->printingHelper);
+   BacktracePanel_displayHeader(this);
+}
+
+static void BacktracePanel_clearProfile(BacktracePanel* this) {
+   for (size_t i = 0; i < BACKTRACE_PROFILE_COUNT; i++)
+      BacktraceProfile_done(&this->profiles[i]);
+
+   this->hasProfile = false;
+   this->samples = 0;
+   this->threads = 0;
+   this->sampledProcesses = 0;
+   this->sampledSeconds = 0.0;
+}
+
+#ifdef HAVE_LIBUNWIND_PTRACE
+static void BacktracePanel_addStack(void* data, bool running, const BacktraceFrameData* const* frames, size_t depth) {
+   BacktracePanel* this = data;
+
+   BacktraceProfile_add(&this->profiles[BACKTRACE_PROFILE_ALL], frames, depth);
+   if (running)
+      BacktraceProfile_add(&this->profiles[BACKTRACE_PROFILE_RUNNING], frames, depth);
+}
+
+static void BacktracePanel_showProgress(BacktracePanel* this, pid_t pid, size_t processes, size_t sample, size_t samples) {
+   char line[128];
+   if (processes > 1) {
+      xSnprintf(line, sizeof(line), "Sampling %zu processes: %zu/%zu samples (any key to stop)", processes, sample, samples);
+   } else {
+      xSnprintf(line, sizeof(line), "Sampling process %d: %zu/%zu samples (any key to stop)", pid, sample, samples);
+   }
+   Panel_setHeader((Panel*)this, line);
+   Panel_draw((Panel*)this, false, true, true, false);
+   refresh();
+}
+
+/*
+ * Samples the stacks of all threads of the shown processes at the configured
+ * rate. All threads of a process are stopped together for each sample and
+ * the unwinding state is kept by its sampler, so a sample costs one short
+ * stop of each process. Processes that cannot be traced are left out; the
+ * errors are only shown if none can.
+ */
+static void BacktracePanel_sample(BacktracePanel* this) {
+   size_t count = (size_t)Vector_size(this->processes);
+   if (count == 0)
+      return;
+
+   Panel_prune((Panel*)this);
+   BacktracePanel_clearProfile(this);
+
+   /* one sampler per thread group, covering all of its threads */
+   UnwindPtraceSampler** samplers = xCalloc(count, sizeof(UnwindPtraceSampler*));
+   pid_t* pids = xCalloc(count, sizeof(pid_t));
+   char** errors = xCalloc(count, sizeof(char*));
+   size_t groups = 0;
+   size_t samplerCount = 0;
+   pid_t sampledPid = 0;
+   for (size_t i = 0; i < count; i++) {
+      pid_t pid = Process_getThreadGroup((const Process*)Vector_get(this->processes, (int)i));
+
+      bool known = false;
+      for (size_t j = 0; j < groups && !known; j++)
+         known = pids[j] == pid;
+      if (known)
+         continue;
+
+      pids[groups] = pid;
+      samplers[groups] = UnwindPtraceSampler_new(this->unwindCache, pid, &errors[groups]);
+      if (samplers[groups]) {
+         samplerCount++;
+         sampledPid = pid;
+      }
+      groups++;
+   }
+
+   if (!samplerCount) {
+      for (size_t i = 0; i < groups; i++) {
          BacktracePanelRow* errorRow = BacktracePanelRow_new(this);
-         errorRow->process = process;
          errorRow->type = BACKTRACE_PANEL_ROW_ERROR;
-         errorRow->data.error = error;
-         error = NULL;
+         errorRow->data.error = errors[i];
          Panel_add((Panel*)this, (Object*)errorRow);
       }
+      free(errors);
+      free(pids);
+      free(samplers);
+      return;
+   }
+
+   for (size_t i = 0; i < groups; i++)
+      free(errors[i]);
+   free(errors);
+
+   const Settings* settings = this->settings;
+   size_t samples = (size_t)settings->backtraceSampleRate * (size_t)settings->backtraceSampleSeconds;
+   uint64_t periodNs = UINT64_C(1000000000) / (uint64_t)settings->backtraceSampleRate;
+
+   uint64_t startMs;
+   Platform_gettime_monotonic(&startMs);
+   uint64_t lastProgressMs = 0;
+
+   CRT_disableDelay();
 
-      Vector_prune(data);
+   size_t sample = 0;
+   for (; sample < samples; sample++) {
+      for (size_t i = 0; i < groups; i++) {
+         if (samplers[i])
+            UnwindPtraceSampler_sample(samplers[i], BacktracePanel_addStack, this);
+      }
+
+      uint64_t nowMs;
+      Platform_gettime_monotonic(&nowMs);
+      if (nowMs - lastProgressMs >= 250) {
+         BacktracePanel_showProgress(this, sampledPid, samplerCount, sample + 1, samples);
+         lastProgressMs = nowMs;
+      }
+
+      if (getch() != ERR)
+         break;
+
+      /* pace against the start so that time spent unwinding does not add up */
+      uint64_t dueNs = (uint64_t)(sample + 1) * periodNs;
+      uint64_t elapsedNs = (nowMs - startMs) * UINT64_C(1000000);
+      if (dueNs > elapsedNs) {
+         uint64_t waitNs = dueNs - elapsedNs;
+         struct timespec delay = { .tv_sec = (time_t)(waitNs / UINT64_C(1000000000)), .tv_nsec = (long)(waitNs % UINT64_C(1000000000)) };
+         nanosleep(&delay, NULL);
+      }
    }
-   Vector_delete(data);
 
-   BacktracePanelPrintingHelper* printingHelper = &this->printingHelper;
-   BacktracePanel_makePrintingHelper(this, printingHelper);
-   BacktracePanel_displayHeader(this);
+   CRT_enableDelay();
+
+   uint64_t endMs;
+   Platform_gettime_monotonic(&endMs);
+
+   this->hasProfile = true;
+   this->samples = sample;
+   this->sampledProcesses = samplerCount;
+   this->sampledSeconds = (endMs - startMs) / 1000.0;
+   for (size_t i = 0; i < groups; i++) {
+      if (samplers[i])
+         this->threads += UnwindPtraceSampler_threadCount(samplers[i]);
+      UnwindPtraceSampler_delete(samplers[i]);
+   }
+   free(pids);
+   free(samplers);
+
+   for (size_t i = 0; i < BACKTRACE_PROFILE_COUNT; i++) {
+      BacktraceProfileNode_sortTree(&this->profiles[i].tree);
+      BacktraceProfileNode_dropIndex(&this->profiles[i].top);
+      qsort(this->profiles[i].top.children, this->profiles[i].top.childCount, sizeof(BacktraceProfileNode), BacktraceProfileNode_compareBySelf);
+   }
+
+   BacktracePanel_populateProfile(this);
+}
+#endif
+
+static void BacktracePanel_repopulate(BacktracePanel* this) {
+   Panel_prune((Panel*)this);
+   if (this->hasProfile) {
+      BacktracePanel_populateProfile(this);
+   } else {
+      BacktracePanel_populateFrames(this);
+   }
+   this->super.needsRedraw = true;
 }
 
 static HandlerResult BacktracePanel_eventHandler(Panel* super, int ch) {
@@ -235,10 +777,38 @@ static HandlerResult BacktracePanel_eventHandler(Panel* super, int ch) {
       BacktracePanel_displayHeader(this);
       break;
 
+   case KEY_F(4):
+      *displayOptions ^= SHOW_PROFILE_TOP;
+      FunctionBar_setLabel(super->defaultBar, KEY_F(4), (*displayOptions & SHOW_PROFILE_TOP) ? "Tree   " : "Top    ");
+      if (this->hasProfile)
+         BacktracePanel_repopulate(this);
+      break;
+
    case KEY_CTRL('L'):
    case KEY_F(5):
-      Panel_prune(super);
-      BacktracePanel_populateFrames(this);
+      BacktracePanel_clearProfile(this);
+      BacktracePanel_repopulate(this);
+      break;
+
+#ifdef HAVE_LIBUNWIND_PTRACE
+   case KEY_F(6):
+      BacktracePanel_sample(this);
+      this->super.needsRedraw = true;
+      break;
+#endif
+
+   case KEY_F(7):
+      *displayOptions ^= SHOW_PROFILE_RUNNING;
+      FunctionBar_setLabel(super->defaultBar, KEY_F(7), (*displayOptions & SHOW_PROFILE_RUNNING) ? "All    " : "On-CPU ");
+      if (this->hasProfile)
+         BacktracePanel_repopulate(this);
+      break;
+
+   case KEY_F(8):
+      *displayOptions ^= GROUP_IDENTICAL_STACKS;
+      FunctionBar_setLabel(super->defaultBar, KEY_F(8), (*displayOptions & GROUP_IDENTICAL_STACKS) ? "Ungroup" : "Group  ");
+      if (!this->hasProfile)
+         BacktracePanel_repopulate(this);
       break;
    }
 
@@ -255,10 +825,32 @@ BacktracePanel* BacktracePanel_new(Vector* processes, const Settings* settings)
    this->printingHelper.maxObjPathLen = strlen("FILE");
    this->printingHelper.hasDemangledNames = false;
 
+   for (size_t i = 0; i < BACKTRACE_PROFILE_COUNT; i++)
+      this->profiles[i] = (BacktraceProfile) { .stacks = 0 };
+   this->hasProfile = false;
+   this->samples = 0;
+   this->threads = 0;
+   this->sampledProcesses = 0;
+   this->sampledSeconds = 0.0;
+
+#ifdef HAVE_LIBUNWIND_PTRACE
+   this->unwindCache = UnwindPtraceCache_new();
+#else
+   this->unwindCache = NULL;
+#endif
+
+   /* stacks of several processes are best compared grouped */
+   bool severalProcesses = false;
+   for (int i = 1; i < Vector_size(processes); i++) {
+      if (Process_getThreadGroup((const Process*)Vector_get(processes, i)) != Process_getThreadGroup((const Process*)Vector_get(processes, 0)))
+         severalProcesses = true;
+   }
+
    this->settings = settings;
    this->displayOptions =
       DEMANGLE_NAME_FUNCTION |
       (settings->showProgramPath ? SHOW_FULL_PATH_OBJECT : 0) |
+      (severalProcesses ? GROUP_IDENTICAL_STACKS : 0) |
       0;
 
    Panel* super = (Panel*) this;
@@ -268,6 +860,8 @@ BacktracePanel* BacktracePanel_new(Vector* processes, const Settings* settings)
 
    bool showFullPathObject = !!(this->displayOptions & SHOW_FULL_PATH_OBJECT);
    FunctionBar_setLabel(super->defaultBar, KEY_F(3), showFullPathObject ? "Basename " : "Full Path");
+   if (severalProcesses)
+      FunctionBar_setLabel(super->defaultBar, KEY_F(8), "Ungroup");
 
    BacktracePanel_populateFrames(this);
 
@@ -277,6 +871,10 @@ BacktracePanel* BacktracePanel_new(Vector* processes, const Settings* settings)
 void BacktracePanel_delete(Object* object) {
    BacktracePanel* this = (BacktracePanel*)object;
    Vector_delete(this->processes);
+   BacktracePanel_clearProfile(this);
+#ifdef HAVE_LIBUNWIND_PTRACE
+   UnwindPtraceCache_delete(this->unwindCache);
+#endif
    Panel_delete(object);
 }
 
@@ -413,6 +1011,48 @@ static void BacktracePanelRow_displayFrame(const Object* super, RichString* out)
    free(line);
 }
 
+static void BacktracePanelRow_displayProfile(const Object* super, RichString* out) {
+   const BacktracePanelRow* row = (const BacktracePanelRow*)super;
+   assert(row);
+   assert(row->type == BACKTRACE_PANEL_ROW_PROFILE);
+
+   const BacktracePanel* panel = row->panel;
+   const int displayOptions = panel->displayOptions;
+   const BacktraceProfileNode* node = row->data.node;
+   const BacktraceProfile* profile = &panel->profiles[(displayOptions & SHOW_PROFILE_RUNNING) ? BACKTRACE_PROFILE_RUNNING : BACKTRACE_PROFILE_ALL];
+
+   double stacks = profile->stacks ? (double)profile->stacks : 1.0;
+   char buffer[32];
+   int len = xSnprintf(buffer, sizeof(buffer), "%5.1f%% %5.1f%%  ", 100.0 * node->total / stacks, 100.0 * node->self / stacks);
+   RichString_appendnAscii(out, CRT_colors[node->self ? DEFAULT_COLOR : PROCESS_SHADOW], buffer, len);
+
+   for (unsigned int i = 0; i < MINIMUM(row->depth, 32U); i++)
+      RichString_appendAscii(out, CRT_colors[PROCESS_TREE], i + 1 < row->depth ? "  " : "`-");
+
+   const char* functionName = "???";
+   if ((displayOptions & DEMANGLE_NAME_FUNCTION) && node->demangleFunctionName) {
+      functionName = node->demangleFunctionName;
+   } else if (node->functionName) {
+      functionName = node->functionName;
+   }
+   RichString_appendWide(out, CRT_colors[node->functionName ? DEFAULT_COLOR : PROCESS_SHADOW], functionName);
+
+   if (node->objectPath) {
+      const char* objectDisplayed = (displayOptions & SHOW_FULL_PATH_OBJECT) ? node->objectPath : getBasename(node->objectPath);
+      RichString_appendAscii(out, CRT_colors[PROCESS_SHADOW], " (");
+      RichString_appendWide(out, CRT_colors[PROCESS_SHADOW], objectDisplayed);
+      RichString_appendAscii(out, CRT_colors[PROCESS_SHADOW], ")");
+   }
+}
+
+static void BacktracePanelRow_displayStackGroup(const Object* super, RichString* out) {
+   const BacktracePanelRow* row = (const BacktracePanelRow*)super;
+   assert(row);
+   assert(row->type == BACKTRACE_PANEL_ROW_STACK_GROUP);
+
+   RichString_appendAscii(out, CRT_colors[DEFAULT_COLOR] | A_BOLD, row->data.label);
+}
+
 static void BacktracePanelRow_displayError(const Object* super, RichString* out) {
    const BacktracePanelRow* row = (const BacktracePanelRow*)super;
    assert(row);
@@ -438,12 +1078,21 @@ static void BacktracePanelRow_display(const Object* super, RichString* out) {
    case BACKTRACE_PANEL_ROW_ERROR:
       BacktracePanelRow_displayError(super, out);
       break;
+
+   case BACKTRACE_PANEL_ROW_PROFILE:
+      BacktracePanelRow_displayProfile(super, out);
+      break;
+
+   case BACKTRACE_PANEL_ROW_STACK_GROUP:
+      BacktracePanelRow_displayStackGroup(super, out);
+      break;
    }
 }
 
 BacktracePanelRow* BacktracePanelRow_new(const BacktracePanel* panel) {
    BacktracePanelRow* this = AllocThis(BacktracePanelRow);
    this->panel = panel;
+   this->depth = 0;
    return this;
 }
 
@@ -457,6 +1106,10 @@ void BacktracePanelRow_delete(Object* object) {
    case BACKTRACE_PANEL_ROW_ERROR:
       free(this->data.error);
       break;
+
+   case BACKTRACE_PANEL_ROW_STACK_GROUP:
+      free(this->data.label);
+      break;
    }
    free(this);
 }
@@ -9,12 +9,14 @@ in the source distribution for its full text.
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 #include "Object.h"
 #include "Panel.h"
 #include "Process.h"
 #include "Settings.h"
 #include "Vector.h"
+#include "generic/UnwindPtrace.h"
 
 
 typedef struct BacktraceFrameData_ {
@@ -27,8 +29,40 @@ typedef struct BacktraceFrameData_ {
    char* objectPath;
    unsigned int index;
    bool isSignalFrame;
+   uint32_t symbolHash;    /* of functionName and objectPath; set for sampled frames */
 } BacktraceFrameData;
 
+/* A function in the sampled stacks, identified by its name and object */
+typedef struct BacktraceProfileNode_ {
+   char* functionName;
+   char* demangleFunctionName;
+   char* objectPath;
+   size_t total;        /* stacks containing the function */
+   size_t self;         /* stacks with the function as innermost frame */
+   size_t lastStack;    /* last stack counted in total, to count recursion once */
+   uint32_t hash;       /* symbolHash of its frames */
+
+   struct BacktraceProfileNode_* children;
+   size_t childCount;
+   size_t childSize;
+
+   /* children by hash while sampling: positions plus one, open addressing, size is a power of two */
+   size_t* index;
+   size_t indexSize;
+} BacktraceProfileNode;
+
+typedef struct BacktraceProfile_ {
+   BacktraceProfileNode tree;   /* call tree, rooted at the outermost frames */
+   BacktraceProfileNode top;    /* flat list of all functions */
+   size_t stacks;
+} BacktraceProfile;
+
+typedef enum BacktraceProfileKind_ {
+   BACKTRACE_PROFILE_ALL,
+   BACKTRACE_PROFILE_RUNNING,
+   BACKTRACE_PROFILE_COUNT
+} BacktraceProfileKind;
+
 typedef struct BacktracePanelPrintingHelper_ {
    size_t maxAddrLen;
    size_t maxFrameNumLen;
@@ -44,12 +78,22 @@ typedef struct BacktracePanel_ {
    BacktracePanelPrintingHelper printingHelper;
    const Settings* settings;
    int displayOptions;
+   UnwindPtraceCache* unwindCache;   /* kept across refreshes and samples */
+
+   BacktraceProfile profiles[BACKTRACE_PROFILE_COUNT];
+   bool hasProfile;
+   size_t samples;
+   size_t threads;
+   size_t sampledProcesses;
+   double sampledSeconds;
 } BacktracePanel;
 
 typedef enum BacktracePanelRowType_ {
    BACKTRACE_PANEL_ROW_DATA_FRAME,
    BACKTRACE_PANEL_ROW_ERROR,
-   BACKTRACE_PANEL_ROW_PROCESS_INFORMATION
+   BACKTRACE_PANEL_ROW_PROCESS_INFORMATION,
+   BACKTRACE_PANEL_ROW_PROFILE,
+   BACKTRACE_PANEL_ROW_STACK_GROUP
 } BacktracePanelRowType;
 
 typedef struct BacktracePanelRow_ {
@@ -59,7 +103,10 @@ typedef struct BacktracePanelRow_ {
    union {
       BacktraceFrameData* frame;
       char* error;
+      const BacktraceProfileNode* node;
+      char* label;
    } data;
+   unsigned int depth;
 
    const BacktracePanel* panel;
    const Process* process;
@@ -68,6 +115,9 @@ typedef struct BacktracePanelRow_ {
 BacktraceFrameData* BacktraceFrameData_new(void);
 void BacktraceFrameData_delete(Object* object);
 
+/* Sets symbolHash, which groups the frames of a function in the sampled profile */
+void BacktraceFrameData_hashSymbol(BacktraceFrameData* this);
+
 BacktracePanel* BacktracePanel_new(Vector* processes, const Settings* settings);
 void BacktracePanel_delete(Object* object);
 
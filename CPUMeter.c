@@ -10,6 +10,8 @@ in the source distribution for its full text.
 #include "CPUMeter.h"
 
 #include <assert.h>
+#include <limits.h>
+#include <math.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdlib.h>
@@ -20,6 +22,7 @@ in the source distribution for its full text.
 #include "Macros.h"
 #include "Object.h"
 #include "Platform.h"
+#include "ProvideCurses.h"
 #include "RichString.h"
 #include "Settings.h"
 #include "XUtils.h"
@@ -387,6 +390,225 @@ static void SingleColCPUsMeter_draw(Meter* this, int x, int y, int w) {
    }
 }
 
+/* Heatmap meters: every CPU (or group of CPUs) is a single colored cell */
+
+#define CPU_HEATMAP_CELLS_PER_LINE 64
+#define CPU_HEATMAP_MAX_LINES 4
+
+typedef struct CPUHeatmapData_ {
+   unsigned int cpus;        /* size of loads and groups */
+   double* loads;
+   int* groups;
+   size_t groupsSize;        /* size of the per group arrays */
+   double* sums;
+   unsigned int* online;
+   unsigned int* members;
+   size_t count;
+   double* cells;            /* average load per group, NAN if all its CPUs are offline */
+   bool available;
+} CPUHeatmapData;
+
+static CPUGrouping CPUHeatmapMeter_grouping(const Meter* this) {
+   const char* name = Meter_name(this);
+   if (String_eq(name, "CoreHeatmap"))
+      return CPU_GROUP_CORE;
+   if (String_eq(name, "CCDHeatmap"))
+      return CPU_GROUP_CCD;
+   if (String_eq(name, "NodeHeatmap"))
+      return CPU_GROUP_NODE;
+   return CPU_GROUP_THREAD;
+}
+
+static void CPUHeatmapMeter_init(Meter* this) {
+   if (!this->meterData)
+      this->meterData = xCalloc(1, sizeof(CPUHeatmapData));
+}
+
+static void CPUHeatmapMeter_done(Meter* this) {
+   CPUHeatmapData* data = this->meterData;
+   free(data->loads);
+   free(data->groups);
+   free(data->sums);
+   free(data->online);
+   free(data->members);
+   free(data->cells);
+   free(data);
+   this->meterData = NULL;
+}
+
+static void CPUHeatmapMeter_updateValues(Meter* this) {
+   CPUHeatmapData* data = this->meterData;
+   unsigned int cpus = this->host->existingCPUs;
+
+   if (cpus != data->cpus) {
+      data->loads = xReallocArray(data->loads, cpus, sizeof(double));
+      data->groups = xReallocArray(data->groups, cpus, sizeof(int));
+      data->cpus = cpus;
+   }
+
+   data->count = 0;
+   this->values[0] = 0.0;
+   this->values[1] = 0.0;
+
+   data->available = cpus > 0 && Platform_getCPULoads(this->host, CPUHeatmapMeter_grouping(this), data->loads, data->groups);
+   if (!data->available)
+      return;
+
+   int maxGroup = 0;
+   for (unsigned int i = 0; i < cpus; i++) {
+      if (data->groups[i] < 0)
+         data->groups[i] = 0;
+      maxGroup = MAXIMUM(maxGroup, data->groups[i]);
+   }
+
+   size_t groupsSize = (size_t)maxGroup + 1;
+   if (groupsSize > data->groupsSize) {
+      data->sums = xReallocArray(data->sums, groupsSize, sizeof(double));
+      data->online = xReallocArray(data->online, groupsSize, sizeof(unsigned int));
+      data->members = xReallocArray(data->members, groupsSize, sizeof(unsigned int));
+      data->cells = xReallocArray(data->cells, groupsSize, sizeof(double));
+      data->groupsSize = groupsSize;
+   }
+   memset(data->sums, 0, groupsSize * sizeof(double));
+   memset(data->online, 0, groupsSize * sizeof(unsigned int));
+   memset(data->members, 0, groupsSize * sizeof(unsigned int));
+
+   double total = 0.0;
+   unsigned int totalOnline = 0;
+   for (unsigned int i = 0; i < cpus; i++) {
+      int group = data->groups[i];
+      data->members[group]++;
+
+      double load = data->loads[i];
+      if (isNaN(load))
+         continue;
+
+      data->sums[group] += load;
+      data->online[group]++;
+      total += load;
+      totalOnline++;
+   }
+
+   /* groups without any CPU (gaps in the numbering) take no cell */
+   double max = 0.0;
+   for (size_t group = 0; group < groupsSize; group++) {
+      if (!data->members[group])
+         continue;
+
+      double cell = data->online[group] ? data->sums[group] / data->online[group] : NAN;
+      if (isNonnegative(cell))
+         max = MAXIMUM(max, cell);
+      data->cells[data->count++] = cell;
+   }
+
+   this->values[0] = totalOnline ? total / totalOnline : 0.0;
+   this->values[1] = max;
+}
+
+static void CPUHeatmapMeter_updateMode(Meter* this, MeterModeId mode) {
+   this->mode = mode;
+
+   /* the topology does not change at runtime, size the grid once */
+   CPUHeatmapMeter_updateValues(this);
+   const CPUHeatmapData* data = this->meterData;
+   size_t lines = (data->count + CPU_HEATMAP_CELLS_PER_LINE - 1) / CPU_HEATMAP_CELLS_PER_LINE;
+   this->h = (int)CLAMP(lines, 1, CPU_HEATMAP_MAX_LINES);
+}
+
+static void CPUHeatmapMeter_display(const Object* cast, RichString* out) {
+   const Meter* this = (const Meter*)cast;
+   const CPUHeatmapData* data = this->meterData;
+
+   if (!data || !data->available) {
+      RichString_writeAscii(out, CRT_colors[METER_VALUE_ERROR], "no data");
+      return;
+   }
+
+   char buffer[32];
+   int len = xSnprintf(buffer, sizeof(buffer), "%5.1f%% ", this->values[0]);
+   RichString_appendAscii(out, CRT_colors[METER_TEXT], "avg:");
+   RichString_appendnAscii(out, CRT_colors[CPU_NORMAL], buffer, len);
+   len = xSnprintf(buffer, sizeof(buffer), "%5.1f%%", this->values[1]);
+   RichString_appendAscii(out, CRT_colors[METER_TEXT], "max:");
+   RichString_appendnAscii(out, CRT_colors[CPU_NORMAL], buffer, len);
+}
+
+static void CPUHeatmapMeter_appendCell(RichString* out, double load) {
+   static const char* const blocks[] = { "▁", "▂", "▃", "▄", "▅", "▆", "▇", "█" };
+   static const char shades[] = ".:-=+*#@";
+
+   if (isNaN(load)) {
+      RichString_appendChr(out, CRT_colors[METER_SHADOW], ' ', 1);
+      return;
+   }
+
+   size_t level = MINIMUM((size_t)(load / 100.0 * ARRAYSIZE(blocks)), ARRAYSIZE(blocks) - 1);
+   int attr = load < 5.0 ? CRT_colors[METER_SHADOW]
+            : load < 30.0 ? CRT_colors[METER_VALUE_OK]
+            : load < 70.0 ? CRT_colors[METER_VALUE_WARN]
+            : CRT_colors[METER_VALUE_ERROR];
+
+   if (CRT_utf8)
+      RichString_appendWide(out, attr, blocks[level]);
+   else
+      RichString_appendChr(out, attr, shades[level], 1);
+}
+
+static void CPUHeatmapMeter_draw(Meter* this, int x, int y, int w) {
+   assert(x >= 0);
+   assert(w <= INT_MAX - x);
+
+   const CPUHeatmapData* data = this->meterData;
+   const char* caption = Meter_getCaption(this);
+   int captionWidth = w > 0 ? (int)strnlen(caption, (size_t)w) : 0;
+
+   if (w > 0) {
+      attrset(CRT_colors[METER_TEXT]);
+      mvaddnstr(y, x, caption, w);
+   }
+   attrset(CRT_colors[RESET_COLOR]);
+
+   int width = w - captionWidth;
+   if (width <= 0)
+      return;
+
+   if (!data->available || !data->count) {
+      RichString_begin(out);
+      CPUHeatmapMeter_display((const Object*)this, &out);
+      RichString_printoffnVal(out, y, x + captionWidth, 0, width);
+      RichString_delete(&out);
+      return;
+   }
+
+   /* cells that do not fit are merged, showing the hottest of them */
+   size_t perLine = (data->count + (size_t)this->h - 1) / (size_t)this->h;
+   size_t merge = (perLine + (size_t)width - 1) / (size_t)width;
+   size_t columns = (perLine + merge - 1) / merge;
+
+   for (int line = 0; line < this->h; line++) {
+      RichString_begin(out);
+
+      size_t lineStart = (size_t)line * perLine;
+      size_t lineEnd = MINIMUM(lineStart + perLine, data->count);
+      for (size_t first = lineStart; first < lineEnd; first += merge) {
+         double load = NAN;
+         for (size_t i = first; i < MINIMUM(first + merge, lineEnd); i++) {
+            if (isNonnegative(data->cells[i]) && (isNaN(load) || data->cells[i] > load))
+               load = data->cells[i];
+         }
+         CPUHeatmapMeter_appendCell(&out, load);
+      }
+
+      if (line == 0 && (size_t)width >= columns + 22) {
+         RichString_appendChr(&out, CRT_colors[METER_TEXT], ' ', 1);
+         CPUHeatmapMeter_display((const Object*)this, &out);
+      }
+
+      RichString_printoffnVal(out, y + line, x + captionWidth, 0, width);
+      RichString_delete(&out);
+   }
+}
+
 
 const MeterClass CPUMeter_class = {
    .super = {
@@ -670,3 +892,91 @@ const MeterClass RightCPUs8Meter_class = {
    .updateMode = OctoColCPUsMeter_updateMode,
    .done = AllCPUsMeter_done
 };
+
+const MeterClass CPUHeatmapMeter_class = {
+   .super = {
+      .extends = Class(Meter),
+      .delete = Meter_delete,
+      .display = CPUHeatmapMeter_display
+   },
+   .updateValues = CPUHeatmapMeter_updateValues,
+   .defaultMode = TEXT_METERMODE,
+   .supportedModes = (1 << TEXT_METERMODE),
+   .maxItems = 2,
+   .total = 100.0,
+   .attributes = CPUMeter_attributes_summary,
+   .name = "CPUHeatmap",
+   .uiName = "CPU heatmap",
+   .description = "CPU heatmap: one cell per CPU",
+   .caption = "CPU ",
+   .draw = CPUHeatmapMeter_draw,
+   .init = CPUHeatmapMeter_init,
+   .updateMode = CPUHeatmapMeter_updateMode,
+   .done = CPUHeatmapMeter_done
+};
+
+const MeterClass CoreHeatmapMeter_class = {
+   .super = {
+      .extends = Class(Meter),
+      .delete = Meter_delete,
+      .display = CPUHeatmapMeter_display
+   },
+   .updateValues = CPUHeatmapMeter_updateValues,
+   .defaultMode = TEXT_METERMODE,
+   .supportedModes = (1 << TEXT_METERMODE),
+   .maxItems = 2,
+   .total = 100.0,
+   .attributes = CPUMeter_attributes_summary,
+   .name = "CoreHeatmap",
+   .uiName = "CPU heatmap by core",
+   .description = "CPU heatmap: one cell per physical core",
+   .caption = "Core ",
+   .draw = CPUHeatmapMeter_draw,
+   .init = CPUHeatmapMeter_init,
+   .updateMode = CPUHeatmapMeter_updateMode,
+   .done = CPUHeatmapMeter_done
+};
+
+const MeterClass CCDHeatmapMeter_class = {
+   .super = {
+      .extends = Class(Meter),
+      .delete = Meter_delete,
+      .display = CPUHeatmapMeter_display
+   },
+   .updateValues = CPUHeatmapMeter_updateValues,
+   .defaultMode = TEXT_METERMODE,
+   .supportedModes = (1 << TEXT_METERMODE),
+   .maxItems = 2,
+   .total = 100.0,
+   .attributes = CPUMeter_attributes_summary,
+   .name = "CCDHeatmap",
+   .uiName = "CPU heatmap by CCD",
+   .description = "CPU heatmap: one cell per chiplet (CCD), or per socket",
+   .caption = "CCD ",
+   .draw = CPUHeatmapMeter_draw,
+   .init = CPUHeatmapMeter_init,
+   .updateMode = CPUHeatmapMeter_updateMode,
+   .done = CPUHeatmapMeter_done
+};
+
+const MeterClass NodeHeatmapMeter_class = {
+   .super = {
+      .extends = Class(Meter),
+      .delete = Meter_delete,
+      .display = CPUHeatmapMeter_display
+   },
+   .updateValues = CPUHeatmapMeter_updateValues,
+   .defaultMode = TEXT_METERMODE,
+   .supportedModes = (1 << TEXT_METERMODE),
+   .maxItems = 2,
+   .total = 100.0,
+   .attributes = CPUMeter_attributes_summary,
+   .name = "NodeHeatmap",
+   .uiName = "CPU heatmap by NUMA node",
+   .description = "CPU heatmap: one cell per NUMA node",
+   .caption = "Node ",
+   .draw = CPUHeatmapMeter_draw,
+   .init = CPUHeatmapMeter_init,
+   .updateMode = CPUHeatmapMeter_updateMode,
+   .done = CPUHeatmapMeter_done
+};
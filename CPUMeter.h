@@ -24,6 +24,14 @@ typedef enum {
    CPU_METER_ITEMCOUNT = 10, // number of entries in this enum
 } CPUMeterValues;
 
+/* Unit aggregated into one cell of the CPU heatmap meters */
+typedef enum {
+   CPU_GROUP_THREAD,
+   CPU_GROUP_CORE,
+   CPU_GROUP_CCD,
+   CPU_GROUP_NODE,
+} CPUGrouping;
+
 extern const MeterClass CPUMeter_class;
 
 extern const MeterClass AllCPUsMeter_class;
@@ -50,4 +58,12 @@ extern const MeterClass LeftCPUs8Meter_class;
 
 extern const MeterClass RightCPUs8Meter_class;
 
+extern const MeterClass CPUHeatmapMeter_class;
+
+extern const MeterClass CoreHeatmapMeter_class;
+
+extern const MeterClass CCDHeatmapMeter_class;
+
+extern const MeterClass NodeHeatmapMeter_class;
+
 #endif
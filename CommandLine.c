@@ -12,6 +12,7 @@ in the source distribution for its full text.
 
 #include <assert.h>
 #include <ctype.h>
+#include <errno.h>
 #include <getopt.h>
 #include <limits.h>
 #include <locale.h>
@@ -37,6 +38,7 @@ in the source distribution for its full text.
 #include "Platform.h"
 #include "Process.h"
 #include "ProcessTable.h"
+#include "Profiler.h"
 #include "ScreenManager.h"
 #include "ScreensPanel.h"
 #include "ScreenTabsPanel.h"
@@ -66,6 +68,7 @@ static void printHelpFlag(const char* name) {
    printf("   --no-meters                  Hide meters\n"
           "-n --max-iterations=NUMBER      Exit htop after NUMBER iterations/frame updates\n"
           "-p --pid=PID[,PID,PID...]       Show only the given PIDs\n"
+          "   --profile[=FILE]             Time htop's own refresh phases (key D), optionally dump them to FILE on exit\n"
           "   --readonly                   Disable all system and process changing features\n"
           "-s --sort-key=COLUMN            Sort by COLUMN in list view (try --sort-key=help for a list)\n"
           "-t --tree[=MODE]                Show the tree view (MODE: classic|soft|hard); can be combined with -s\n"
@@ -99,6 +102,8 @@ typedef struct CommandLineSettings_ {
    bool readonly;
    bool hideMeters;
    bool hideFunctionBar;
+   bool profile;
+   char* profileFile;
 } CommandLineSettings;
 
 static bool parseTreeStableMode(const char* arg, int* stableTreeView) {
@@ -141,6 +146,8 @@ static CommandLineStatus parseArguments(int argc, char** argv, CommandLineSettin
       .readonly = false,
       .hideMeters = false,
       .hideFunctionBar = false,
+      .profile = false,
+      .profileFile = NULL,
    };
 
    {
@@ -171,6 +178,7 @@ static CommandLineStatus parseArguments(int argc, char** argv, CommandLineSettin
       {"no-function-bar", no_argument,    0, 130},
       {"highlight-changes", optional_argument, 0, 'H'},
       {"readonly",   no_argument,         0, 128},
+      {"profile",    optional_argument,   0, 131},
       PLATFORM_LONG_OPTIONS
       {0, 0, 0, 0}
    };
@@ -349,6 +357,11 @@ static CommandLineStatus parseArguments(int argc, char** argv, CommandLineSettin
          case 128:
             flags->readonly = true;
             break;
+         case 131:
+            flags->profile = true;
+            if (optarg)
+               free_and_xStrdup(&flags->profileFile, optarg);
+            break;
 
          default: {
             CommandLineStatus status;
@@ -403,6 +416,7 @@ int CommandLine_run(int argc, char** argv) {
       return 1;
 
    UsersTable* ut = UsersTable_new();
+   UsersTable_preload(ut);
    Hashtable* dm = DynamicMeters_new();
    Hashtable* dc = DynamicColumns_new();
    Hashtable* ds = DynamicScreens_new();
@@ -492,6 +506,10 @@ int CommandLine_run(int argc, char** argv) {
    Machine_scan(host);
    Machine_scanTables(host);
 
+   // start profiling after the priming scan, so phases nest as in the main loop
+   if (flags.profile)
+      Profiler_enable();
+
    if (settings->ss->allBranchesCollapsed)
       Table_collapseAllBranches(&pt->super);
 
@@ -501,6 +519,17 @@ int CommandLine_run(int argc, char** argv) {
 
    CRT_done();
 
+   if (flags.profileFile) {
+      FILE* fp = fopen(flags.profileFile, "w");
+      if (fp) {
+         Profiler_dump(fp);
+         fclose(fp);
+      } else {
+         fprintf(stderr, "Cannot write profile to %s: %s\n", flags.profileFile, strerror(errno));
+      }
+      free(flags.profileFile);
+   }
+
    if (settings->changed) {
 #ifndef NDEBUG
       if (!String_eq(settings->initialFilename, settings->filename))
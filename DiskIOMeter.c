@@ -46,15 +46,27 @@ static double cached_utilisation_norm;
 
 static void DiskIOUpdateCache(const Machine* host) {
    static uint64_t cached_last_update;
+   static uint64_t cached_last_sample;
 
    uint64_t passedTimeInMs = host->realtimeMs - cached_last_update;
 
-   /* update only every 500ms to have a sane span for rate calculation */
-   if (passedTimeInMs <= 500)
+   /* update only every 500ms to have a sane span for rate calculation,
+      unless the platform timestamps its samples and rate-limits them itself */
+   if (!cached_last_sample && passedTimeInMs <= 500)
       return;
 
-   DiskIOData data;
+   DiskIOData data = { .sampleMs = 0 };
    bool hasNewData = Platform_getDiskIO(&data);
+   if (hasNewData && data.sampleMs) {
+      if (data.sampleMs == cached_last_sample)
+         return;
+
+      /* measure the rate over the span the counters were sampled in */
+      if (cached_last_sample)
+         passedTimeInMs = data.sampleMs - cached_last_sample;
+      cached_last_sample = data.sampleMs;
+   }
+
    if (!hasNewData) {
       status = RATESTATUS_NODATA;
    } else if (cached_last_update == 0) {
@@ -17,6 +17,7 @@ typedef struct DiskIOData_ {
    uint64_t totalBytesWritten;
    uint64_t totalMsTimeSpend;
    uint64_t numDisks;
+   uint64_t sampleMs;   /* monotonic time the counters were sampled at, 0 if unknown */
 } DiskIOData;
 
 extern const MeterClass DiskIORateMeter_class;
@@ -312,6 +312,7 @@ DisplayOptionsPanel* DisplayOptionsPanel_new(Settings* settings, ScreenManager*
    Panel_add(super, (Object*) CheckItem_newByRef("Enable the mouse", &(settings->enableMouse)));
    #endif
    Panel_add(super, (Object*) NumberItem_newByRef("Update interval (in seconds)", &(settings->delay), -1, 1, 255));
+   Panel_add(super, (Object*) NumberItem_newByRef("Limit htop's own CPU usage (in %, 0 - unlimited)", &(settings->overheadBudget), 0, 0, 100));
    Panel_add(super, (Object*) CheckItem_newByRef("Highlight new and old processes", &(settings->highlightChanges)));
    Panel_add(super, (Object*) NumberItem_newByRef("- Highlight time (in seconds)", &(settings->highlightDelaySecs), 0, 1, 24 * 60 * 60));
    Panel_add(super, (Object*) NumberItem_newByRef("Hide main function bar (0 - off, 1 - on ESC until next input, 2 - permanently)", &(settings->hideFunctionBar), 0, 0, 2));
@@ -319,6 +320,10 @@ DisplayOptionsPanel* DisplayOptionsPanel_new(Settings* settings, ScreenManager*
    #ifdef HAVE_LIBHWLOC
    Panel_add(super, (Object*) CheckItem_newByRef("Show topology when selecting affinity by default", &(settings->topologyAffinity)));
    #endif
+   #ifdef HAVE_BACKTRACE_SCREEN
+   Panel_add(super, (Object*) NumberItem_newByRef("Backtrace profiler samples per second", &(settings->backtraceSampleRate), 0, 1, 1000));
+   Panel_add(super, (Object*) NumberItem_newByRef("Backtrace profiler duration (in seconds)", &(settings->backtraceSampleSeconds), 0, 1, 60));
+   #endif
 
    return this;
 }
@@ -0,0 +1,83 @@
+/*
+htop - ExitLog.c
+(C) 2026 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "ExitLog.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "Macros.h"
+#include "Process.h"
+#include "XUtils.h"
+
+
+ExitLog* ExitLog_new(void) {
+   return xCalloc(1, sizeof(ExitLog));
+}
+
+void ExitLog_delete(ExitLog* this) {
+   if (!this)
+      return;
+
+   free(this->entries);
+   free(this);
+}
+
+static void ExitLog_setName(char* buffer, const char* name, size_t len) {
+   if (!len) {
+      name = "?";
+      len = 1;
+   }
+
+   len = MINIMUM(len, EXITLOG_NAME_LEN - 1);
+   memcpy(buffer, name, len);
+   buffer[len] = '\0';
+}
+
+/* The short name of a process: its comm if known, else the basename of its command line */
+static void ExitLog_setProcessName(char* buffer, const Process* proc) {
+   if (proc->procComm) {
+      ExitLog_setName(buffer, proc->procComm, strlen(proc->procComm));
+   } else if (proc->cmdline && proc->cmdlineBasenameEnd > proc->cmdlineBasenameStart) {
+      ExitLog_setName(buffer, proc->cmdline + proc->cmdlineBasenameStart, proc->cmdlineBasenameEnd - proc->cmdlineBasenameStart);
+   } else {
+      ExitLog_setName(buffer, NULL, 0);
+   }
+}
+
+void ExitLog_add(ExitLog* this, const Process* proc, const Process* parent, const char* name, uint64_t exitMs) {
+   if (!this->entries)
+      this->entries = xMallocArray(EXITLOG_CAPACITY, sizeof(ExitLogEntry));
+
+   ExitLogEntry* entry = &this->entries[this->head];
+   *entry = (ExitLogEntry) {
+      .pid = Process_getPid(proc),
+      .ppid = Process_getParent(proc),
+      .uid = proc->st_uid,
+      .partial = name != NULL,
+      .time = proc->time,
+      .maxResidentKiB = MAXIMUM(proc->m_resident_max, proc->m_resident),
+      .starttime = proc->starttime_ctime,
+      .exitMs = exitMs,
+   };
+
+   if (name) {
+      ExitLog_setName(entry->name, name, strlen(name));
+   } else {
+      ExitLog_setProcessName(entry->name, proc);
+   }
+
+   if (parent)
+      ExitLog_setProcessName(entry->parentName, parent);
+
+   this->head = (this->head + 1) % EXITLOG_CAPACITY;
+   if (this->count < EXITLOG_CAPACITY)
+      this->count++;
+   this->total++;
+}
@@ -0,0 +1,61 @@
+#ifndef HEADER_ExitLog
+#define HEADER_ExitLog
+/*
+htop - ExitLog.h
+(C) 2026 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+#include <sys/types.h>
+
+
+#define EXITLOG_CAPACITY 4096
+#define EXITLOG_NAME_LEN 16
+
+typedef struct ExitLogEntry_ {
+   pid_t pid;
+   pid_t ppid;                          /* -1 if unknown */
+   uid_t uid;                           /* (uid_t)-1 if unknown */
+   bool partial;                        /* exited before it was fully read */
+   unsigned long long int time;         /* CPU time in hundredths of a second */
+   long int maxResidentKiB;             /* highest resident size seen */
+   time_t starttime;                    /* 0 if unknown */
+   uint64_t exitMs;                     /* realtime of the scan that missed it */
+   char name[EXITLOG_NAME_LEN];
+   char parentName[EXITLOG_NAME_LEN];   /* empty if the parent was not known */
+} ExitLogEntry;
+
+/*
+ * Processes that have exited, as last seen by the scans. The oldest entry
+ * is overwritten once the buffer is full.
+ */
+typedef struct ExitLog_ {
+   ExitLogEntry* entries;               /* allocated with the first exit */
+   size_t head;                         /* next slot to write */
+   size_t count;
+   uint64_t total;                      /* all exits logged, including overwritten ones */
+} ExitLog;
+
+struct Process_;
+
+ExitLog* ExitLog_new(void);
+
+void ExitLog_delete(ExitLog* this);
+
+/*
+ * Logs the exit of a process. name is the command name of a process that
+ * exited before it was fully read, NULL otherwise.
+ */
+void ExitLog_add(ExitLog* this, const struct Process_* proc, const struct Process_* parent, const char* name, uint64_t exitMs);
+
+/* Returns the entry at age i, 0 being the most recent exit */
+static inline const ExitLogEntry* ExitLog_get(const ExitLog* this, size_t i) {
+   return &this->entries[(this->head + EXITLOG_CAPACITY - 1 - i) % EXITLOG_CAPACITY];
+}
+
+#endif
@@ -0,0 +1,303 @@
+/*
+htop - ExitLogScreen.c
+(C) 2026 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "ExitLogScreen.h"
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "ExitLog.h"
+#include "FunctionBar.h"
+#include "Macros.h"
+#include "Meter.h"
+#include "Panel.h"
+#include "ProvideCurses.h"
+#include "UsersTable.h"
+#include "Vector.h"
+#include "XUtils.h"
+
+
+static const char* const ExitLogScreenFunctions[] = {"Search ", "Filter ", "Refresh", "View: Log    ", "Done   ", NULL};
+
+static const char* const ExitLogScreenKeys[] = {"F3", "F4", "F5", "F6", "Esc"};
+
+static const int ExitLogScreenEvents[] = {KEY_F(3), KEY_F(4), KEY_F(5), KEY_F(6), 27};
+
+#define EXITLOGSCREEN_LOG_HEADER     "  EXITED     PID    PPID USER           TIME+  MAXRES   LIFE  COMMAND <- PARENT"
+#define EXITLOGSCREEN_GROUPS_HEADER  "  COUNT  LAST EXIT      TIME+  MAXRES  COMMAND <- PARENT"
+
+ExitLogScreen* ExitLogScreen_new(Machine* host, bool paused) {
+   ExitLogScreen* this = xMalloc(sizeof(ExitLogScreen));
+   Object_setClass(this, Class(ExitLogScreen));
+   this->host = host;
+   this->processes = (ProcessTable*) host->processTable;
+   this->paused = paused;
+   this->grouped = false;
+
+   FunctionBar* bar = FunctionBar_new(ExitLogScreenFunctions, ExitLogScreenKeys, ExitLogScreenEvents);
+   return (ExitLogScreen*) InfoScreen_init(&this->super, NULL, bar, LINES - 2, EXITLOGSCREEN_LOG_HEADER);
+}
+
+void ExitLogScreen_delete(Object* cast) {
+   free(InfoScreen_done((InfoScreen*)cast));
+}
+
+static void ExitLogScreen_draw(InfoScreen* super) {
+   const ExitLogScreen* this = (const ExitLogScreen*) super;
+   const ExitLog* log = this->processes->exitLog;
+   InfoScreen_drawTitled(super, "Exited processes: %" PRIu64 " seen, last %zu kept", log->total, log->count);
+}
+
+/* CPU time given in hundredths of a second, in the format of the TIME+ column */
+static void ExitLogScreen_formatTime(char* buffer, size_t size, unsigned long long int time) {
+   unsigned long long int totalSeconds = time / 100;
+   unsigned long long int hours = totalSeconds / 3600;
+   unsigned int minutes = (unsigned int)(totalSeconds / 60 % 60);
+   unsigned int seconds = (unsigned int)(totalSeconds % 60);
+
+   if (hours) {
+      xSnprintf(buffer, size, "%lluh%02u:%02u", hours, minutes, seconds);
+   } else {
+      xSnprintf(buffer, size, "%u:%02u.%02u", minutes, seconds, (unsigned int)(time % 100));
+   }
+}
+
+static void ExitLogScreen_formatLifetime(char* buffer, size_t size, const ExitLogEntry* entry) {
+   long long int exitTime = (long long int)(entry->exitMs / 1000);
+   if (entry->starttime <= 0 || exitTime < (long long int)entry->starttime) {
+      xSnprintf(buffer, size, "?");
+      return;
+   }
+
+   long long int life = exitTime - (long long int)entry->starttime;
+   if (life < 60) {
+      xSnprintf(buffer, size, "%llds", life);
+   } else if (life < 3600) {
+      xSnprintf(buffer, size, "%lldm%02lld", life / 60, life % 60);
+   } else if (life < 86400) {
+      xSnprintf(buffer, size, "%lldh%02lld", life / 3600, life / 60 % 60);
+   } else {
+      xSnprintf(buffer, size, "%lldd%02lld", life / 86400, life / 3600 % 24);
+   }
+}
+
+static void ExitLogScreen_formatExitTime(char* buffer, size_t size, const ExitLogEntry* entry) {
+   time_t exitTime = (time_t)(entry->exitMs / 1000);
+   struct tm date;
+   (void) localtime_r(&exitTime, &date);
+   strftime(buffer, size, "%H:%M:%S", &date);
+}
+
+static void ExitLogScreen_formatParent(char* buffer, size_t size, const ExitLogEntry* entry) {
+   if (entry->ppid < 0) {
+      xSnprintf(buffer, size, "?");
+   } else if (entry->parentName[0]) {
+      xSnprintf(buffer, size, "%s (%d)", entry->parentName, (int)entry->ppid);
+   } else {
+      xSnprintf(buffer, size, "%d", (int)entry->ppid);
+   }
+}
+
+static void ExitLogScreen_listLog(ExitLogScreen* this) {
+   InfoScreen* super = &this->super;
+   const ExitLog* log = this->processes->exitLog;
+
+   for (size_t i = 0; i < log->count; i++) {
+      const ExitLogEntry* entry = ExitLog_get(log, i);
+
+      char exitTime[16];
+      char time[16];
+      char resident[8];
+      char life[16];
+      char parent[EXITLOG_NAME_LEN + 16];
+      char ppid[16];
+      ExitLogScreen_formatExitTime(exitTime, sizeof(exitTime), entry);
+      ExitLogScreen_formatTime(time, sizeof(time), entry->time);
+      Meter_humanUnit(resident, (double)entry->maxResidentKiB, sizeof(resident));
+      ExitLogScreen_formatLifetime(life, sizeof(life), entry);
+      ExitLogScreen_formatParent(parent, sizeof(parent), entry);
+      if (entry->ppid < 0) {
+         xSnprintf(ppid, sizeof(ppid), "?");
+      } else {
+         xSnprintf(ppid, sizeof(ppid), "%d", (int)entry->ppid);
+      }
+
+      const char* user = entry->uid == (uid_t)-1 ? "?" : UsersTable_getRef(this->host->usersTable, entry->uid);
+
+      char line[160];
+      xSnprintf(line, sizeof(line), "%8s %7d %7s %-9.9s %10s %7s %6s  %s <- %s%s",
+         exitTime,
+         (int)entry->pid,
+         ppid,
+         user ? user : "?",
+         time,
+         resident,
+         life,
+         entry->name,
+         parent,
+         entry->partial ? "  (partial)" : "");
+      InfoScreen_addLine(super, line);
+   }
+}
+
+typedef struct ExitLogGroup_ {
+   const ExitLogEntry* latest;
+   unsigned int count;
+   unsigned long long int time;
+   long int maxResidentKiB;
+} ExitLogGroup;
+
+/* Entries of the same command and parent next to each other, most recent first */
+static int ExitLogScreen_compareEntries(const void* a, const void* b) {
+   const ExitLogEntry* ea = *(const ExitLogEntry* const*)a;
+   const ExitLogEntry* eb = *(const ExitLogEntry* const*)b;
+
+   int r = strcmp(ea->name, eb->name);
+   if (r)
+      return r;
+
+   r = SPACESHIP_NUMBER(ea->ppid, eb->ppid);
+   if (r)
+      return r;
+
+   r = strcmp(ea->parentName, eb->parentName);
+   if (r)
+      return r;
+
+   return SPACESHIP_NUMBER(eb->exitMs, ea->exitMs);
+}
+
+static bool ExitLogScreen_sameGroup(const ExitLogEntry* a, const ExitLogEntry* b) {
+   return a->ppid == b->ppid && String_eq(a->name, b->name) && String_eq(a->parentName, b->parentName);
+}
+
+static int ExitLogScreen_compareGroups(const void* a, const void* b) {
+   const ExitLogGroup* ga = a;
+   const ExitLogGroup* gb = b;
+
+   int r = SPACESHIP_NUMBER(gb->count, ga->count);
+   if (r)
+      return r;
+
+   return SPACESHIP_NUMBER(gb->latest->exitMs, ga->latest->exitMs);
+}
+
+static void ExitLogScreen_listGroups(ExitLogScreen* this) {
+   InfoScreen* super = &this->super;
+   const ExitLog* log = this->processes->exitLog;
+   if (!log->count)
+      return;
+
+   const ExitLogEntry** entries = xMallocArray(log->count, sizeof(ExitLogEntry*));
+   for (size_t i = 0; i < log->count; i++)
+      entries[i] = ExitLog_get(log, i);
+   qsort(entries, log->count, sizeof(ExitLogEntry*), ExitLogScreen_compareEntries);
+
+   ExitLogGroup* groups = xMallocArray(log->count, sizeof(ExitLogGroup));
+   size_t nGroups = 0;
+   for (size_t i = 0; i < log->count; i++) {
+      const ExitLogEntry* entry = entries[i];
+      if (!nGroups || !ExitLogScreen_sameGroup(groups[nGroups - 1].latest, entry))
+         groups[nGroups++] = (ExitLogGroup) { .latest = entry };
+
+      ExitLogGroup* group = &groups[nGroups - 1];
+      group->count++;
+      group->time += entry->time;
+      group->maxResidentKiB = MAXIMUM(group->maxResidentKiB, entry->maxResidentKiB);
+   }
+   qsort(groups, nGroups, sizeof(ExitLogGroup), ExitLogScreen_compareGroups);
+
+   for (size_t i = 0; i < nGroups; i++) {
+      const ExitLogGroup* group = &groups[i];
+
+      char exitTime[16];
+      char time[16];
+      char resident[8];
+      char parent[EXITLOG_NAME_LEN + 16];
+      ExitLogScreen_formatExitTime(exitTime, sizeof(exitTime), group->latest);
+      ExitLogScreen_formatTime(time, sizeof(time), group->time);
+      Meter_humanUnit(resident, (double)group->maxResidentKiB, sizeof(resident));
+      ExitLogScreen_formatParent(parent, sizeof(parent), group->latest);
+
+      char line[128];
+      xSnprintf(line, sizeof(line), "%7u %10s %10s %7s  %s <- %s",
+         group->count,
+         exitTime,
+         time,
+         resident,
+         group->latest->name,
+         parent);
+      InfoScreen_addLine(super, line);
+   }
+
+   free(groups);
+   free(entries);
+}
+
+static void ExitLogScreen_list(ExitLogScreen* this) {
+   InfoScreen* super = &this->super;
+   Panel* panel = super->display;
+   int idx = MAXIMUM(Panel_getSelectedIndex(panel), 0);
+
+   Panel_prune(panel);
+
+   if (this->grouped) {
+      ExitLogScreen_listGroups(this);
+   } else {
+      ExitLogScreen_listLog(this);
+   }
+
+   if (!this->processes->exitLog->count)
+      InfoScreen_addLine(super, "No process has exited yet.");
+
+   Panel_setSelected(panel, idx);
+}
+
+static void ExitLogScreen_scan(InfoScreen* super) {
+   ExitLogScreen* this = (ExitLogScreen*) super;
+   Machine_rescan(this->host, !this->paused);
+   ExitLogScreen_list(this);
+}
+
+static void ExitLogScreen_refresh(InfoScreen* this) {
+   Vector_prune(this->lines);
+   ExitLogScreen_scan(this);
+   InfoScreen_draw(this);
+}
+
+static bool ExitLogScreen_onKey(InfoScreen* super, int ch) {
+   ExitLogScreen* this = (ExitLogScreen*) super;
+
+   switch (ch) {
+      case 'g':
+      case KEY_F(6):
+         this->grouped = !this->grouped;
+         FunctionBar_setLabel(super->display->defaultBar, KEY_F(6), this->grouped ? "View: Groups " : "View: Log    ");
+         Panel_setHeader(super->display, this->grouped ? EXITLOGSCREEN_GROUPS_HEADER : EXITLOGSCREEN_LOG_HEADER);
+         Vector_prune(super->lines);
+         ExitLogScreen_list(this);
+         InfoScreen_draw(this);
+         return true;
+   }
+
+   return false;
+}
+
+const InfoScreenClass ExitLogScreen_class = {
+   .super = {
+      .extends = Class(Object),
+      .delete = ExitLogScreen_delete
+   },
+   .scan = ExitLogScreen_scan,
+   .draw = ExitLogScreen_draw,
+   .onErr = ExitLogScreen_refresh,
+   .onKey = ExitLogScreen_onKey
+};
@@ -0,0 +1,32 @@
+#ifndef HEADER_ExitLogScreen
+#define HEADER_ExitLogScreen
+/*
+htop - ExitLogScreen.h
+(C) 2026 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+
+#include "InfoScreen.h"
+#include "Machine.h"
+#include "Object.h"
+#include "ProcessTable.h"
+
+
+typedef struct ExitLogScreen_ {
+   InfoScreen super;
+   Machine* host;
+   ProcessTable* processes;
+   bool paused;
+   bool grouped;
+} ExitLogScreen;
+
+extern const InfoScreenClass ExitLogScreen_class;
+
+ExitLogScreen* ExitLogScreen_new(Machine* host, bool paused);
+
+void ExitLogScreen_delete(Object* this);
+
+#endif
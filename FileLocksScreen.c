@@ -0,0 +1,99 @@
+/*
+htop - FileLocksScreen.c
+(C) 2026 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "FileLocksScreen.h"
+
+#include <inttypes.h>
+#include <limits.h>
+#include <stdlib.h>
+
+#include "Macros.h"
+#include "Panel.h"
+#include "Platform.h"
+#include "Process.h"
+#include "ProcessLocksScreen.h"
+#include "ProvideCurses.h"
+#include "XUtils.h"
+
+
+FileLocksScreen* FileLocksScreen_new(ProcessTable* processTable) {
+   FileLocksScreen* this = xMalloc(sizeof(FileLocksScreen));
+   Object_setClass(this, Class(FileLocksScreen));
+   this->processTable = processTable;
+   return (FileLocksScreen*) InfoScreen_init(&this->super, NULL, NULL, LINES - 2, "    PID COMMAND          TYPE       EXCLUSION  READ/WRITE DEVICE       NODE               START                 END");
+}
+
+void FileLocksScreen_delete(Object* this) {
+   free(InfoScreen_done((InfoScreen*)this));
+}
+
+static void FileLocksScreen_draw(InfoScreen* this) {
+   InfoScreen_drawTitled(this, "Snapshot of all file locks");
+}
+
+static void FileLocksScreen_scan(InfoScreen* this) {
+   ProcessTable* pt = ((FileLocksScreen*)this)->processTable;
+   Panel* panel = this->display;
+   int idx = MAXIMUM(Panel_getSelectedIndex(panel), 0);
+   Panel_prune(panel);
+
+   FileLocks_ProcessData* pdata = Platform_getFileLocks();
+   if (!pdata) {
+      InfoScreen_addLine(this, "This feature is not supported on your platform.");
+   } else if (pdata->error) {
+      InfoScreen_addLine(this, "Could not determine file locks.");
+   } else if (!pdata->locks) {
+      InfoScreen_addLine(this, "No file locks are held.");
+   } else {
+      for (const FileLocks_LockData* ldata = pdata->locks; ldata; ldata = ldata->next) {
+         const FileLocks_Data* data = &ldata->data;
+
+         /* open file description locks are not owned by a single process */
+         char pid[16] = "-";
+         const char* command = "<OFD>";
+         if (data->pid > 0) {
+            xSnprintf(pid, sizeof(pid), "%d", data->pid);
+            const Process* process = ProcessTable_findProcess(pt, data->pid);
+            if (!process)
+               command = "<N/A>";
+            else if (process->procComm)
+               command = process->procComm;
+            else if (process->cmdline)
+               command = process->cmdline + process->cmdlineBasenameStart;
+            else
+               command = Process_getCommand(process);
+         }
+
+         char end[24] = "<END OF FILE>";
+         if (data->end != ULLONG_MAX)
+            xSnprintf(end, sizeof(end), "%"PRIu64, data->end);
+
+         char entry[512];
+         xSnprintf(entry, sizeof(entry), "%7s %-16.16s %-10s %-10s %-10s %#6"PRIx64" %10"PRIu64" %19"PRIu64" %19s",
+            pid, command,
+            data->locktype, data->exclusive, data->readwrite,
+            (uint64_t) data->dev, data->inode,
+            data->start, end
+         );
+         InfoScreen_addLine(this, entry);
+      }
+   }
+   FileLocks_ProcessData_delete(pdata);
+
+   Panel_setSelected(panel, idx);
+}
+
+const InfoScreenClass FileLocksScreen_class = {
+   .super = {
+      .extends = Class(Object),
+      .delete = FileLocksScreen_delete
+   },
+   .scan = FileLocksScreen_scan,
+   .draw = FileLocksScreen_draw
+};
@@ -0,0 +1,26 @@
+#ifndef HEADER_FileLocksScreen
+#define HEADER_FileLocksScreen
+/*
+htop - FileLocksScreen.h
+(C) 2026 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "InfoScreen.h"
+#include "Object.h"
+#include "ProcessTable.h"
+
+
+typedef struct FileLocksScreen_ {
+   InfoScreen super;
+   ProcessTable* processTable;   /* for the command of each lock holder */
+} FileLocksScreen;
+
+extern const InfoScreenClass FileLocksScreen_class;
+
+FileLocksScreen* FileLocksScreen_new(ProcessTable* processTable);
+
+void FileLocksScreen_delete(Object* this);
+
+#endif
@@ -0,0 +1,152 @@
+/*
+htop - IODevices.c
+(C) 2026 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "IODevices.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "Macros.h"
+#include "XUtils.h"
+
+
+void IODeviceTable_init(IODeviceTable* this) {
+   *this = (IODeviceTable) { .devices = NULL };
+}
+
+void IODeviceTable_done(IODeviceTable* this) {
+   free(this->devices);
+   IODeviceTable_init(this);
+}
+
+bool IODeviceTable_beginSample(IODeviceTable* this, uint64_t monotonicMs) {
+   if (this->sampleMs && monotonicMs < this->sampleMs + IODEVICES_MIN_INTERVAL_MS)
+      return false;
+
+   this->intervalMs = this->sampleMs ? monotonicMs - this->sampleMs : 0;
+   this->sampleMs = monotonicMs;
+   this->hint = 0;
+   this->haveDisks = false;
+   this->haveNetwork = false;
+
+   for (size_t i = 0; i < this->count; i++)
+      this->devices[i].seen = false;
+
+   return true;
+}
+
+static IODevice* IODeviceTable_find(IODeviceTable* this, IODeviceKind kind, const char* name, size_t nameLen) {
+   /* devices are reported in the same order every time, so try the next slot first */
+   for (size_t n = 0; n < this->count; n++) {
+      size_t i = (this->hint + n) % this->count;
+      IODevice* device = &this->devices[i];
+      if (device->kind == kind && strncmp(device->name, name, nameLen) == 0 && device->name[nameLen] == '\0') {
+         this->hint = i + 1;
+         return device;
+      }
+   }
+
+   return NULL;
+}
+
+IODevice* IODeviceTable_update(IODeviceTable* this, IODeviceKind kind, const char* name, size_t nameLen, uint64_t readBytes, uint64_t writeBytes, uint64_t readOps, uint64_t writeOps, uint64_t busyMs) {
+   if (nameLen == 0 || nameLen >= IODEVICE_NAME_LEN)
+      return NULL;
+
+   IODevice* device = IODeviceTable_find(this, kind, name, nameLen);
+   if (device) {
+      device->isNew = false;
+
+      if (this->intervalMs > 0) {
+         double seconds = this->intervalMs / 1000.0;
+         device->readRate = readBytes > device->readBytes ? (readBytes - device->readBytes) / seconds : 0.0;
+         device->writeRate = writeBytes > device->writeBytes ? (writeBytes - device->writeBytes) / seconds : 0.0;
+         device->busyPercent = busyMs > device->busyMs ? MINIMUM(100.0 * (busyMs - device->busyMs) / this->intervalMs, 100.0) : 0.0;
+         device->haveRate = true;
+      }
+   } else {
+      if (this->count == this->size) {
+         this->size = this->size ? this->size * 2 : 16;
+         this->devices = xReallocArray(this->devices, this->size, sizeof(IODevice));
+      }
+
+      device = &this->devices[this->count++];
+      *device = (IODevice) {
+         .kind = kind,
+         .isNew = true,
+         .listed = true,
+         .summed = true,
+      };
+      memcpy(device->name, name, nameLen);
+      device->name[nameLen] = '\0';
+      this->hint = this->count;
+   }
+
+   device->seen = true;
+   device->readBytes = readBytes;
+   device->writeBytes = writeBytes;
+   device->readOps = readOps;
+   device->writeOps = writeOps;
+   device->busyMs = busyMs;
+
+   if (kind == IODEVICE_DISK)
+      this->haveDisks = true;
+   else
+      this->haveNetwork = true;
+
+   return device;
+}
+
+void IODeviceTable_endSample(IODeviceTable* this) {
+   size_t kept = 0;
+   for (size_t i = 0; i < this->count; i++) {
+      if (!this->devices[i].seen)
+         continue;
+
+      if (kept != i)
+         this->devices[kept] = this->devices[i];
+      kept++;
+   }
+   this->count = kept;
+}
+
+/* Orders by current throughput, idle devices by their total traffic */
+static bool IODevice_isBusier(const IODevice* a, const IODevice* b) {
+   double ta = IODevice_throughput(a);
+   double tb = IODevice_throughput(b);
+   if (ta > tb)
+      return true;
+   if (ta < tb)
+      return false;
+
+   return a->readBytes + a->writeBytes > b->readBytes + b->writeBytes;
+}
+
+size_t IODeviceTable_getTop(const IODeviceTable* this, const IODevice** out, size_t max) {
+   size_t n = 0;
+
+   for (size_t i = 0; i < this->count; i++) {
+      const IODevice* device = &this->devices[i];
+      if (!device->listed)
+         continue;
+
+      if (n == max && (max == 0 || !IODevice_isBusier(device, out[n - 1])))
+         continue;
+
+      /* insertion into the sorted prefix; n is small */
+      size_t pos = n < max ? n++ : n - 1;
+      while (pos > 0 && IODevice_isBusier(device, out[pos - 1])) {
+         out[pos] = out[pos - 1];
+         pos--;
+      }
+      out[pos] = device;
+   }
+
+   return n;
+}
@@ -0,0 +1,78 @@
+#ifndef HEADER_IODevices
+#define HEADER_IODevices
+/*
+htop - IODevices.h
+(C) 2026 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+
+/* Minimum time between two samples, to have a sane span for rate calculation */
+#define IODEVICES_MIN_INTERVAL_MS 500
+
+#define IODEVICE_NAME_LEN 32
+
+typedef enum IODeviceKind_ {
+   IODEVICE_DISK,
+   IODEVICE_NETWORK,
+} IODeviceKind;
+
+typedef struct IODevice_ {
+   char name[IODEVICE_NAME_LEN];
+   IODeviceKind kind;
+   bool isNew;          /* added by the current sample, not classified yet */
+   bool listed;         /* shown per device (e.g. not a partition) */
+   bool summed;         /* counted in the aggregated DiskIO/NetworkIO totals */
+   bool seen;           /* present in the current sample */
+   bool haveRate;       /* seen in two consecutive samples */
+
+   /* absolute counters; read/write are received/transmitted for network devices */
+   uint64_t readBytes;
+   uint64_t writeBytes;
+   uint64_t readOps;
+   uint64_t writeOps;
+   uint64_t busyMs;     /* disks only */
+
+   /* over the last sampling interval */
+   double readRate;     /* bytes per second */
+   double writeRate;    /* bytes per second */
+   double busyPercent;
+} IODevice;
+
+typedef struct IODeviceTable_ {
+   IODevice* devices;
+   size_t count;
+   size_t size;
+   size_t hint;         /* expected position of the next device within a sample */
+   uint64_t sampleMs;
+   uint64_t intervalMs;
+   bool haveDisks;
+   bool haveNetwork;
+} IODeviceTable;
+
+void IODeviceTable_init(IODeviceTable* this);
+
+void IODeviceTable_done(IODeviceTable* this);
+
+/* Returns false if the previous sample is too recent to be replaced */
+bool IODeviceTable_beginSample(IODeviceTable* this, uint64_t monotonicMs);
+
+/* Records the absolute counters of a device for the current sample */
+IODevice* IODeviceTable_update(IODeviceTable* this, IODeviceKind kind, const char* name, size_t nameLen, uint64_t readBytes, uint64_t writeBytes, uint64_t readOps, uint64_t writeOps, uint64_t busyMs);
+
+/* Computes rates and drops devices that disappeared */
+void IODeviceTable_endSample(IODeviceTable* this);
+
+/* Fills out with up to max listed devices, busiest first; returns the count */
+size_t IODeviceTable_getTop(const IODeviceTable* this, const IODevice** out, size_t max);
+
+static inline double IODevice_throughput(const IODevice* this) {
+   return this->readRate + this->writeRate;
+}
+
+#endif
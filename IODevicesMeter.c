@@ -0,0 +1,168 @@
+/*
+htop - IODevicesMeter.c
+(C) 2026 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "IODevicesMeter.h"
+
+#include <assert.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "CRT.h"
+#include "IODevices.h"
+#include "Macros.h"
+#include "Object.h"
+#include "Platform.h"
+#include "ProvideCurses.h"
+#include "RichString.h"
+#include "Row.h"
+#include "XUtils.h"
+
+
+typedef struct IODevicesMeterData_ {
+   bool available;
+   size_t count;
+   IODevice top[IODEVICES_METER_LINES];   /* copies; the table may move its entries */
+} IODevicesMeterData;
+
+static const int IODevicesMeter_attributes[] = {
+   METER_VALUE_IOREAD,
+   METER_VALUE_IOWRITE,
+};
+
+static void IODevicesMeter_init(Meter* this) {
+   if (!this->meterData)
+      this->meterData = xCalloc(1, sizeof(IODevicesMeterData));
+}
+
+static void IODevicesMeter_done(Meter* this) {
+   free(this->meterData);
+   this->meterData = NULL;
+}
+
+static void IODevicesMeter_updateMode(Meter* this, MeterModeId mode) {
+   this->mode = mode;
+   this->h = IODEVICES_METER_LINES;
+}
+
+static void IODevicesMeter_updateValues(Meter* this) {
+   IODevicesMeterData* data = this->meterData;
+   const IODeviceTable* table = Platform_getIODevices();
+
+   data->available = table != NULL;
+   data->count = 0;
+   if (!table)
+      return;
+
+   const IODevice* top[IODEVICES_METER_LINES];
+   data->count = IODeviceTable_getTop(table, top, ARRAYSIZE(top));
+   for (size_t i = 0; i < data->count; i++)
+      data->top[i] = *top[i];
+
+   this->values[0] = data->count ? data->top[0].readRate : 0.0;
+   this->values[1] = data->count ? data->top[0].writeRate : 0.0;
+}
+
+static void IODevicesMeter_displayDevice(const IODevice* device, RichString* out) {
+   char buffer[IODEVICE_NAME_LEN + 2];
+   int len = xSnprintf(buffer, sizeof(buffer), "%-10s ", device->name);
+   RichString_appendnAscii(out, CRT_colors[METER_TEXT], buffer, len);
+
+   if (!device->haveRate) {
+      RichString_appendAscii(out, CRT_colors[METER_VALUE], "initializing...");
+      return;
+   }
+
+   bool network = device->kind == IODEVICE_NETWORK;
+   char rate[6];
+
+   RichString_appendAscii(out, CRT_colors[METER_TEXT], network ? "rx: " : "r: ");
+   Meter_humanUnit(rate, device->readRate / ONE_K, sizeof(rate));
+   RichString_appendAscii(out, CRT_colors[METER_VALUE_IOREAD], rate);
+   RichString_appendAscii(out, CRT_colors[METER_VALUE_IOREAD], "iB/s");
+
+   RichString_appendAscii(out, CRT_colors[METER_TEXT], network ? " tx: " : " w: ");
+   Meter_humanUnit(rate, device->writeRate / ONE_K, sizeof(rate));
+   RichString_appendAscii(out, CRT_colors[METER_VALUE_IOWRITE], rate);
+   RichString_appendAscii(out, CRT_colors[METER_VALUE_IOWRITE], "iB/s");
+
+   if (!network) {
+      len = xSnprintf(buffer, sizeof(buffer), " %.0f%%", device->busyPercent);
+      RichString_appendnAscii(out, CRT_colors[device->busyPercent > 40.0 ? METER_VALUE_NOTICE : METER_VALUE], buffer, len);
+      RichString_appendAscii(out, CRT_colors[METER_TEXT], " busy");
+   }
+}
+
+static void IODevicesMeter_display(const Object* cast, RichString* out) {
+   const Meter* this = (const Meter*)cast;
+   const IODevicesMeterData* data = this->meterData;
+
+   if (!data || !data->available) {
+      RichString_writeAscii(out, CRT_colors[METER_VALUE_ERROR], "no data");
+      return;
+   }
+   if (!data->count) {
+      RichString_writeAscii(out, CRT_colors[METER_VALUE], "no devices");
+      return;
+   }
+
+   IODevicesMeter_displayDevice(&data->top[0], out);
+}
+
+static void IODevicesMeter_draw(Meter* this, int x, int y, int w) {
+   assert(x >= 0);
+   assert(w <= INT_MAX - x);
+
+   const IODevicesMeterData* data = this->meterData;
+   const char* caption = Meter_getCaption(this);
+   int captionWidth = w > 0 ? (int)strnlen(caption, (size_t)w) : 0;
+
+   if (w > 0) {
+      attrset(CRT_colors[METER_TEXT]);
+      mvaddnstr(y, x, caption, w);
+   }
+   attrset(CRT_colors[RESET_COLOR]);
+
+   if (w <= captionWidth)
+      return;
+
+   for (int line = 0; line < this->h; line++) {
+      RichString_begin(out);
+      if (line == 0) {
+         IODevicesMeter_display((const Object*)this, &out);
+      } else if ((size_t)line < data->count) {
+         IODevicesMeter_displayDevice(&data->top[line], &out);
+      }
+      RichString_printoffnVal(out, y + line, x + captionWidth, 0, w - captionWidth);
+      RichString_delete(&out);
+   }
+}
+
+const MeterClass IODevicesMeter_class = {
+   .super = {
+      .extends = Class(Meter),
+      .delete = Meter_delete,
+      .display = IODevicesMeter_display
+   },
+   .init = IODevicesMeter_init,
+   .done = IODevicesMeter_done,
+   .updateMode = IODevicesMeter_updateMode,
+   .updateValues = IODevicesMeter_updateValues,
+   .draw = IODevicesMeter_draw,
+   .defaultMode = TEXT_METERMODE,
+   .supportedModes = (1 << TEXT_METERMODE),
+   .maxItems = 2,
+   .isPercentChart = false,
+   .total = 1.0,
+   .attributes = IODevicesMeter_attributes,
+   .name = "IODevices",
+   .uiName = "Busiest IO devices",
+   .description = "Disks and network interfaces with the highest throughput, one per line",
+   .caption = "IO: "
+};
@@ -0,0 +1,18 @@
+#ifndef HEADER_IODevicesMeter
+#define HEADER_IODevicesMeter
+/*
+htop - IODevicesMeter.h
+(C) 2026 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "Meter.h"
+
+
+/* Number of devices listed, one per header line */
+#define IODEVICES_METER_LINES 4
+
+extern const MeterClass IODevicesMeter_class;
+
+#endif /* HEADER_IODevicesMeter */
@@ -0,0 +1,106 @@
+/*
+htop - IODevicesScreen.c
+(C) 2026 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "IODevicesScreen.h"
+
+#include <stdlib.h>
+
+#include "IODevices.h"
+#include "Macros.h"
+#include "Meter.h"
+#include "Panel.h"
+#include "Platform.h"
+#include "ProvideCurses.h"
+#include "Row.h"
+#include "Vector.h"
+#include "XUtils.h"
+
+
+IODevicesScreen* IODevicesScreen_new(void) {
+   IODevicesScreen* this = xMalloc(sizeof(IODevicesScreen));
+   Object_setClass(this, Class(IODevicesScreen));
+   return (IODevicesScreen*) InfoScreen_init(&this->super, NULL, NULL, LINES - 2, "DEVICE           TYPE      READ/RX   WRITE/TX   BUSY   TOTAL READ  TOTAL WRITTEN");
+}
+
+void IODevicesScreen_delete(Object* this) {
+   free(InfoScreen_done((InfoScreen*)this));
+}
+
+static void IODevicesScreen_draw(InfoScreen* this) {
+   InfoScreen_drawTitled(this, "IO devices by throughput");
+}
+
+static void IODevicesScreen_scan(InfoScreen* this) {
+   Panel* panel = this->display;
+   int idx = MAXIMUM(Panel_getSelectedIndex(panel), 0);
+
+   Panel_prune(panel);
+
+   const IODeviceTable* table = Platform_getIODevices();
+   if (!table) {
+      InfoScreen_addLine(this, "Per-device IO statistics are not supported on this platform.");
+      return;
+   }
+
+   const IODevice** devices = xCalloc(MAXIMUM(table->count, 1), sizeof(IODevice*));
+   size_t count = IODeviceTable_getTop(table, devices, table->count);
+
+   for (size_t i = 0; i < count; i++) {
+      const IODevice* device = devices[i];
+
+      char readRate[6] = "-";
+      char writeRate[6] = "-";
+      char busy[8] = "-";
+      if (device->haveRate) {
+         Meter_humanUnit(readRate, device->readRate / ONE_K, sizeof(readRate));
+         Meter_humanUnit(writeRate, device->writeRate / ONE_K, sizeof(writeRate));
+         if (device->kind == IODEVICE_DISK)
+            xSnprintf(busy, sizeof(busy), "%.0f%%", device->busyPercent);
+      }
+
+      char readTotal[6];
+      char writeTotal[6];
+      Meter_humanUnit(readTotal, device->readBytes / (double)ONE_K, sizeof(readTotal));
+      Meter_humanUnit(writeTotal, device->writeBytes / (double)ONE_K, sizeof(writeTotal));
+
+      char line[256];
+      xSnprintf(line, sizeof(line), "%-16s %-8s %6siB/s %6siB/s %6s %10siB %12siB",
+         device->name,
+         device->kind == IODEVICE_DISK ? "disk" : "network",
+         readRate,
+         writeRate,
+         busy,
+         readTotal,
+         writeTotal);
+      InfoScreen_addLine(this, line);
+   }
+
+   free(devices);
+
+   if (!count)
+      InfoScreen_addLine(this, "No devices found.");
+
+   Panel_setSelected(panel, idx);
+}
+
+static void IODevicesScreen_refresh(InfoScreen* this) {
+   Vector_prune(this->lines);
+   IODevicesScreen_scan(this);
+   InfoScreen_draw(this);
+}
+
+const InfoScreenClass IODevicesScreen_class = {
+   .super = {
+      .extends = Class(Object),
+      .delete = IODevicesScreen_delete
+   },
+   .scan = IODevicesScreen_scan,
+   .draw = IODevicesScreen_draw,
+   .onErr = IODevicesScreen_refresh
+};
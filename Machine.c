@@ -25,6 +25,8 @@ void Machine_init(Machine* this, UsersTable* usersTable, uid_t userId) {
 
    this->htopUserId = getuid();
 
+   OverheadBudget_init(&this->budget);
+
    // discover fixed column width limits
    Row_setPidColumnWidth(Platform_getMaxPid());
 
@@ -113,6 +115,8 @@ void Machine_scanTables(Machine* this) {
       return;
    }
 
+   UsersTable_update(this->usersTable, this->monotonicMs);
+
    this->maxUserId = 0;
    Row_resetFieldWidths();
 
@@ -132,3 +136,18 @@ void Machine_scanTables(Machine* this) {
    Row_setUidColumnWidth(this->maxUserId);
    Row_setPidColumnWidth(this->maxProcessId);
 }
+
+void Machine_rescan(Machine* this, bool scanTables) {
+   /* as the main loop does before each scan */
+   Platform_gettime_realtime(&this->realtime, &this->realtimeMs);
+
+   Machine_scan(this);
+   if (!scanTables)
+      return;
+
+   Machine_scanTables(this);
+
+   /* the main panel may still point to rows that were just removed */
+   this->activeTable->needsSort = true;
+   Table_rebuildPanel(this->activeTable);
+}
@@ -14,6 +14,7 @@ in the source distribution for its full text.
 #include <time.h>
 #include <sys/types.h>
 
+#include "OverheadBudget.h"
 #include "Panel.h"
 #include "Settings.h"
 #include "Table.h"
@@ -45,6 +46,8 @@ typedef struct Machine_ {
 
    int64_t iterationsRemaining;
 
+   OverheadBudget budget;
+
    #ifdef HAVE_LIBHWLOC
    hwloc_topology_t topology;
    bool topologyOk;
@@ -95,4 +98,7 @@ void Machine_scan(Machine* this);
 
 void Machine_scanTables(Machine* this);
 
+/* Scans in place of the main loop, e.g. while a screen shows live values */
+void Machine_rescan(Machine* this, bool scanTables);
+
 #endif
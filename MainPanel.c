@@ -17,6 +17,7 @@ in the source distribution for its full text.
 #include "CRT.h"
 #include "FunctionBar.h"
 #include "Machine.h"
+#include "OverheadBudget.h"
 #include "Platform.h"
 #include "ProvideCurses.h"
 #include "Row.h"
@@ -215,6 +216,8 @@ static void MainPanel_drawFunctionBar(Panel* super, bool hideFunctionBar) {
       FunctionBar_append("PAUSED", CRT_colors[PAUSED]);
    } else if (this->state->failedUpdate) {
       FunctionBar_append(this->state->failedUpdate, CRT_colors[FAILED_READ]);
+   } else if (this->state->host->budget.level != OVERHEAD_LEVEL_FULL) {
+      FunctionBar_append("REDUCED DETAIL", CRT_colors[PAUSED]);
    }
 }
 
@@ -0,0 +1,219 @@
+/*
+htop - NUMAMemoryMeter.c
+(C) 2026 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "NUMAMemoryMeter.h"
+
+#include <limits.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "CRT.h"
+#include "Macros.h"
+#include "Object.h"
+#include "Platform.h"
+#include "ProvideCurses.h"
+#include "RichString.h"
+#include "Settings.h"
+#include "XUtils.h"
+
+
+/* same colors as the used, shared and cache classes of the Memory meter */
+static const int NodeMemoryMeter_attributes[] = {
+   MEMORY_1,
+   MEMORY_2,
+   MEMORY_5
+};
+
+typedef struct NUMAMemoryMeterData_ {
+   size_t count;
+   NodeMemory nodes[NUMA_MEMORY_METER_MAX_NODES];
+   Meter* meters[NUMA_MEMORY_METER_MAX_NODES];
+} NUMAMemoryMeterData;
+
+static void NodeMemoryMeter_setValues(Meter* this, const NodeMemory* node) {
+   const Settings* settings = this->host->settings;
+
+   this->total = (double)node->total;
+   this->values[0] = (double)node->used;
+   this->values[1] = (double)node->shared;
+   this->values[2] = (double)node->cache;
+
+   if ((this->mode == GRAPH_METERMODE || this->mode == BAR_METERMODE) && !settings->showCachedMemory)
+      this->values[2] = NAN;
+
+   char* buffer = this->txtBuffer;
+   size_t size = sizeof(this->txtBuffer);
+   int written = Meter_humanUnit(buffer, (double)(node->used + node->shared), size);
+   METER_BUFFER_CHECK(buffer, size, written);
+
+   METER_BUFFER_APPEND_CHR(buffer, size, '/');
+
+   Meter_humanUnit(buffer, this->total, size);
+}
+
+static void NodeMemoryMeter_display(const Object* cast, RichString* out) {
+   static const char* const labels[] = { "used", "shared", "cache" };
+   const Meter* this = (const Meter*)cast;
+   char buffer[50];
+
+   RichString_writeAscii(out, CRT_colors[METER_TEXT], ":");
+   Meter_humanUnit(buffer, this->total, sizeof(buffer));
+   RichString_appendAscii(out, CRT_colors[METER_VALUE], buffer);
+
+   for (size_t i = 0; i < ARRAYSIZE(labels); i++) {
+      double value = this->values[i];
+      int labelColor = CRT_colors[METER_TEXT];
+      int valueColor = CRT_colors[NodeMemoryMeter_attributes[i]];
+      if (isNaN(value)) {
+         labelColor = valueColor = CRT_colors[METER_SHADOW];
+         value = 0.0;
+      }
+
+      Meter_humanUnit(buffer, value, sizeof(buffer));
+      RichString_appendAscii(out, labelColor, " ");
+      RichString_appendAscii(out, labelColor, labels[i]);
+      RichString_appendAscii(out, labelColor, ":");
+      RichString_appendAscii(out, valueColor, buffer);
+   }
+}
+
+static void NUMAMemoryMeter_setCount(Meter* this, size_t count) {
+   NUMAMemoryMeterData* data = this->meterData;
+
+   for (size_t i = count; i < data->count; i++) {
+      Meter_delete((Object*)data->meters[i]);
+      data->meters[i] = NULL;
+   }
+
+   for (size_t i = 0; i < count; i++) {
+      if (!data->meters[i]) {
+         data->meters[i] = Meter_new(this->host, data->nodes[i].id, (const MeterClass*) Class(NodeMemoryMeter));
+         if (this->mode)
+            Meter_setMode(data->meters[i], this->mode);
+      }
+
+      char caption[16];
+      char name[12];
+      xSnprintf(name, sizeof(name), "N%u", data->nodes[i].id);
+      xSnprintf(caption, sizeof(caption), "%3s", name);
+      Meter_setCaption(data->meters[i], caption);
+   }
+
+   data->count = count;
+}
+
+static void NUMAMemoryMeter_init(Meter* this) {
+   if (!this->meterData)
+      this->meterData = xCalloc(1, sizeof(NUMAMemoryMeterData));
+
+   NUMAMemoryMeterData* data = this->meterData;
+   NUMAMemoryMeter_setCount(this, Platform_getNodeMemory(data->nodes, ARRAYSIZE(data->nodes)));
+}
+
+static void NUMAMemoryMeter_done(Meter* this) {
+   NUMAMemoryMeterData* data = this->meterData;
+   for (size_t i = 0; i < data->count; i++)
+      Meter_delete((Object*)data->meters[i]);
+   free(data);
+   this->meterData = NULL;
+}
+
+static void NUMAMemoryMeter_updateValues(Meter* this) {
+   NUMAMemoryMeterData* data = this->meterData;
+   size_t count = Platform_getNodeMemory(data->nodes, ARRAYSIZE(data->nodes));
+
+   if (count != data->count)
+      NUMAMemoryMeter_setCount(this, count);
+
+   for (size_t i = 0; i < data->count; i++)
+      NodeMemoryMeter_setValues(data->meters[i], &data->nodes[i]);
+}
+
+static void NUMAMemoryMeter_updateMode(Meter* this, MeterModeId mode) {
+   NUMAMemoryMeterData* data = this->meterData;
+   this->mode = mode;
+   this->h = 0;
+
+   for (size_t i = 0; i < data->count; i++) {
+      Meter_setMode(data->meters[i], mode);
+      this->h += data->meters[i]->h;
+   }
+
+   if (!this->h)
+      this->h = 1;
+}
+
+static void NUMAMemoryMeter_draw(Meter* this, int x, int y, int w) {
+   const NUMAMemoryMeterData* data = this->meterData;
+
+   if (!data->count) {
+      const char* caption = Meter_getCaption(this);
+      attrset(CRT_colors[METER_TEXT]);
+      mvaddnstr(y, x, caption, w);
+      int captionWidth = (int)strnlen(caption, (size_t)MAXIMUM(w, 0));
+      if (w > captionWidth) {
+         attrset(CRT_colors[METER_SHADOW]);
+         mvaddnstr(y, x + captionWidth, "no NUMA nodes", w - captionWidth);
+      }
+      attrset(CRT_colors[RESET_COLOR]);
+      return;
+   }
+
+   /* nodes appearing after the layout was computed are not drawn */
+   int bottom = y + this->h;
+   for (size_t i = 0; i < data->count; i++) {
+      Meter* meter = data->meters[i];
+      if (y + meter->h > bottom)
+         break;
+
+      meter->draw(meter, x, y, w);
+      y += meter->h;
+   }
+}
+
+const MeterClass NodeMemoryMeter_class = {
+   .super = {
+      .extends = Class(Meter),
+      .delete = Meter_delete,
+      .display = NodeMemoryMeter_display,
+   },
+   .defaultMode = BAR_METERMODE,
+   .supportedModes = METERMODE_DEFAULT_SUPPORTED,
+   .maxItems = 3,
+   .isPercentChart = true,
+   .total = 100.0,
+   .attributes = NodeMemoryMeter_attributes,
+   .name = "NodeMemory",
+   .uiName = "NUMA node memory",
+   .caption = "N"
+};
+
+const MeterClass NUMAMemoryMeter_class = {
+   .super = {
+      .extends = Class(Meter),
+      .delete = Meter_delete,
+      .display = NodeMemoryMeter_display,
+   },
+   .updateValues = NUMAMemoryMeter_updateValues,
+   .defaultMode = BAR_METERMODE,
+   .supportedModes = METERMODE_DEFAULT_SUPPORTED,
+   .maxItems = 3,
+   .isPercentChart = true,
+   .total = 100.0,
+   .attributes = NodeMemoryMeter_attributes,
+   .name = "NUMAMemory",
+   .uiName = "Memory per NUMA node",
+   .description = "Used, shared and cached memory of each NUMA node, one per line",
+   .caption = "Node",
+   .draw = NUMAMemoryMeter_draw,
+   .init = NUMAMemoryMeter_init,
+   .updateMode = NUMAMemoryMeter_updateMode,
+   .done = NUMAMemoryMeter_done
+};
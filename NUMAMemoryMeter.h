@@ -0,0 +1,30 @@
+#ifndef HEADER_NUMAMemoryMeter
+#define HEADER_NUMAMemoryMeter
+/*
+htop - NUMAMemoryMeter.h
+(C) 2026 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "Machine.h"
+#include "Meter.h"
+
+
+/* Nodes shown by the NUMAMemory meter, one per line */
+#define NUMA_MEMORY_METER_MAX_NODES 16
+
+/* Memory of a single NUMA node, in kibibytes */
+typedef struct NodeMemory_ {
+   unsigned int id;
+   memory_t total;
+   memory_t used;
+   memory_t shared;
+   memory_t cache;
+} NodeMemory;
+
+extern const MeterClass NodeMemoryMeter_class;
+
+extern const MeterClass NUMAMemoryMeter_class;
+
+#endif /* HEADER_NUMAMemoryMeter */
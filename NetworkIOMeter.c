@@ -39,13 +39,29 @@ static void NetworkIOMeter_updateValues(Meter* this) {
    const Machine* host = this->host;
 
    static uint64_t cached_last_update = 0;
+   static uint64_t cached_last_sample = 0;
    uint64_t passedTimeInMs = host->realtimeMs - cached_last_update;
    bool hasNewData = false;
    NetworkIOData data = {0};
 
-   /* update only every 500ms to have a sane span for rate calculation */
-   if (passedTimeInMs > 500) {
+   /* update only every 500ms to have a sane span for rate calculation,
+      unless the platform timestamps its samples and rate-limits them itself */
+   bool sampled = cached_last_sample || passedTimeInMs > 500;
+   if (sampled) {
       hasNewData = Platform_getNetworkIO(&data);
+      if (hasNewData && data.sampleMs) {
+         /* nothing to update while the platform still has the same sample */
+         sampled = data.sampleMs != cached_last_sample;
+         hasNewData = sampled;
+
+         /* measure the rate over the span the counters were sampled in */
+         if (sampled && cached_last_sample)
+            passedTimeInMs = data.sampleMs - cached_last_sample;
+         cached_last_sample = data.sampleMs;
+      }
+   }
+
+   if (sampled) {
       if (!hasNewData) {
          status = RATESTATUS_NODATA;
       } else if (cached_last_update == 0) {
@@ -17,6 +17,7 @@ typedef struct NetworkIOData_ {
    uint64_t packetsReceived;
    uint64_t bytesTransmitted;
    uint64_t packetsTransmitted;
+   uint64_t sampleMs;   /* monotonic time the counters were sampled at, 0 if unknown */
 } NetworkIOData;
 
 extern const MeterClass NetworkIOMeter_class;
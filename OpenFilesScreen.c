@@ -15,6 +15,7 @@ in the source distribution for its full text.
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 #include <sys/types.h>
 #include <sys/wait.h>
@@ -22,30 +23,12 @@ in the source distribution for its full text.
 
 #include "Macros.h"
 #include "Panel.h"
+#include "Platform.h"
 #include "ProvideCurses.h"
 #include "Vector.h"
 #include "XUtils.h"
 
 
-// cf. getIndexForType; must be larger than the maximum value returned.
-#define LSOF_DATACOL_COUNT 8
-
-typedef struct OpenFiles_Data_ {
-   char* data[LSOF_DATACOL_COUNT];
-} OpenFiles_Data;
-
-typedef struct OpenFiles_ProcessData_ {
-   OpenFiles_Data data;
-   int error;
-   int cols[LSOF_DATACOL_COUNT];
-   struct OpenFiles_FileData_* files;
-} OpenFiles_ProcessData;
-
-typedef struct OpenFiles_FileData_ {
-   OpenFiles_Data data;
-   struct OpenFiles_FileData_* next;
-} OpenFiles_FileData;
-
 static void OpenFiles_Data_clear(OpenFiles_Data* data);
 
 static size_t getIndexForType(char type) {
@@ -77,6 +60,23 @@ static const char* getDataForType(const OpenFiles_Data* data, char type) {
    return data->data[index] ? data->data[index] : "";
 }
 
+OpenFiles_ProcessData* OpenFiles_ProcessData_new(void) {
+   OpenFiles_ProcessData* pdata = xCalloc(1, sizeof(OpenFiles_ProcessData));
+   pdata->cols[getIndexForType('s')] = 8;
+   pdata->cols[getIndexForType('o')] = 8;
+   pdata->cols[getIndexForType('i')] = 8;
+   return pdata;
+}
+
+void OpenFiles_Data_set(OpenFiles_ProcessData* pdata, OpenFiles_Data* item, char type, const char* value) {
+   size_t index = getIndexForType(type);
+   free_and_xStrdup(&item->data[index], value);
+   size_t dlen = strlen(item->data[index]);
+   if (dlen > (size_t)pdata->cols[index]) {
+      pdata->cols[index] = (int)CLAMP(dlen, 0, INT16_MAX);
+   }
+}
+
 OpenFilesScreen* OpenFilesScreen_new(const Process* process) {
    OpenFilesScreen* this = xCalloc(1, sizeof(OpenFilesScreen));
    Object_setClass(this, Class(OpenFilesScreen));
@@ -97,10 +97,7 @@ static void OpenFilesScreen_draw(InfoScreen* this) {
 }
 
 static OpenFiles_ProcessData* OpenFilesScreen_getProcessData(pid_t pid) {
-   OpenFiles_ProcessData* pdata = xCalloc(1, sizeof(OpenFiles_ProcessData));
-   pdata->cols[getIndexForType('s')] = 8;
-   pdata->cols[getIndexForType('o')] = 8;
-   pdata->cols[getIndexForType('i')] = 8;
+   OpenFiles_ProcessData* pdata = OpenFiles_ProcessData_new();
 
    int fdpair[2] = {-1, -1};
    if (pipe(fdpair) < 0) {
@@ -170,29 +167,11 @@ static OpenFiles_ProcessData* OpenFilesScreen_getProcessData(pid_t pid) {
          case 'n':  /* file name, comment, Internet address */
          case 's':  /* file's size */
          case 't':  /* file's type */
-         {
-            size_t index = getIndexForType(cmd);
-            free_and_xStrdup(&item->data[index], line + 1);
-            size_t dlen = strlen(item->data[index]);
-            if (dlen > (size_t)pdata->cols[index]) {
-               pdata->cols[index] = (int)CLAMP(dlen, 0, INT16_MAX);
-            }
+            OpenFiles_Data_set(pdata, item, (char)cmd, line + 1);
             break;
-         }
          case 'o':  /* file's offset */
-         {
-            size_t index = getIndexForType(cmd);
-            if (String_startsWith(line + 1, "0t")) {
-               free_and_xStrdup(&item->data[index], line + 3);
-            } else {
-               free_and_xStrdup(&item->data[index], line + 1);
-            }
-            size_t dlen = strlen(item->data[index]);
-            if (dlen > (size_t)pdata->cols[index]) {
-               pdata->cols[index] = (int)CLAMP(dlen, 0, INT16_MAX);
-            }
+            OpenFiles_Data_set(pdata, item, (char)cmd, String_startsWith(line + 1, "0t") ? line + 3 : line + 1);
             break;
-         }
          case 'c':  /* process command name  */
          case 'd':  /* file's device character code */
          case 'g':  /* process group ID */
@@ -265,7 +244,10 @@ static void OpenFilesScreen_scan(InfoScreen* super) {
    Panel* panel = super->display;
    int idx = Panel_getSelectedIndex(panel);
    Panel_prune(panel);
-   OpenFiles_ProcessData* pdata = OpenFilesScreen_getProcessData(((OpenFilesScreen*)super)->pid);
+   pid_t pid = ((OpenFilesScreen*)super)->pid;
+   OpenFiles_ProcessData* pdata = Platform_getProcessOpenFiles(pid);
+   if (!pdata)
+      pdata = OpenFilesScreen_getProcessData(pid);
    if (pdata->error == 127) {
       InfoScreen_addLine(super, "Could not execute 'lsof'. Please make sure it is available in your $PATH.");
    } else if (pdata->error == 1) {
@@ -14,6 +14,26 @@ in the source distribution for its full text.
 #include "Process.h"
 
 
+// cf. getIndexForType in OpenFilesScreen.c; must be larger than the maximum value returned.
+#define LSOF_DATACOL_COUNT 8
+
+/* Columns are addressed by the lsof field letters: f a D i n s t o */
+typedef struct OpenFiles_Data_ {
+   char* data[LSOF_DATACOL_COUNT];
+} OpenFiles_Data;
+
+typedef struct OpenFiles_ProcessData_ {
+   OpenFiles_Data data;
+   int error;
+   int cols[LSOF_DATACOL_COUNT];
+   struct OpenFiles_FileData_* files;
+} OpenFiles_ProcessData;
+
+typedef struct OpenFiles_FileData_ {
+   OpenFiles_Data data;
+   struct OpenFiles_FileData_* next;
+} OpenFiles_FileData;
+
 typedef struct OpenFilesScreen_ {
    InfoScreen super;
    pid_t pid;
@@ -25,4 +45,9 @@ OpenFilesScreen* OpenFilesScreen_new(const Process* process);
 
 void OpenFilesScreen_delete(Object* this);
 
+OpenFiles_ProcessData* OpenFiles_ProcessData_new(void);
+
+/* Stores a copy of value in the column of the given lsof field letter */
+void OpenFiles_Data_set(OpenFiles_ProcessData* pdata, OpenFiles_Data* item, char type, const char* value);
+
 #endif
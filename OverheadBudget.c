@@ -0,0 +1,147 @@
+/*
+htop - OverheadBudget.c
+(C) 2026 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "OverheadBudget.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/resource.h>
+
+#include "Macros.h"
+#include "Platform.h"
+#include "Settings.h"
+#include "XUtils.h"
+
+
+/* cycles spent well below the budget before relaxing one level */
+#define OVERHEAD_CALM_CYCLES 5
+
+/* when throttling, expensive collectors run on one cycle out of this many */
+#define OVERHEAD_THROTTLE_INTERVAL 4
+
+void OverheadBudget_init(OverheadBudget* this) {
+   *this = (OverheadBudget) {
+      .level = OVERHEAD_LEVEL_FULL,
+      .delayFactor = 1,
+   };
+}
+
+static uint64_t OverheadBudget_selfCPUTimeUs(void) {
+   struct rusage ru;
+   if (getrusage(RUSAGE_SELF, &ru) != 0)
+      return 0;
+
+   return (uint64_t)(ru.ru_utime.tv_sec + ru.ru_stime.tv_sec) * 1000000ULL
+          + (uint64_t)(ru.ru_utime.tv_usec + ru.ru_stime.tv_usec);
+}
+
+static uint32_t OverheadBudget_collectorFlags(void) {
+   uint32_t flags = 0;
+   const OverheadCollector* collectors = Platform_getOverheadCollectors();
+   for (size_t i = 0; collectors && collectors[i].name; i++)
+      flags |= collectors[i].flag;
+   return flags;
+}
+
+static bool OverheadBudget_isLevelEffective(OverheadLevel level, uint32_t activeCollectors) {
+   switch (level) {
+      case OVERHEAD_LEVEL_THROTTLE:
+      case OVERHEAD_LEVEL_DROP:
+         return activeCollectors != 0;
+      default:
+         return true;
+   }
+}
+
+void OverheadBudget_update(OverheadBudget* this, const Settings* settings) {
+   uint64_t cpuUs = OverheadBudget_selfCPUTimeUs();
+   uint64_t wallMs;
+   Platform_gettime_monotonic(&wallMs);
+
+   if (this->lastWallMs && wallMs > this->lastWallMs && cpuUs >= this->lastCPUTimeUs) {
+      /* CPU microseconds per wall millisecond, scaled to percent */
+      double percent = (double)(cpuUs - this->lastCPUTimeUs) / (double)(wallMs - this->lastWallMs) / 10.0;
+      this->selfPercent = this->haveSample ? (this->selfPercent + percent) / 2.0 : percent;
+      this->haveSample = true;
+   }
+   this->lastCPUTimeUs = cpuUs;
+   this->lastWallMs = wallMs;
+   this->cycle++;
+
+   /* only the optional collectors the current screen enables are throttled */
+   const uint32_t active = OverheadBudget_collectorFlags() & settings->ss->flags;
+   OverheadLevel level = this->level;
+
+   if (settings->overheadBudget <= 0) {
+      level = OVERHEAD_LEVEL_FULL;
+      this->calmCycles = 0;
+   } else if (this->haveSample && this->selfPercent > settings->overheadBudget) {
+      do {
+         if (level + 1 >= LAST_OVERHEAD_LEVEL)
+            break;
+         level++;
+      } while (!OverheadBudget_isLevelEffective(level, active));
+      this->calmCycles = 0;
+   } else if (this->haveSample && this->selfPercent < settings->overheadBudget / 2.0) {
+      if (++this->calmCycles >= OVERHEAD_CALM_CYCLES && level > OVERHEAD_LEVEL_FULL) {
+         level--;
+         this->calmCycles = 0;
+      }
+   } else {
+      this->calmCycles = 0;
+   }
+
+   if (level != this->level) {
+      /* judge the new level by fresh samples only */
+      this->level = level;
+      this->haveSample = false;
+   }
+
+   switch (this->level) {
+      case OVERHEAD_LEVEL_FULL:
+         this->suppressedFlags = 0;
+         break;
+      case OVERHEAD_LEVEL_THROTTLE:
+         this->suppressedFlags = (this->cycle % OVERHEAD_THROTTLE_INTERVAL) ? active : 0;
+         break;
+      default:
+         this->suppressedFlags = active;
+         break;
+   }
+
+   this->delayFactor = this->level >= OVERHEAD_LEVEL_DELAY_2 ? 1 << (this->level - OVERHEAD_LEVEL_DROP) : 1;
+}
+
+int OverheadBudget_delay(const OverheadBudget* this, const Settings* settings) {
+   return settings->delay * this->delayFactor;
+}
+
+void OverheadBudget_describe(const OverheadBudget* this, const Settings* settings, char* buffer, size_t size) {
+   size_t len = 0;
+   buffer[0] = '\0';
+
+   if (this->level == OVERHEAD_LEVEL_THROTTLE || this->level >= OVERHEAD_LEVEL_DROP) {
+      const OverheadCollector* collectors = Platform_getOverheadCollectors();
+      bool any = false;
+      for (size_t i = 0; collectors && collectors[i].name; i++) {
+         if (!(collectors[i].flag & settings->ss->flags))
+            continue;
+
+         len += (size_t)xSnprintf(buffer + len, size - len, "%s%s", any ? "," : "", collectors[i].name);
+         any = true;
+         if (len >= size - 1)
+            return;
+      }
+      if (any)
+         len += (size_t)xSnprintf(buffer + len, size - len, " %s", this->level == OVERHEAD_LEVEL_THROTTLE ? "throttled" : "off");
+   }
+
+   if (this->delayFactor > 1 && len < size - 1)
+      xSnprintf(buffer + len, size - len, "%sdelay x%d", len ? ", " : "", this->delayFactor);
+}
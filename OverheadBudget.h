@@ -0,0 +1,58 @@
+#ifndef HEADER_OverheadBudget
+#define HEADER_OverheadBudget
+/*
+htop - OverheadBudget.h
+(C) 2026 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+
+struct Settings_;
+
+/* A per-process collector the budget may throttle, see Platform_getOverheadCollectors() */
+typedef struct OverheadCollector_ {
+   uint32_t flag;
+   const char* name;
+} OverheadCollector;
+
+typedef enum OverheadLevel_ {
+   OVERHEAD_LEVEL_FULL = 0,
+   OVERHEAD_LEVEL_THROTTLE,     /* expensive collectors run every few cycles only */
+   OVERHEAD_LEVEL_DROP,         /* expensive collectors are skipped */
+   OVERHEAD_LEVEL_DELAY_2,      /* additionally stretch the update interval */
+   OVERHEAD_LEVEL_DELAY_4,
+   OVERHEAD_LEVEL_DELAY_8,
+   LAST_OVERHEAD_LEVEL
+} OverheadLevel;
+
+typedef struct OverheadBudget_ {
+   double selfPercent;          /* htop's own CPU usage, smoothed over the last cycles */
+   bool haveSample;
+   uint64_t lastCPUTimeUs;
+   uint64_t lastWallMs;
+
+   OverheadLevel level;
+   unsigned int calmCycles;     /* consecutive cycles well below the budget */
+   unsigned int cycle;
+
+   uint32_t suppressedFlags;    /* process flags to skip during the next scan */
+   int delayFactor;
+} OverheadBudget;
+
+void OverheadBudget_init(OverheadBudget* this);
+
+/* Samples htop's CPU usage since the last call and adjusts the level; call once per scan */
+void OverheadBudget_update(OverheadBudget* this, const struct Settings_* settings);
+
+/* Update interval in tenths of seconds after stretching */
+int OverheadBudget_delay(const OverheadBudget* this, const struct Settings_* settings);
+
+/* Short summary of what is currently degraded, empty when running at full detail */
+void OverheadBudget_describe(const OverheadBudget* this, const struct Settings_* settings, char* buffer, size_t size);
+
+#endif
@@ -0,0 +1,77 @@
+/*
+htop - OverheadMeter.c
+(C) 2026 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "OverheadMeter.h"
+
+#include "CRT.h"
+#include "Machine.h"
+#include "Macros.h"
+#include "Meter.h"
+#include "Object.h"
+#include "OverheadBudget.h"
+#include "RichString.h"
+#include "Settings.h"
+#include "XUtils.h"
+
+
+static const int OverheadMeter_attributes[] = {
+   METER_VALUE
+};
+
+static void OverheadMeter_updateValues(Meter* this) {
+   const OverheadBudget* budget = &this->host->budget;
+   const Settings* settings = this->host->settings;
+
+   this->values[0] = budget->selfPercent;
+   this->total = settings->overheadBudget > 0 ? settings->overheadBudget : 100.0;
+
+   xSnprintf(this->txtBuffer, sizeof(this->txtBuffer), "%.1f%%", budget->selfPercent);
+}
+
+static void OverheadMeter_display(const Object* cast, RichString* out) {
+   const Meter* this = (const Meter*)cast;
+   const OverheadBudget* budget = &this->host->budget;
+   const Settings* settings = this->host->settings;
+   char buffer[128];
+   int len;
+
+   len = xSnprintf(buffer, sizeof(buffer), "%.1f%%", budget->selfPercent);
+   RichString_appendnAscii(out, CRT_colors[METER_VALUE], buffer, len);
+
+   if (settings->overheadBudget <= 0)
+      return;
+
+   len = xSnprintf(buffer, sizeof(buffer), " of %d%%", settings->overheadBudget);
+   RichString_appendnAscii(out, CRT_colors[METER_TEXT], buffer, len);
+
+   OverheadBudget_describe(budget, settings, buffer, sizeof(buffer));
+   if (buffer[0]) {
+      RichString_appendAscii(out, CRT_colors[METER_TEXT], " reduced: ");
+      RichString_appendAscii(out, CRT_colors[METER_VALUE_WARN], buffer);
+   }
+}
+
+const MeterClass OverheadMeter_class = {
+   .super = {
+      .extends = Class(Meter),
+      .delete = Meter_delete,
+      .display = OverheadMeter_display,
+   },
+   .updateValues = OverheadMeter_updateValues,
+   .defaultMode = TEXT_METERMODE,
+   .supportedModes = METERMODE_DEFAULT_SUPPORTED,
+   .maxItems = 1,
+   .isPercentChart = true,
+   .total = 100.0,
+   .attributes = OverheadMeter_attributes,
+   .name = "Overhead",
+   .uiName = "htop Overhead",
+   .caption = "htop: ",
+   .description = "CPU usage of htop itself and any detail reduced to stay within the budget"
+};
@@ -0,0 +1,15 @@
+#ifndef HEADER_OverheadMeter
+#define HEADER_OverheadMeter
+/*
+htop - OverheadMeter.h
+(C) 2026 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "Meter.h"
+
+
+extern const MeterClass OverheadMeter_class;
+
+#endif
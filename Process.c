@@ -24,6 +24,7 @@ in the source distribution for its full text.
 #include "Hashtable.h"
 #include "Machine.h"
 #include "Macros.h"
+#include "Platform.h"
 #include "ProcessTable.h"
 #include "DynamicColumn.h"
 #include "RichString.h"
@@ -51,6 +52,23 @@ void Process_fillStarttimeBuffer(Process* this) {
             &date);
 }
 
+void Process_resetReused(Process* this) {
+   Row* super = &this->super;
+
+   /* a tag must not carry over to an unrelated process */
+   super->tag = false;
+   super->seenStampMs = super->host->monotonicMs;
+   super->tombStampMs = 0;
+
+   this->isKernelThread = false;
+   this->isRunningInContainer = TRI_INITIAL;
+   this->elevated_priv = TRI_INITIAL;
+   this->procExeDeleted = false;
+   this->usesDeletedLib = false;
+   this->mergedCommand.lastUpdate = 0;
+   this->m_resident_max = 0;
+}
+
 /*
  * TASK_COMM_LEN is defined to be 16 for /proc/[pid]/comm in man proc(5), but it is
  * not available in an userspace header - so define it.
@@ -697,7 +715,7 @@ void Process_writeField(const Process* this, RichString* str, RowField field) {
    }
    case MAJFLT: Row_printCount(str, this->majflt, coloring); return;
    case MINFLT: Row_printCount(str, this->minflt, coloring); return;
-   case M_RESIDENT: Row_printKBytes(str, this->m_resident, coloring); return;
+   case M_RESIDENT: Row_printKBytes(str, Process_showsSubtree(this) ? this->subtree_m_resident : this->m_resident, coloring); return;
    case M_VIRT: Row_printKBytes(str, this->m_virt, coloring); return;
    case NICE:
       if (this->nice == PROCESS_NICE_UNKNOWN) {
@@ -716,13 +734,13 @@ void Process_writeField(const Process* this, RichString* str, RowField field) {
 
       xSnprintf(buffer, n, "%4ld ", this->nlwp);
       break;
-   case PERCENT_CPU: Row_printPercentage(this->percent_cpu, buffer, n, Row_fieldWidths[PERCENT_CPU], &attr); break;
+   case PERCENT_CPU: Row_printPercentage(Process_showsSubtree(this) ? this->subtree_percent_cpu : this->percent_cpu, buffer, n, Row_fieldWidths[PERCENT_CPU], &attr); break;
    case PERCENT_NORM_CPU: {
-      float cpuPercentage = this->percent_cpu / host->activeCPUs;
+      float cpuPercentage = (Process_showsSubtree(this) ? this->subtree_percent_cpu : this->percent_cpu) / host->activeCPUs;
       Row_printPercentage(cpuPercentage, buffer, n, Row_fieldWidths[PERCENT_CPU], &attr);
       break;
    }
-   case PERCENT_MEM: Row_printPercentage(this->percent_mem, buffer, n, 4, &attr); break;
+   case PERCENT_MEM: Row_printPercentage(Process_showsSubtree(this) ? this->subtree_percent_mem : this->percent_mem, buffer, n, 4, &attr); break;
    case PGRP: xSnprintf(buffer, n, "%*d ", Process_pidDigits, this->pgrp); break;
    case PID: xSnprintf(buffer, n, "%*d ", Process_pidDigits, Process_getPid(this)); break;
    case PPID: xSnprintf(buffer, n, "%*d ", Process_pidDigits, Process_getParent(this)); break;
@@ -963,6 +981,45 @@ int Process_compareByParent(const Row* r1, const Row* r2) {
    return Process_compare(r1, r2);
 }
 
+void Process_subtreeReset(Row* super) {
+   Process* this = (Process*) super;
+
+   this->subtree_count = 0;
+   this->subtree_percent_cpu = isNonnegative(this->percent_cpu) ? this->percent_cpu : 0.0F;
+   this->subtree_percent_mem = isNonnegative(this->percent_mem) ? this->percent_mem : 0.0F;
+   this->subtree_m_resident = MAXIMUM(this->m_resident, 0);
+
+   double ioRate = Platform_getProcessIORate(this);
+   this->subtree_io_rate = isNonnegative(ioRate) ? ioRate : 0.0;
+}
+
+void Process_subtreeAdd(Row* super, const Row* child) {
+   Process* this = (Process*) super;
+   const Process* p = (const Process*) child;
+
+   /* userland threads are already accounted in their process */
+   if (Process_isUserlandThread(p))
+      return;
+
+   /* hidden kernel threads are not rescanned, their values would be stale */
+   if (Process_isKernelThread(p) && super->host->settings->hideKernelThreads)
+      return;
+
+   /* exited processes only linger to be shown highlighted, as for the user totals */
+   if (child->tombStampMs)
+      return;
+
+   this->subtree_count += p->subtree_count + 1;
+   this->subtree_percent_cpu += p->subtree_percent_cpu;
+   this->subtree_percent_mem += p->subtree_percent_mem;
+   this->subtree_m_resident += p->subtree_m_resident;
+   this->subtree_io_rate += p->subtree_io_rate;
+}
+
+bool Process_showsSubtree(const Process* this) {
+   return this->subtree_count > 0 && !this->super.showChildren && this->super.host->settings->ss->treeView;
+}
+
 int Process_compareByKey_Base(const Process* p1, const Process* p2, ProcessField key) {
    int r;
 
@@ -1040,6 +1097,79 @@ int Process_compareByKey_Base(const Process* p1, const Process* p2, ProcessField
    }
 }
 
+bool Process_sortKeyValue_Base(const Process* this, ProcessField key, uint64_t* value) {
+   switch (key) {
+   case PERCENT_CPU:
+   case PERCENT_NORM_CPU:
+      *value = Row_sortKeyReal(this->percent_cpu);
+      return true;
+   case PERCENT_MEM:
+   case M_RESIDENT:
+      *value = Row_sortKeySigned(this->m_resident);
+      return true;
+   case M_VIRT:
+      *value = Row_sortKeySigned(this->m_virt);
+      return true;
+   case MAJFLT:
+      *value = Row_sortKeyUnsigned(this->majflt);
+      return true;
+   case MINFLT:
+      *value = Row_sortKeyUnsigned(this->minflt);
+      return true;
+   case NICE:
+      *value = Row_sortKeySigned(this->nice);
+      return true;
+   case NLWP:
+      *value = Row_sortKeySigned(this->nlwp);
+      return true;
+   case PGRP:
+      *value = Row_sortKeySigned(this->pgrp);
+      return true;
+   case PID:
+      *value = Row_sortKeySigned(Process_getPid(this));
+      return true;
+   case PPID:
+      *value = Row_sortKeySigned(Process_getParent(this));
+      return true;
+   case PRIORITY:
+      *value = Row_sortKeySigned(this->priority);
+      return true;
+   case PROCESSOR:
+      *value = Row_sortKeySigned(this->processor);
+      return true;
+   case SCHEDULERPOLICY:
+      *value = Row_sortKeySigned(this->scheduling_policy);
+      return true;
+   case SESSION:
+      *value = Row_sortKeySigned(this->session);
+      return true;
+   case STATE:
+      *value = Row_sortKeySigned(this->state);
+      return true;
+   case ST_UID:
+      *value = Row_sortKeyUnsigned(this->st_uid);
+      return true;
+   case TIME:
+      *value = Row_sortKeyUnsigned(this->time);
+      return true;
+   case TGID:
+      *value = Row_sortKeySigned(Process_getThreadGroup(this));
+      return true;
+   case TPGID:
+      *value = Row_sortKeySigned(this->tpgid);
+      return true;
+   default:
+      /* strings, and ELAPSED/STARTTIME which break ties inside the key */
+      return false;
+   }
+}
+
+bool Process_rowSortKeyValue(const Row* super, RowField key, uint64_t* value) {
+   const Process* this = (const Process*) super;
+   assert(Object_isA((const Object*) this, (const ObjectClass*) &Process_class));
+   return Process_sortKeyValue(this, key, value);
+}
+
 void Process_updateComm(Process* this, const char* comm) {
    if (!this->procComm && !comm)
       return;
@@ -1146,6 +1276,9 @@ const ProcessClass Process_class = {
       .matchesFilter = Process_rowMatchesFilter,
       .sortKeyString = Process_rowGetSortKey,
       .compareByParent = Process_compareByParent,
+      .subtreeReset = Process_subtreeReset,
+      .subtreeAdd = Process_subtreeAdd,
+      .sortKeyValue = Process_rowSortKeyValue,
       .writeField = Process_rowWriteField
    },
 };
@@ -17,6 +17,7 @@ in the source distribution for its full text.
 #include "RichString.h"
 #include "Row.h"
 #include "RowField.h"
+#include "UserStats.h"
 
 
 #define PROCESS_FLAG_IO              0x00000001
@@ -182,6 +183,9 @@ typedef struct Process_ {
    /* Resident set size (in kilobytes) */
    long m_resident;
 
+   /* Highest resident set size seen by the scans (in kilobytes) */
+   long m_resident_max;
+
    /* Number of minor faults the process has made which have not required loading a memory page from disk */
    unsigned long int minflt;
 
@@ -198,6 +202,16 @@ typedef struct Process_ {
     * Internal state for merged Command display
     */
    ProcessMergedCommand mergedCommand;
+
+   /* Contribution to the per-user totals, while those are maintained */
+   UserStatsShare userShare;
+
+   /* Totals over this process and its descendants, rebuilt with the tree */
+   unsigned int subtree_count;
+   float subtree_percent_cpu;
+   float subtree_percent_mem;
+   long subtree_m_resident;
+   double subtree_io_rate;
 } Process;
 
 typedef struct ProcessFieldData_ {
@@ -233,6 +247,10 @@ typedef int32_t ProcessField;  /* see ReservedField list in RowField.h */
 void Process_writeField(const Process* this, RichString* str, ProcessField field);
 int Process_compare(const void* v1, const void* v2);
 int Process_compareByParent(const Row* r1, const Row* r2);
+void Process_subtreeReset(Row* super);
+void Process_subtreeAdd(Row* super, const Row* child);
+/* Whether a collapsed tree node displays the totals of its subtree */
+bool Process_showsSubtree(const Process* this);
 void Process_delete(Object* cast);
 extern const ProcessFieldData Process_fields[LAST_PROCESSFIELD];
 #define Process_pidDigits Row_pidDigits
@@ -240,15 +258,18 @@ extern const ProcessFieldData Process_fields[LAST_PROCESSFIELD];
 
 typedef Process* (*Process_New)(const struct Machine_*);
 typedef int (*Process_CompareByKey)(const Process*, const Process*, ProcessField);
+typedef bool (*Process_SortKeyValue)(const Process*, ProcessField, uint64_t*);
 
 typedef struct ProcessClass_ {
    const RowClass super;
    const Process_CompareByKey compareByKey;
+   const Process_SortKeyValue sortKeyValue;
 } ProcessClass;
 
 #define As_Process(this_)   ((const ProcessClass*)((this_)->super.super.klass))
 
 #define Process_compareByKey(p1_, p2_, key_)   (As_Process(p1_)->compareByKey ? (As_Process(p1_)->compareByKey(p1_, p2_, key_)) : Process_compareByKey_Base(p1_, p2_, key_))
+#define Process_sortKeyValue(p_, key_, out_)   (As_Process(p_)->sortKeyValue ? (As_Process(p_)->sortKeyValue(p_, key_, out_)) : Process_sortKeyValue_Base(p_, key_, out_))
 
 
 static inline void Process_setPid(Process* this, pid_t pid) {
@@ -299,6 +320,9 @@ static inline bool Process_isThread(const Process* this) {
 
 void Process_fillStarttimeBuffer(Process* this);
 
+/* Forgets state of a previous process with the same pid */
+void Process_resetReused(Process* this);
+
 void Process_done(Process* this);
 
 extern const ProcessClass Process_class;
@@ -317,12 +341,18 @@ bool Process_rowIsVisible(const Row* super, const struct Table_* table);
 
 bool Process_rowMatchesFilter(const Row* super, const struct Table_* table);
 
+bool Process_rowSortKeyValue(const Row* super, RowField key, uint64_t* value);
+
 static inline int Process_pidEqualCompare(const void* v1, const void* v2) {
    return Row_idEqualCompare(v1, v2);
 }
 
 int Process_compareByKey_Base(const Process* p1, const Process* p2, ProcessField key);
 
+/* Numeric keys must sort exactly like Process_compareByKey_Base();
+ * returns false for keys that need the comparator (e.g. strings) */
+bool Process_sortKeyValue_Base(const Process* this, ProcessField key, uint64_t* value);
+
 const char* Process_getCommand(const Process* this);
 
 void Process_updateComm(Process* this, const char* comm);
@@ -39,13 +39,6 @@ static void ProcessLocksScreen_draw(InfoScreen* this) {
    InfoScreen_drawTitled(this, "Snapshot of file locks of process %d - %s", ((ProcessLocksScreen*)this)->pid, Process_getCommand(this->process));
 }
 
-static inline void FileLocks_Data_clear(FileLocks_Data* data) {
-   free(data->locktype);
-   free(data->exclusive);
-   free(data->readwrite);
-   free(data->filename);
-}
-
 static void ProcessLocksScreen_scan(InfoScreen* this) {
    Panel* panel = this->display;
    int idx = Panel_getSelectedIndex(panel);
@@ -56,12 +49,12 @@ static void ProcessLocksScreen_scan(InfoScreen* this) {
    } else if (pdata->error) {
       InfoScreen_addLine(this, "Could not determine file locks.");
    } else {
-      FileLocks_LockData* ldata = pdata->locks;
+      const FileLocks_LockData* ldata = pdata->locks;
       if (!ldata) {
          InfoScreen_addLine(this, "No locks have been found for the selected process.");
       }
-      while (ldata) {
-         FileLocks_Data* data = &ldata->data;
+      for (; ldata; ldata = ldata->next) {
+         const FileLocks_Data* data = &ldata->data;
 
          char entry[512];
          if (ULLONG_MAX == data->end) {
@@ -83,14 +76,9 @@ static void ProcessLocksScreen_scan(InfoScreen* this) {
          }
 
          InfoScreen_addLine(this, entry);
-         FileLocks_Data_clear(&ldata->data);
-
-         FileLocks_LockData* old = ldata;
-         ldata = ldata->next;
-         free(old);
       }
    }
-   free(pdata);
+   FileLocks_ProcessData_delete(pdata);
    Vector_insertionSort(this->lines);
    Vector_insertionSort(panel->items);
    Panel_setSelected(panel, idx);
@@ -9,6 +9,7 @@ in the source distribution for its full text.
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <stdlib.h>
 #include <sys/types.h>
 
 #include "InfoScreen.h"
@@ -22,6 +23,7 @@ typedef struct ProcessLocksScreen_ {
 } ProcessLocksScreen;
 
 typedef struct FileLocks_Data_ {
+   pid_t pid;
    char* locktype;
    char* exclusive;
    char* readwrite;
@@ -43,6 +45,24 @@ typedef struct FileLocks_ProcessData_ {
    struct FileLocks_LockData_* locks;
 } FileLocks_ProcessData;
 
+static inline void FileLocks_ProcessData_delete(FileLocks_ProcessData* pdata) {
+   if (!pdata)
+      return;
+
+   for (FileLocks_LockData* ldata = pdata->locks; ldata; ) {
+      FileLocks_Data* data = &ldata->data;
+      free(data->locktype);
+      free(data->exclusive);
+      free(data->readwrite);
+      free(data->filename);
+
+      FileLocks_LockData* old = ldata;
+      ldata = ldata->next;
+      free(old);
+   }
+   free(pdata);
+}
+
 extern const InfoScreenClass ProcessLocksScreen_class;
 
 ProcessLocksScreen* ProcessLocksScreen_new(const Process* process);
@@ -13,8 +13,10 @@ in the source distribution for its full text.
 #include <stdlib.h>
 
 #include "Hashtable.h"
+#include "Platform.h"
 #include "Row.h"
 #include "Settings.h"
+#include "UserStats.h"
 #include "Vector.h"
 
 
@@ -22,9 +24,13 @@ void ProcessTable_init(ProcessTable* this, const ObjectClass* klass, Machine* ho
    Table_init(&this->super, klass, host);
 
    this->pidMatchList = pidMatchList;
+   this->userStats = NULL;
+   this->exitLog = ExitLog_new();
 }
 
 void ProcessTable_done(ProcessTable* this) {
+   UserStats_delete(this->userStats);
+   ExitLog_delete(this->exitLog);
    Table_done(&this->super);
 }
 
@@ -59,7 +65,44 @@ static void ProcessTable_iterateEntries(Table* super) {
    ProcessTable_goThroughEntries(this);
 }
 
+/* Threads are part of their process; kernel threads are not attributed to a user */
+static void ProcessTable_accountUser(UserStats* userStats, Process* p) {
+   if (Process_isThread(p))
+      return;
+
+   if (p->super.updated && p->super.tombStampMs == 0)
+      UserStats_account(userStats, p, Platform_getProcessIORate(p));
+   else
+      UserStats_withdraw(userStats, p);
+}
+
+void ProcessTable_enableUserStats(ProcessTable* this) {
+   if (this->userStats)
+      return;
+
+   /* start from the current values, as the next scan may be a while away when paused */
+   this->userStats = UserStats_new();
+   const Vector* rows = this->super.rows;
+   for (int i = 0; i < Vector_size(rows); i++)
+      ProcessTable_accountUser(this->userStats, (Process*) Vector_get(rows, i));
+}
+
+void ProcessTable_disableUserStats(ProcessTable* this) {
+   UserStats_delete(this->userStats);
+   this->userStats = NULL;
+}
+
+void ProcessTable_logExit(ProcessTable* this, const Process* p, const char* name) {
+   /* threads come and go with their process */
+   if (Process_isThread(p))
+      return;
+
+   const Process* parent = ProcessTable_findProcess(this, Process_getParent(p));
+   ExitLog_add(this->exitLog, p, parent, name, this->super.host->realtimeMs);
+}
+
 static void ProcessTable_cleanupEntries(Table* super) {
+   ProcessTable* this = (ProcessTable*) super;
    Machine* host = super->host;
    const Settings* settings = host->settings;
 
@@ -82,6 +125,17 @@ static void ProcessTable_cleanupEntries(Table* super) {
       if (pid > host->maxProcessId)
          host->maxProcessId = pid;
 
+      if (this->userStats)
+         ProcessTable_accountUser(this->userStats, p);
+
+      if (p->super.updated) {
+         if (p->m_resident > p->m_resident_max)
+            p->m_resident_max = p->m_resident;
+      } else if (p->super.tombStampMs == 0) {
+         // missed for the first time, so it has just exited
+         ProcessTable_logExit(this, p, NULL);
+      }
+
       if (!Table_cleanupRow(super, &p->super, i)) {
          dirtyIndex = i;
       }
@@ -10,11 +10,13 @@ in the source distribution for its full text.
 #include <stdbool.h>
 #include <sys/types.h>
 
+#include "ExitLog.h"
 #include "Hashtable.h"
 #include "Machine.h"
 #include "Object.h"
 #include "Process.h"
 #include "Table.h"
+#include "UserStats.h"
 
 
 typedef struct ProcessTable_ {
@@ -26,6 +28,12 @@ typedef struct ProcessTable_ {
    unsigned int runningTasks;
    unsigned int userlandThreads;
    unsigned int kernelThreads;
+
+   /* Per-user totals, maintained during cleanup while not NULL */
+   UserStats* userStats;
+
+   /* Recently exited processes */
+   ExitLog* exitLog;
 } ProcessTable;
 
 /* Implemented by platforms */
@@ -37,6 +45,17 @@ void ProcessTable_init(ProcessTable* this, const ObjectClass* klass, Machine* ho
 
 void ProcessTable_done(ProcessTable* this);
 
+/* Maintains per-user totals from now on, starting from the current rows */
+void ProcessTable_enableUserStats(ProcessTable* this);
+
+void ProcessTable_disableUserStats(ProcessTable* this);
+
+/*
+ * Logs the exit of a process. name is the command name of a process that
+ * exited before it was fully read, NULL otherwise.
+ */
+void ProcessTable_logExit(ProcessTable* this, const Process* proc, const char* name);
+
 extern const TableClass ProcessTable_class;
 
 static inline void ProcessTable_add(ProcessTable* this, Process* process) {
@@ -0,0 +1,139 @@
+/*
+htop - Profiler.c
+(C) 2026 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "Profiler.h"
+
+#include <assert.h>
+#include <inttypes.h>
+#include <time.h>
+
+#include "Platform.h"
+
+
+bool Profiler_enabled = false;
+
+static ProfilerPhase* phases[PROFILER_MAX_PHASES];
+static size_t phaseCount;
+static unsigned int depth;
+static unsigned int cycles;
+
+static uint64_t Profiler_now(void) {
+   struct timespec ts;
+   if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0)
+      return 0;
+
+   return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+void Profiler_enable(void) {
+   Profiler_enabled = true;
+}
+
+void Profiler_beginPhase(ProfilerPhase* phase, ProfilerMark* mark) {
+   if (!phase->registered) {
+      if (phaseCount >= PROFILER_MAX_PHASES)
+         return;
+
+      phase->registered = true;
+      phase->depth = depth;
+      phases[phaseCount++] = phase;
+   }
+
+   depth++;
+
+   mark->started = true;
+   mark->haveIO = phase->sampleIO && Platform_getSelfIOCounters(&mark->reads, &mark->writes, &mark->bytes);
+   mark->ns = Profiler_now();
+}
+
+void Profiler_endPhase(ProfilerPhase* phase, ProfilerMark* mark) {
+   uint64_t now = Profiler_now();
+
+   assert(depth > 0);
+   depth--;
+
+   phase->cycleCalls++;
+   phase->cycleNs += now - mark->ns;
+
+   uint64_t reads;
+   uint64_t writes;
+   uint64_t bytes;
+   if (mark->haveIO && Platform_getSelfIOCounters(&reads, &writes, &bytes)) {
+      phase->cycleReads += reads - mark->reads;
+      phase->cycleWrites += writes - mark->writes;
+      phase->cycleBytes += bytes - mark->bytes;
+   }
+}
+
+void Profiler_cycle(void) {
+   if (!Profiler_enabled)
+      return;
+
+   for (size_t i = 0; i < phaseCount; i++) {
+      ProfilerPhase* phase = phases[i];
+
+      phase->lastCalls = phase->cycleCalls;
+      phase->lastNs = phase->cycleNs;
+      phase->lastReads = phase->cycleReads;
+      phase->lastWrites = phase->cycleWrites;
+      phase->lastBytes = phase->cycleBytes;
+
+      if (phase->cycleCalls) {
+         phase->cycles++;
+         phase->totalNs += phase->cycleNs;
+         phase->totalReads += phase->cycleReads;
+         phase->totalWrites += phase->cycleWrites;
+         phase->totalBytes += phase->cycleBytes;
+         if (phase->cycleNs > phase->maxNs)
+            phase->maxNs = phase->cycleNs;
+      }
+
+      phase->cycleCalls = 0;
+      phase->cycleNs = 0;
+      phase->cycleReads = 0;
+      phase->cycleWrites = 0;
+      phase->cycleBytes = 0;
+   }
+
+   cycles++;
+}
+
+unsigned int Profiler_getCycles(void) {
+   return cycles;
+}
+
+size_t Profiler_getPhaseCount(void) {
+   return phaseCount;
+}
+
+const ProfilerPhase* Profiler_getPhase(size_t idx) {
+   assert(idx < phaseCount);
+   return phases[idx];
+}
+
+void Profiler_dump(FILE* fp) {
+   fprintf(fp, "# phase\tdepth\tcycles\tlast_calls\tlast_us\tavg_us\tmax_us\tavg_reads\tavg_writes\tavg_bytes\n");
+
+   for (size_t i = 0; i < phaseCount; i++) {
+      const ProfilerPhase* phase = phases[i];
+      unsigned int n = phase->cycles ? phase->cycles : 1;
+
+      fprintf(fp, "%s\t%u\t%u\t%u\t%" PRIu64 "\t%" PRIu64 "\t%" PRIu64 "\t%" PRIu64 "\t%" PRIu64 "\t%" PRIu64 "\n",
+              phase->name,
+              phase->depth,
+              phase->cycles,
+              phase->lastCalls,
+              phase->lastNs / 1000,
+              phase->totalNs / n / 1000,
+              phase->maxNs / 1000,
+              phase->totalReads / n,
+              phase->totalWrites / n,
+              phase->totalBytes / n);
+   }
+}
@@ -0,0 +1,102 @@
+#ifndef HEADER_Profiler
+#define HEADER_Profiler
+/*
+htop - Profiler.h
+(C) 2026 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+
+/* Self-profiling of htop's own refresh work.
+ *
+ * A phase is a named, statically allocated section of code. Timings
+ * are accumulated over one refresh cycle (so per-process readers add
+ * up across all processes) and folded into last/avg/max statistics by
+ * Profiler_cycle(). All hooks are no-ops until Profiler_enable(). */
+
+#define PROFILER_MAX_PHASES 64
+
+typedef struct ProfilerPhase_ {
+   const char* name;
+   bool sampleIO;          /* also account read(2) and write(2) calls and bytes read (expensive per call) */
+   bool registered;
+   unsigned int depth;     /* nesting level at first use, for display */
+
+   /* accumulated during the current cycle */
+   unsigned int cycleCalls;
+   uint64_t cycleNs;
+   uint64_t cycleReads;
+   uint64_t cycleWrites;
+   uint64_t cycleBytes;
+
+   /* statistics over completed cycles */
+   unsigned int cycles;    /* cycles the phase was active in */
+   unsigned int lastCalls;
+   uint64_t lastNs;
+   uint64_t maxNs;
+   uint64_t totalNs;
+   uint64_t lastReads;
+   uint64_t totalReads;
+   uint64_t lastWrites;
+   uint64_t totalWrites;
+   uint64_t lastBytes;
+   uint64_t totalBytes;
+} ProfilerPhase;
+
+typedef struct ProfilerMark_ {
+   bool started;
+   bool haveIO;
+   uint64_t ns;
+   uint64_t reads;
+   uint64_t writes;
+   uint64_t bytes;
+} ProfilerMark;
+
+#define PROFILER_PHASE_INIT(name_, sampleIO_) { .name = (name_), .sampleIO = (sampleIO_) }
+
+/* Declares a phase local to the enclosing function and starts timing it */
+#define PROFILER_BEGIN(var_, name_, sampleIO_) \
+   static ProfilerPhase var_ = PROFILER_PHASE_INIT(name_, sampleIO_); \
+   ProfilerMark var_##Mark; \
+   Profiler_begin(&(var_), &(var_##Mark))
+
+#define PROFILER_END(var_) \
+   Profiler_end(&(var_), &(var_##Mark))
+
+extern bool Profiler_enabled;
+
+void Profiler_enable(void);
+
+void Profiler_beginPhase(ProfilerPhase* phase, ProfilerMark* mark);
+
+void Profiler_endPhase(ProfilerPhase* phase, ProfilerMark* mark);
+
+static inline void Profiler_begin(ProfilerPhase* phase, ProfilerMark* mark) {
+   mark->started = false;
+   if (Profiler_enabled)
+      Profiler_beginPhase(phase, mark);
+}
+
+static inline void Profiler_end(ProfilerPhase* phase, ProfilerMark* mark) {
+   if (mark->started)
+      Profiler_endPhase(phase, mark);
+}
+
+/* Closes the current refresh cycle; call once before each scan */
+void Profiler_cycle(void);
+
+unsigned int Profiler_getCycles(void);
+
+size_t Profiler_getPhaseCount(void);
+
+const ProfilerPhase* Profiler_getPhase(size_t idx);
+
+/* Writes a tab separated summary of all phases */
+void Profiler_dump(FILE* fp);
+
+#endif
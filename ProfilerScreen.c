@@ -0,0 +1,84 @@
+/*
+htop - ProfilerScreen.c
+(C) 2026 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "ProfilerScreen.h"
+
+#include <inttypes.h>
+#include <stdlib.h>
+
+#include "Macros.h"
+#include "Panel.h"
+#include "Profiler.h"
+#include "ProvideCurses.h"
+#include "XUtils.h"
+
+
+ProfilerScreen* ProfilerScreen_new(void) {
+   ProfilerScreen* this = xMalloc(sizeof(ProfilerScreen));
+   Object_setClass(this, Class(ProfilerScreen));
+   return (ProfilerScreen*) InfoScreen_init(&this->super, NULL, NULL, LINES - 2, "PHASE                                     CALLS    LAST ms     AVG ms     MAX ms  AVG READS  AVG WRITES   AVG BYTES");
+}
+
+void ProfilerScreen_delete(Object* this) {
+   free(InfoScreen_done((InfoScreen*)this));
+}
+
+static void ProfilerScreen_draw(InfoScreen* this) {
+   InfoScreen_drawTitled(this, "htop self-profile over %u refresh cycles", Profiler_getCycles());
+}
+
+static void ProfilerScreen_scan(InfoScreen* this) {
+   Panel* panel = this->display;
+   int idx = MAXIMUM(Panel_getSelectedIndex(panel), 0);
+
+   Panel_prune(panel);
+
+   size_t count = Profiler_getPhaseCount();
+   if (!count)
+      InfoScreen_addLine(this, "No samples yet; timings are collected from the next refresh on.");
+
+   for (size_t i = 0; i < count; i++) {
+      const ProfilerPhase* phase = Profiler_getPhase(i);
+      unsigned int cycles = phase->cycles ? phase->cycles : 1;
+      int indent = (int)MINIMUM(phase->depth * 2, 16);
+
+      char reads[16] = "-";
+      char writes[16] = "-";
+      char bytes[16] = "-";
+      if (phase->sampleIO) {
+         xSnprintf(reads, sizeof(reads), "%" PRIu64, phase->totalReads / cycles);
+         xSnprintf(writes, sizeof(writes), "%" PRIu64, phase->totalWrites / cycles);
+         xSnprintf(bytes, sizeof(bytes), "%" PRIu64, phase->totalBytes / cycles);
+      }
+
+      char line[256];
+      xSnprintf(line, sizeof(line), "%*s%-*.*s %8u %10.3f %10.3f %10.3f %10s %11s %11s",
+         indent, "",
+         40 - indent, 40 - indent, phase->name,
+         phase->lastCalls,
+         phase->lastNs / 1e6,
+         phase->totalNs / (double)cycles / 1e6,
+         phase->maxNs / 1e6,
+         reads,
+         writes,
+         bytes);
+      InfoScreen_addLine(this, line);
+   }
+
+   Panel_setSelected(panel, idx);
+}
+
+const InfoScreenClass ProfilerScreen_class = {
+   .super = {
+      .extends = Class(Object),
+      .delete = ProfilerScreen_delete
+   },
+   .scan = ProfilerScreen_scan,
+   .draw = ProfilerScreen_draw
+};
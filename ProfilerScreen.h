@@ -0,0 +1,24 @@
+#ifndef HEADER_ProfilerScreen
+#define HEADER_ProfilerScreen
+/*
+htop - ProfilerScreen.h
+(C) 2026 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "InfoScreen.h"
+#include "Object.h"
+
+
+typedef struct ProfilerScreen_ {
+   InfoScreen super;
+} ProfilerScreen;
+
+extern const InfoScreenClass ProfilerScreen_class;
+
+ProfilerScreen* ProfilerScreen_new(void);
+
+void ProfilerScreen_delete(Object* this);
+
+#endif
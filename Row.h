@@ -11,8 +11,10 @@ in the source distribution for its full text.
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 #include <sys/types.h>
 
+#include "Macros.h"
 #include "Object.h"
 #include "RichString.h"
 #include "RowField.h"
@@ -83,6 +85,9 @@ typedef bool (*Row_IsVisible)(const Row*, const struct Table_*);
 typedef bool (*Row_MatchesFilter)(const Row*, const struct Table_*);
 typedef const char* (*Row_SortKeyString)(Row*);
 typedef int (*Row_CompareByParent)(const Row*, const Row*);
+typedef bool (*Row_SortKeyValue)(const Row*, RowField, uint64_t*);
+typedef void (*Row_SubtreeReset)(Row*);
+typedef void (*Row_SubtreeAdd)(Row*, const Row*);
 
 int Row_compare(const void* v1, const void* v2);
 
@@ -94,6 +99,15 @@ typedef struct RowClass_ {
    const Row_MatchesFilter matchesFilter;
    const Row_SortKeyString sortKeyString;
    const Row_CompareByParent compareByParent;
+   /* Optional: encode a numeric column as an order-preserving integer, so
+    * the table can sort a dense key array instead of chasing row pointers.
+    * Only valid for classes whose compare orders by key, then direction,
+    * then id (and whose compareByParent puts the parent in front of that). */
+   const Row_SortKeyValue sortKeyValue;
+   /* Optional: totals over a subtree, built bottom-up with the tree. A row
+    * is reset before its children are visited and then added to its parent. */
+   const Row_SubtreeReset subtreeReset;
+   const Row_SubtreeAdd subtreeAdd;
 } RowClass;
 
 #define As_Row(this_)  ((const RowClass*)((this_)->super.klass))
@@ -103,6 +117,9 @@ typedef struct RowClass_ {
 #define Row_matchesFilter(r_, t_)  (As_Row(r_)->matchesFilter ? (As_Row(r_)->matchesFilter(r_, t_)) : false)
 #define Row_sortKeyString(r_)  (As_Row(r_)->sortKeyString ? (As_Row(r_)->sortKeyString(r_)) : "")
 #define Row_compareByParent(r1_, r2_)  (As_Row(r1_)->compareByParent ? (As_Row(r1_)->compareByParent(r1_, r2_)) : Row_compareByParent_Base(r1_, r2_))
+#define Row_sortKeyValue(r_, f_, k_)  (As_Row(r_)->sortKeyValue ? (As_Row(r_)->sortKeyValue(r_, f_, k_)) : false)
+#define Row_subtreeReset(r_)  (As_Row(r_)->subtreeReset ? (As_Row(r_)->subtreeReset(r_)) : (void)0)
+#define Row_subtreeAdd(p_, c_)  (As_Row(p_)->subtreeAdd ? (As_Row(p_)->subtreeAdd(p_, c_)) : (void)0)
 
 #define ONE_K 1024UL
 #define ONE_M (ONE_K * ONE_K)
@@ -179,4 +196,25 @@ static inline bool Row_isChildOf(const Row* this, int id) {
 
 int Row_compareByParent_Base(const void* v1, const void* v2);
 
+/* Order-preserving mappings of numeric column values onto sort keys */
+static inline uint64_t Row_sortKeyUnsigned(unsigned long long value) {
+   return value;
+}
+
+static inline uint64_t Row_sortKeySigned(long long value) {
+   return (uint64_t)value ^ (UINT64_C(1) << 63);
+}
+
+/* NaN sorts below every number, matching compareRealNumbers() */
+static inline uint64_t Row_sortKeyReal(double value) {
+   if (isNaN(value))
+      return 0;
+
+   value += 0.0;  /* fold -0.0 onto +0.0 */
+
+   uint64_t bits;
+   memcpy(&bits, &value, sizeof(bits));
+   return (bits & (UINT64_C(1) << 63)) ? ~bits : bits | (UINT64_C(1) << 63);
+}
+
 #endif
@@ -20,8 +20,10 @@ in the source distribution for its full text.
 #include "Machine.h"
 #include "Macros.h"
 #include "Object.h"
+#include "OverheadBudget.h"
 #include "Platform.h"
 #include "Process.h"
+#include "Profiler.h"
 #include "ProvideCurses.h"
 #include "Settings.h"
 #include "Table.h"
@@ -125,7 +127,7 @@ static void checkRecalculation(ScreenManager* this, double* oldTime, int* sortTi
    Platform_gettime_realtime(&host->realtime, &host->realtimeMs);
    double newTime = ((double)host->realtime.tv_sec * 10) + ((double)host->realtime.tv_nsec / 100000000L);
 
-   *timedOut = (newTime - *oldTime > host->settings->delay);
+   *timedOut = (newTime - *oldTime > OverheadBudget_delay(&host->budget, host->settings));
    *rescan |= *timedOut;
 
    if (newTime < *oldTime) {
@@ -143,14 +145,25 @@ static void checkRecalculation(ScreenManager* this, double* oldTime, int* sortTi
       int oldUidDigits = Process_uidDigits;
       int oldPidDigits = Process_pidDigits;
 
+      Profiler_cycle();
+
       // sample current values for system metrics and processes if not paused
+      PROFILER_BEGIN(scanPhase, "Machine_scan", true);
       Machine_scan(host);
-      if (!this->state->pauseUpdate)
+      PROFILER_END(scanPhase);
+      if (!this->state->pauseUpdate) {
+         PROFILER_BEGIN(tablesPhase, "Machine_scanTables", true);
          Machine_scanTables(host);
+         PROFILER_END(tablesPhase);
+      }
       this->state->failedUpdate = Platform_getFailedState();
 
       // always update header, especially to avoid gaps in graph meters
+      PROFILER_BEGIN(headerDataPhase, "Header_updateData", true);
       Header_updateData(this->header);
+      PROFILER_END(headerDataPhase);
+
+      OverheadBudget_update(&host->budget, host->settings);
 
       // force redraw if the number of UID/PID digits changed
       if (Process_uidDigits != oldUidDigits || Process_pidDigits != oldPidDigits)
@@ -160,9 +173,14 @@ static void checkRecalculation(ScreenManager* this, double* oldTime, int* sortTi
    }
 
    if (*redraw) {
+      PROFILER_BEGIN(rebuildPhase, "Table_rebuildPanel", false);
       Table_rebuildPanel(host->activeTable);
-      if (!this->state->hideMeters)
+      PROFILER_END(rebuildPhase);
+      if (!this->state->hideMeters) {
+         PROFILER_BEGIN(headerDrawPhase, "Header_draw", false);
          Header_draw(this->header);
+         PROFILER_END(headerDrawPhase);
+      }
    }
 
    *rescan = false;
@@ -226,6 +244,7 @@ static void ScreenManager_drawPanels(ScreenManager* this, size_t focus, bool for
    if (settings->screenTabs) {
       ScreenManager_drawScreenTabs(this);
    }
+   PROFILER_BEGIN(drawPhase, "Panel_draw", false);
    const size_t nPanels = this->panelCount;
    for (size_t i = 0; i < nPanels; i++) {
       Panel* panel = (Panel*) Vector_get(this->panels, i);
@@ -236,6 +255,7 @@ static void ScreenManager_drawPanels(ScreenManager* this, size_t focus, bool for
                  State_hideFunctionBar(this->state));
       mvvline(panel->y, panel->x + panel->w, ' ', panel->h + (State_hideFunctionBar(this->state) ? 1 : 0));
    }
+   PROFILER_END(drawPhase);
 }
 
 void ScreenManager_run(ScreenManager* this, Panel** lastFocus, int* lastKey, const char* name) {
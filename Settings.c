@@ -527,6 +527,8 @@ static bool Settings_read(Settings* this, const char* fileName, const Machine* h
          this->accountGuestInCPUMeter = atoi(option[1]);
       } else if (String_eq(option[0], "delay")) {
          this->delay = CLAMP(atoi(option[1]), 1, 255);
+      } else if (String_eq(option[0], "overhead_budget")) {
+         this->overheadBudget = CLAMP(atoi(option[1]), 0, 100);
       } else if (String_eq(option[0], "color_scheme")) {
          this->colorScheme = atoi(option[1]);
          if (this->colorScheme < 0 || this->colorScheme >= LAST_COLORSCHEME) {
@@ -578,6 +580,12 @@ static bool Settings_read(Settings* this, const char* fileName, const Machine* h
       } else if (String_eq(option[0], "topology_affinity")) {
          this->topologyAffinity = !!atoi(option[1]);
       #endif
+      #ifdef HAVE_BACKTRACE_SCREEN
+      } else if (String_eq(option[0], "backtrace_sample_rate")) {
+         this->backtraceSampleRate = CLAMP(atoi(option[1]), 1, 1000);
+      } else if (String_eq(option[0], "backtrace_sample_seconds")) {
+         this->backtraceSampleSeconds = CLAMP(atoi(option[1]), 1, 60);
+      #endif
       } else if (String_startsWith(option[0], "screen:")) {
          screen = Settings_newScreen(this, &(const ScreenDefaults) { .name = option[0] + 7, .columns = option[1] });
       } else if (String_eq(option[0], ".sort_key")) {
@@ -840,10 +848,15 @@ int Settings_write(const Settings* this, bool onCrash) {
    printSettingInteger("enable_mouse", this->enableMouse);
    #endif
    printSettingInteger("delay", (int) this->delay);
+   printSettingInteger("overhead_budget", this->overheadBudget);
    printSettingInteger("hide_function_bar", (int) this->hideFunctionBar);
    #ifdef HAVE_LIBHWLOC
    printSettingInteger("topology_affinity", this->topologyAffinity);
    #endif
+   #ifdef HAVE_BACKTRACE_SCREEN
+   printSettingInteger("backtrace_sample_rate", this->backtraceSampleRate);
+   printSettingInteger("backtrace_sample_seconds", this->backtraceSampleSeconds);
+   #endif
 
    printSettingString("header_layout", HeaderLayout_getName(this->hLayout));
    for (unsigned int i = 0; i < HeaderLayout_getColumns(this->hLayout); i++) {
@@ -954,6 +967,10 @@ Settings* Settings_new(const Machine* host, Hashtable* dynamicMeters, Hashtable*
    #ifdef HAVE_LIBHWLOC
    this->topologyAffinity = false;
    #endif
+   #ifdef HAVE_BACKTRACE_SCREEN
+   this->backtraceSampleRate = 20;
+   this->backtraceSampleSeconds = 5;
+   #endif
 
    this->screens = xCalloc(Platform_numberOfDefaultScreens, sizeof(ScreenSettings*));
    this->nScreens = 0;
@@ -998,6 +1015,7 @@ Settings* Settings_new(const Machine* host, Hashtable* dynamicMeters, Hashtable*
 #endif
    this->changed = false;
    this->delay = DEFAULT_DELAY;
+   this->overheadBudget = 0;
 
    bool ok = Settings_read(this, this->filename, host, /*checkWritability*/true);
    if (!ok && legacyDotfile) {
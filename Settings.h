@@ -73,6 +73,7 @@ typedef struct Settings_ {
 
    int colorScheme;
    int delay;
+   int overheadBudget;  /* maximum CPU% htop itself may use, 0 - unlimited */
 
    bool countCPUsFromOne;
    bool detailedCPUTime;
@@ -112,6 +113,10 @@ typedef struct Settings_ {
    #ifdef HAVE_LIBHWLOC
    bool topologyAffinity;
    #endif
+   #ifdef HAVE_BACKTRACE_SCREEN
+   int backtraceSampleRate;     /* stack samples per second in the backtrace profiler */
+   int backtraceSampleSeconds;  /* duration of one profiling run */
+   #endif
 
    bool changed;
    uint64_t lastUpdate;
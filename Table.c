@@ -19,15 +19,19 @@ in the source distribution for its full text.
 #include "Machine.h"
 #include "Macros.h"
 #include "Panel.h"
+#include "Profiler.h"
 #include "Row.h"
 #include "RowField.h"
 #include "Vector.h"
+#include "XUtils.h"
 
 
 Table* Table_init(Table* this, const ObjectClass* klass, Machine* host) {
    this->rows = Vector_new(klass, true, VECTOR_DEFAULT_SIZE);
    this->displayList = Vector_new(klass, false, VECTOR_DEFAULT_SIZE);
    this->table = Hashtable_new(200, false);
+   this->sortEntries = NULL;
+   this->sortEntriesSize = 0;
    this->needsSort = true;
    this->following = -1;
    this->stableId = -1;
@@ -37,6 +41,7 @@ Table* Table_init(Table* this, const ObjectClass* klass, Machine* host) {
 }
 
 void Table_done(Table* this) {
+   free(this->sortEntries);
    Hashtable_delete(this->table);
    Vector_delete(this->displayList);
    Vector_delete(this->rows);
@@ -101,7 +106,81 @@ static void Table_removeIndex(Table* this, const Row* row, int idx) {
    assert(Vector_countEquals(this->rows, Hashtable_count(this->table)));
 }
 
-static void Table_buildTreeBranch(Table* this, int rowid, unsigned int level, int32_t indent, bool show) {
+static inline int compareSortEntries(const TableSortEntry* e1, const TableSortEntry* e2) {
+   int result = SPACESHIP_NUMBER(e1->parent, e2->parent);
+   if (result)
+      return result;
+
+   result = SPACESHIP_NUMBER(e1->key, e2->key);
+   if (result)
+      return result;
+
+   return SPACESHIP_NUMBER(e1->id, e2->id);
+}
+
+static int compareSortEntriesQsort(const void* v1, const void* v2) {
+   return compareSortEntries((const TableSortEntry*) v1, (const TableSortEntry*) v2);
+}
+
+// Sorts the rows by the active sort key using the dense key array.
+// Returns false (leaving the rows untouched) if the rows cannot provide
+// a numeric key for the column, in which case the caller has to fall
+// back to the row comparators.
+static bool Table_sortByDenseKeys(Table* this, bool byParent) {
+   const ScreenSettings* ss = this->host->settings->ss;
+   const RowField key = ScreenSettings_getActiveSortKey(ss);
+   const bool descending = ScreenSettings_getActiveDirection(ss) != 1;
+
+   int size = Vector_size(this->rows);
+   if (size < 2)
+      return true;
+
+   if ((size_t)size > this->sortEntriesSize) {
+      this->sortEntries = xReallocArray(this->sortEntries, size, sizeof(TableSortEntry));
+      this->sortEntriesSize = size;
+   }
+
+   TableSortEntry* entries = this->sortEntries;
+   for (int i = 0; i < size; i++) {
+      Row* row = (Row*) Vector_get(this->rows, i);
+      TableSortEntry* entry = &entries[i];
+
+      if (!Row_sortKeyValue(row, key, &entry->key))
+         return false;
+
+      if (descending)
+         entry->key = ~entry->key;
+
+      entry->parent = byParent ? (row->isRoot ? 0 : Row_getGroupOrParent(row)) : 0;
+      entry->id = row->id;
+      entry->row = row;
+   }
+
+   if (byParent) {
+      qsort(entries, size, sizeof(TableSortEntry), compareSortEntriesQsort);
+   } else {
+      // the rows are mostly in order from the previous cycle
+      for (int i = 1; i < size; i++) {
+         TableSortEntry t = entries[i];
+         int j = i - 1;
+         while (j >= 0 && compareSortEntries(&entries[j], &t) > 0) {
+            entries[j + 1] = entries[j];
+            j--;
+         }
+         entries[j + 1] = t;
+      }
+   }
+
+   Object** array = this->rows->array;
+   for (int i = 0; i < size; i++)
+      array[i] = (Object*) entries[i].row;
+
+   return true;
+}
+
+static void Table_buildTreeBranch(Table* this, Row* branch, unsigned int level, int32_t indent, bool show) {
+   int rowid = branch->id;
+
    // Do not treat zero as root of any tree.
    // (e.g. on OpenBSD the kernel thread 'swapper' has pid 0.)
    if (rowid == 0)
@@ -140,8 +219,12 @@ static void Table_buildTreeBranch(Table* this, int rowid, unsigned int level, in
 
       Vector_add(this->displayList, row);
 
+      // Totals are built bottom-up: the children add themselves to this row first
+      Row_subtreeReset(row);
+
       int32_t nextIndent = indent | ((int32_t)1 << MINIMUM(level, sizeof(row->indent) * 8 - 2));
-      Table_buildTreeBranch(this, row->id, level + 1, (i < lastShown) ? nextIndent : indent, row->show && row->showChildren);
+      Table_buildTreeBranch(this, row, level + 1, (i < lastShown) ? nextIndent : indent, row->show && row->showChildren);
+      Row_subtreeAdd(branch, row);
       if (i == lastShown)
          row->indent = -nextIndent;
       else
@@ -182,7 +265,8 @@ static void Table_buildTree(Table* this) {
    }
 
    // Sort by known parent (roots first), then row ID
-   Vector_quickSortCustomCompare(this->rows, compareRowByKnownParentThenNatural);
+   if (!Table_sortByDenseKeys(this, true))
+      Vector_quickSortCustomCompare(this->rows, compareRowByKnownParentThenNatural);
 
    // Find all processes whose parent is not visible
    for (int i = 0; i < vsize; i++) {
@@ -194,7 +278,8 @@ static void Table_buildTree(Table* this) {
          row->indent = 0;
          row->tree_depth = 0;
          Vector_add(this->displayList, row);
-         Table_buildTreeBranch(this, row->id, 0, 0, row->showChildren);
+         Row_subtreeReset(row);
+         Table_buildTreeBranch(this, row, 0, 0, row->showChildren);
          continue;
       }
    }
@@ -209,11 +294,18 @@ void Table_updateDisplayList(Table* this) {
    const Settings* settings = this->host->settings;
 
    if (settings->ss->treeView) {
-      if (this->needsSort)
+      if (this->needsSort) {
+         PROFILER_BEGIN(treePhase, "Table_buildTree", false);
          Table_buildTree(this);
+         PROFILER_END(treePhase);
+      }
    } else {
-      if (this->needsSort)
-         Vector_insertionSort(this->rows);
+      if (this->needsSort) {
+         PROFILER_BEGIN(sortPhase, "Table_sort", false);
+         if (!Table_sortByDenseKeys(this, false))
+            Vector_insertionSort(this->rows);
+         PROFILER_END(sortPhase);
+      }
       Vector_prune(this->displayList);
       int size = Vector_size(this->rows);
       for (int i = 0; i < size; i++)
@@ -9,6 +9,8 @@ in the source distribution for its full text.
 */
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
 #include "Hashtable.h"
 #include "Object.h"
@@ -21,6 +23,15 @@ struct Machine_;  // IWYU pragma: keep
 struct Panel_;    // IWYU pragma: keep
 struct Row_;      // IWYU pragma: keep
 
+/* Hot sort state of one row, kept in a dense array so that sorting
+ * compares contiguous memory instead of dereferencing every row */
+typedef struct TableSortEntry_ {
+   uint64_t key;          /* encoded sort column value (see Row_sortKeyValue) */
+   int parent;            /* known parent when sorting for the tree view, else 0 */
+   int id;
+   struct Row_* row;
+} TableSortEntry;
+
 typedef struct Table_ {
    /* Super object for emulated OOP */
    Object super;
@@ -30,6 +41,9 @@ typedef struct Table_ {
                              updated in Table_updateDisplayList when rebuilding panel */
    Hashtable* table;      /* fast known row lookup by identifier */
 
+   TableSortEntry* sortEntries;  /* parallel to rows while sorting */
+   size_t sortEntriesSize;
+
    struct Machine_* host;
    const char* incFilter;
    bool needsSort;
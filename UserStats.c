@@ -0,0 +1,116 @@
+/*
+htop - UserStats.c
+(C) 2026 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "UserStats.h"
+
+#include <assert.h>
+#include <stdlib.h>
+
+#include "Macros.h"
+#include "Process.h"
+#include "XUtils.h"
+
+
+static unsigned int UserStats_lastGeneration;
+
+UserStats* UserStats_new(void) {
+   UserStats* this = xMalloc(sizeof(UserStats));
+   this->users = Hashtable_new(64, true);
+   this->count = 0;
+   this->generation = ++UserStats_lastGeneration;
+   return this;
+}
+
+void UserStats_delete(UserStats* this) {
+   if (!this)
+      return;
+
+   Hashtable_delete(this->users);
+   free(this);
+}
+
+void UserStats_withdraw(UserStats* this, Process* proc) {
+   UserStatsShare* share = &proc->userShare;
+   if (share->generation != this->generation || !share->entry)
+      return;
+
+   UserStatsEntry* entry = share->entry;
+   entry->threads -= share->threads;
+   entry->cpuPercent -= share->cpuPercent;
+   entry->residentKiB -= share->residentKiB;
+   entry->ioRate -= share->ioRate;
+
+   assert(entry->processes > 0);
+   if (--entry->processes == 0) {
+      Hashtable_remove(this->users, entry->uid);
+      this->count--;
+   }
+
+   *share = (UserStatsShare) { .generation = this->generation };
+}
+
+void UserStats_account(UserStats* this, Process* proc, double ioRate) {
+   UserStatsShare* share = &proc->userShare;
+   if (share->generation != this->generation)
+      *share = (UserStatsShare) { .generation = this->generation };
+
+   /* the process changed its owner */
+   if (share->entry && share->entry->uid != proc->st_uid)
+      UserStats_withdraw(this, proc);
+
+   UserStatsEntry* entry = share->entry;
+   if (!entry) {
+      entry = Hashtable_get(this->users, proc->st_uid);
+      if (!entry) {
+         entry = xCalloc(1, sizeof(UserStatsEntry));
+         entry->uid = proc->st_uid;
+         Hashtable_put(this->users, proc->st_uid, entry);
+         this->count++;
+      }
+      entry->processes++;
+      share->entry = entry;
+   }
+
+   long int threads = MAXIMUM(proc->nlwp, 1);
+   double cpuPercent = isNonnegative(proc->percent_cpu) ? proc->percent_cpu : 0.0;
+   long int residentKiB = MAXIMUM(proc->m_resident, 0);
+   ioRate = isNonnegative(ioRate) ? ioRate : 0.0;
+
+   entry->threads += threads - share->threads;
+   entry->cpuPercent += cpuPercent - share->cpuPercent;
+   entry->residentKiB += residentKiB - share->residentKiB;
+   entry->ioRate += ioRate - share->ioRate;
+
+   share->threads = threads;
+   share->cpuPercent = cpuPercent;
+   share->residentKiB = residentKiB;
+   share->ioRate = ioRate;
+}
+
+typedef struct UserStatsCollector_ {
+   const UserStatsEntry** entries;
+   size_t count;
+} UserStatsCollector;
+
+static void UserStats_collect(ATTR_UNUSED ht_key_t key, void* value, void* userData) {
+   UserStatsCollector* collector = userData;
+   collector->entries[collector->count++] = value;
+}
+
+const UserStatsEntry** UserStats_getEntries(UserStats* this, size_t* count) {
+   UserStatsCollector collector = {
+      .entries = xMallocArray(MAXIMUM(this->count, 1), sizeof(UserStatsEntry*)),
+      .count = 0,
+   };
+   Hashtable_foreach(this->users, UserStats_collect, &collector);
+
+   assert(collector.count == this->count);
+   *count = collector.count;
+   return collector.entries;
+}
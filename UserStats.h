@@ -0,0 +1,61 @@
+#ifndef HEADER_UserStats
+#define HEADER_UserStats
+/*
+htop - UserStats.h
+(C) 2026 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stddef.h>
+#include <sys/types.h>
+
+#include "Hashtable.h"
+
+
+typedef struct UserStatsEntry_ {
+   uid_t uid;
+   unsigned int processes;
+   long long int threads;
+   double cpuPercent;
+   long long int residentKiB;
+   double ioRate;             /* bytes per second, of the processes reporting it */
+} UserStatsEntry;
+
+/* What one process currently contributes to the totals of its user */
+typedef struct UserStatsShare_ {
+   UserStatsEntry* entry;
+   unsigned int generation;   /* shares from an older table count as nothing */
+   long int threads;
+   double cpuPercent;
+   long int residentKiB;
+   double ioRate;
+} UserStatsShare;
+
+/*
+ * Resource usage summed per user. Each process adds the difference to
+ * its previous share when it is updated and withdraws its share when it
+ * exits, so the totals are never recomputed from all processes.
+ */
+typedef struct UserStats_ {
+   Hashtable* users;          /* uid -> UserStatsEntry */
+   size_t count;
+   unsigned int generation;
+} UserStats;
+
+struct Process_;
+
+UserStats* UserStats_new(void);
+
+void UserStats_delete(UserStats* this);
+
+/* Updates the totals of the owner of a process from its current values */
+void UserStats_account(UserStats* this, struct Process_* proc, double ioRate);
+
+/* Withdraws the share of a process, e.g. once it has exited */
+void UserStats_withdraw(UserStats* this, struct Process_* proc);
+
+/* Returns all entries in no particular order; the caller frees the array */
+const UserStatsEntry** UserStats_getEntries(UserStats* this, size_t* count);
+
+#endif
@@ -0,0 +1,173 @@
+/*
+htop - UserStatsScreen.c
+(C) 2026 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "UserStatsScreen.h"
+
+#include <stdlib.h>
+
+#include "FunctionBar.h"
+#include "Macros.h"
+#include "Meter.h"
+#include "Panel.h"
+#include "ProvideCurses.h"
+#include "UserStats.h"
+#include "UsersTable.h"
+#include "Vector.h"
+#include "XUtils.h"
+
+
+static const char* const UserStatsScreenFunctions[] = {"Search ", "Filter ", "Refresh", "Sort: CPU    ", "Done   ", NULL};
+
+static const char* const UserStatsScreenKeys[] = {"F3", "F4", "F5", "F6", "Esc"};
+
+static const int UserStatsScreenEvents[] = {KEY_F(3), KEY_F(4), KEY_F(5), KEY_F(6), 27};
+
+static const char* const UserStatsScreen_sortLabels[LAST_USERSTATS_SORT] = {
+   [USERSTATS_SORT_CPU]     = "Sort: CPU    ",
+   [USERSTATS_SORT_MEMORY]  = "Sort: Memory ",
+   [USERSTATS_SORT_IO]      = "Sort: IO     ",
+   [USERSTATS_SORT_THREADS] = "Sort: Threads",
+};
+
+UserStatsScreen* UserStatsScreen_new(Machine* host, bool paused) {
+   UserStatsScreen* this = xMalloc(sizeof(UserStatsScreen));
+   Object_setClass(this, Class(UserStatsScreen));
+   this->host = host;
+   this->processes = (ProcessTable*) host->processTable;
+   this->paused = paused;
+   this->sort = USERSTATS_SORT_CPU;
+
+   /* totals are only kept up to date while someone looks at them */
+   ProcessTable_enableUserStats(this->processes);
+
+   FunctionBar* bar = FunctionBar_new(UserStatsScreenFunctions, UserStatsScreenKeys, UserStatsScreenEvents);
+   return (UserStatsScreen*) InfoScreen_init(&this->super, NULL, bar, LINES - 2, "USER              PROCS  THREADS   CPU%    RES     IO/s");
+}
+
+void UserStatsScreen_delete(Object* cast) {
+   UserStatsScreen* this = (UserStatsScreen*) cast;
+   ProcessTable_disableUserStats(this->processes);
+   free(InfoScreen_done((InfoScreen*)this));
+}
+
+static void UserStatsScreen_draw(InfoScreen* this) {
+   InfoScreen_drawTitled(this, "Resource usage per user");
+}
+
+static double UserStatsEntry_sortValue(const UserStatsEntry* entry, UserStatsSort sort) {
+   switch (sort) {
+      case USERSTATS_SORT_MEMORY:
+         return (double)entry->residentKiB;
+      case USERSTATS_SORT_IO:
+         return entry->ioRate;
+      case USERSTATS_SORT_THREADS:
+         return (double)entry->threads;
+      default:
+         return entry->cpuPercent;
+   }
+}
+
+typedef struct UserStatsSortEntry_ {
+   double value;
+   const UserStatsEntry* entry;
+} UserStatsSortEntry;
+
+static int UserStatsScreen_compareEntries(const void* a, const void* b) {
+   const UserStatsSortEntry* ea = a;
+   const UserStatsSortEntry* eb = b;
+   if (ea->value > eb->value)
+      return -1;
+   if (ea->value < eb->value)
+      return 1;
+   return SPACESHIP_NUMBER(ea->entry->uid, eb->entry->uid);
+}
+
+static void UserStatsScreen_list(UserStatsScreen* this) {
+   InfoScreen* super = &this->super;
+   Panel* panel = super->display;
+   int idx = MAXIMUM(Panel_getSelectedIndex(panel), 0);
+
+   Panel_prune(panel);
+
+   size_t count;
+   const UserStatsEntry** entries = UserStats_getEntries(this->processes->userStats, &count);
+
+   UserStatsSortEntry* sorted = xMallocArray(MAXIMUM(count, 1), sizeof(UserStatsSortEntry));
+   for (size_t i = 0; i < count; i++)
+      sorted[i] = (UserStatsSortEntry) { .value = UserStatsEntry_sortValue(entries[i], this->sort), .entry = entries[i] };
+   qsort(sorted, count, sizeof(UserStatsSortEntry), UserStatsScreen_compareEntries);
+
+   for (size_t i = 0; i < count; i++) {
+      const UserStatsEntry* entry = sorted[i].entry;
+
+      /* the running sums may drift slightly below zero */
+      char resident[8];
+      char ioRate[8];
+      Meter_humanUnit(resident, (double)MAXIMUM(entry->residentKiB, 0), sizeof(resident));
+      Meter_humanUnit(ioRate, MAXIMUM(entry->ioRate, 0.0) / ONE_K, sizeof(ioRate));
+
+      char line[128];
+      xSnprintf(line, sizeof(line), "%-16.16s %6u %8lld %6.1f %6s %8s",
+         UsersTable_getRef(this->host->usersTable, entry->uid),
+         entry->processes,
+         entry->threads,
+         MAXIMUM(entry->cpuPercent, 0.0),
+         resident,
+         ioRate);
+      InfoScreen_addLine(super, line);
+   }
+
+   free(sorted);
+   free(entries);
+
+   if (!count)
+      InfoScreen_addLine(super, "No processes found.");
+
+   Panel_setSelected(panel, idx);
+}
+
+static void UserStatsScreen_scan(InfoScreen* super) {
+   UserStatsScreen* this = (UserStatsScreen*) super;
+   Machine_rescan(this->host, !this->paused);
+   UserStatsScreen_list(this);
+}
+
+static void UserStatsScreen_refresh(InfoScreen* this) {
+   Vector_prune(this->lines);
+   UserStatsScreen_scan(this);
+   InfoScreen_draw(this);
+}
+
+static bool UserStatsScreen_onKey(InfoScreen* super, int ch) {
+   UserStatsScreen* this = (UserStatsScreen*) super;
+
+   switch (ch) {
+      case 's':
+      case KEY_F(6):
+         this->sort = (this->sort + 1) % LAST_USERSTATS_SORT;
+         FunctionBar_setLabel(super->display->defaultBar, KEY_F(6), UserStatsScreen_sortLabels[this->sort]);
+         Vector_prune(super->lines);
+         UserStatsScreen_list(this);
+         InfoScreen_draw(this);
+         return true;
+   }
+
+   return false;
+}
+
+const InfoScreenClass UserStatsScreen_class = {
+   .super = {
+      .extends = Class(Object),
+      .delete = UserStatsScreen_delete
+   },
+   .scan = UserStatsScreen_scan,
+   .draw = UserStatsScreen_draw,
+   .onErr = UserStatsScreen_refresh,
+   .onKey = UserStatsScreen_onKey
+};
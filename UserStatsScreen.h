@@ -0,0 +1,40 @@
+#ifndef HEADER_UserStatsScreen
+#define HEADER_UserStatsScreen
+/*
+htop - UserStatsScreen.h
+(C) 2026 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+
+#include "InfoScreen.h"
+#include "Machine.h"
+#include "Object.h"
+#include "ProcessTable.h"
+
+
+typedef enum UserStatsSort_ {
+   USERSTATS_SORT_CPU,
+   USERSTATS_SORT_MEMORY,
+   USERSTATS_SORT_IO,
+   USERSTATS_SORT_THREADS,
+   LAST_USERSTATS_SORT
+} UserStatsSort;
+
+typedef struct UserStatsScreen_ {
+   InfoScreen super;
+   Machine* host;
+   ProcessTable* processes;
+   bool paused;
+   UserStatsSort sort;
+} UserStatsScreen;
+
+extern const InfoScreenClass UserStatsScreen_class;
+
+UserStatsScreen* UserStatsScreen_new(Machine* host, bool paused);
+
+void UserStatsScreen_delete(Object* this);
+
+#endif
@@ -9,43 +9,315 @@ in the source distribution for its full text.
 
 #include "UsersTable.h"
 
+#include <errno.h>
+#include <pthread.h>
 #include <pwd.h>
+#include <signal.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
 
 #include "XUtils.h"
 
 
+/*
+ * Name lookups go through NSS, which may sit on top of LDAP or SSSD and
+ * block for a long time. They are therefore done on a helper thread: the
+ * scan only queues unknown IDs and picks up the answers on a later cycle.
+ *
+ * The resolver state is shared between both threads and freed by whichever
+ * side lets go of it last, so that quitting htop never waits for a hanging
+ * lookup.
+ */
+
+typedef struct UsersTableResult_ {
+   unsigned int uid;
+   char* name;                       /* NULL if the ID is unknown */
+} UsersTableResult;
+
+typedef struct UsersTableResolver_ {
+   pthread_mutex_t lock;
+   pthread_cond_t wakeup;
+   pthread_t thread;
+   bool quit;
+   int refs;
+
+   unsigned int* requests;
+   size_t requestCount;
+   size_t requestSize;
+
+   UsersTableResult* results;
+   size_t resultCount;
+   size_t resultSize;
+} UsersTableResolver;
+
+static char* UsersTable_lookup(unsigned int uid) {
+   long size = sysconf(_SC_GETPW_R_SIZE_MAX);
+   if (size <= 0)
+      size = 1024;
+
+   for (;;) {
+      char* buffer = xMalloc((size_t)size);
+      struct passwd pwd;
+      struct passwd* found = NULL;
+
+      int err = getpwuid_r((uid_t)uid, &pwd, buffer, (size_t)size, &found);
+      if (err == ERANGE && size < 1024 * 1024) {
+         free(buffer);
+         size *= 2;
+         continue;
+      }
+
+      char* name = (err == 0 && found) ? xStrdup(found->pw_name) : NULL;
+      free(buffer);
+      return name;
+   }
+}
+
+static void UsersTableResolver_release(UsersTableResolver* this) {
+   pthread_mutex_lock(&this->lock);
+   bool last = --this->refs == 0;
+   pthread_mutex_unlock(&this->lock);
+
+   if (!last)
+      return;
+
+   for (size_t i = 0; i < this->resultCount; i++)
+      free(this->results[i].name);
+
+   free(this->results);
+   free(this->requests);
+   pthread_cond_destroy(&this->wakeup);
+   pthread_mutex_destroy(&this->lock);
+   free(this);
+}
+
+static void* UsersTableResolver_run(void* arg) {
+   UsersTableResolver* this = arg;
+
+   pthread_mutex_lock(&this->lock);
+   while (!this->quit) {
+      if (this->requestCount == 0) {
+         pthread_cond_wait(&this->wakeup, &this->lock);
+         continue;
+      }
+
+      unsigned int uid = this->requests[--this->requestCount];
+      pthread_mutex_unlock(&this->lock);
+
+      char* name = UsersTable_lookup(uid);
+
+      pthread_mutex_lock(&this->lock);
+      if (this->resultCount == this->resultSize) {
+         this->resultSize = this->resultSize ? this->resultSize * 2 : 16;
+         this->results = xReallocArray(this->results, this->resultSize, sizeof(UsersTableResult));
+      }
+      this->results[this->resultCount++] = (UsersTableResult) { .uid = uid, .name = name };
+   }
+   pthread_mutex_unlock(&this->lock);
+
+   UsersTableResolver_release(this);
+   return NULL;
+}
+
+static UsersTableResolver* UsersTableResolver_new(void) {
+   UsersTableResolver* this = xCalloc(1, sizeof(UsersTableResolver));
+   pthread_mutex_init(&this->lock, NULL);
+   pthread_cond_init(&this->wakeup, NULL);
+   this->refs = 2;
+
+   /* keep signal delivery on the main thread */
+   sigset_t all;
+   sigset_t old;
+   sigfillset(&all);
+   pthread_sigmask(SIG_BLOCK, &all, &old);
+   int err = pthread_create(&this->thread, NULL, UsersTableResolver_run, this);
+   pthread_sigmask(SIG_SETMASK, &old, NULL);
+
+   if (err != 0) {
+      pthread_cond_destroy(&this->wakeup);
+      pthread_mutex_destroy(&this->lock);
+      free(this);
+      return NULL;
+   }
+
+   pthread_detach(this->thread);
+   return this;
+}
+
 UsersTable* UsersTable_new(void) {
    UsersTable* this;
-   this = xMalloc(sizeof(UsersTable));
+   this = xCalloc(1, sizeof(UsersTable));
    this->users = Hashtable_new(10, true);
    return this;
 }
 
 void UsersTable_delete(UsersTable* this) {
+   if (this->resolver) {
+      pthread_mutex_lock(&this->resolver->lock);
+      this->resolver->quit = true;
+      pthread_cond_signal(&this->resolver->wakeup);
+      pthread_mutex_unlock(&this->resolver->lock);
+      UsersTableResolver_release(this->resolver);
+   }
+
    Hashtable_delete(this->users);
    free(this);
 }
 
-char* UsersTable_getRef(UsersTable* this, unsigned int uid) {
-   char* name = Hashtable_get(this->users, uid);
-   if (name == NULL) {
-      const struct passwd* userData = getpwuid(uid);
-      if (userData != NULL) {
-         name = xStrdup(userData->pw_name);
+static void UsersTable_setName(UsersTableEntry* entry, const char* name) {
+   String_safeStrncpy(entry->name, name, sizeof(entry->name));
+   entry->resolved = true;
+   entry->pending = false;
+}
+
+void UsersTable_preload(UsersTable* this) {
+   FILE* fp = fopen("/etc/passwd", "r");
+   if (!fp)
+      return;
+
+   char* line;
+   while ((line = String_readLine(fp))) {
+      /* name:password:uid:... */
+      char* sep = strchr(line, ':');
+      char* uidField = sep ? strchr(sep + 1, ':') : NULL;
+      if (!uidField || sep == line || line[0] == '+' || line[0] == '-' || line[0] == '#') {
+         free(line);
+         continue;
+      }
+
+      *sep = '\0';
+      char* end;
+      unsigned long uid = strtoul(uidField + 1, &end, 10);
+      if (end != uidField + 1 && *end == ':' && uid <= (unsigned int)-1 && !Hashtable_get(this->users, (ht_key_t)uid)) {
+         UsersTableEntry* entry = xCalloc(1, sizeof(UsersTableEntry));
+         UsersTable_setName(entry, line);
+         Hashtable_put(this->users, (ht_key_t)uid, entry);
+      }
+
+      free(line);
+   }
+
+   fclose(fp);
+}
+
+static void UsersTable_markUnresolved(UsersTable* this, UsersTableEntry* entry) {
+   entry->pending = false;
+   entry->retryMs = this->monotonicMs + USERSTABLE_NEGATIVE_TTL_MS;
+   if (this->unresolved == 0 || entry->retryMs < this->nextRetryMs)
+      this->nextRetryMs = entry->retryMs;
+   this->unresolved++;
+}
+
+static void UsersTable_request(UsersTable* this, unsigned int uid, UsersTableEntry* entry) {
+   if (!this->resolver)
+      this->resolver = UsersTableResolver_new();
+
+   if (!this->resolver) {
+      /* no helper thread available, resolve synchronously */
+      char* name = UsersTable_lookup(uid);
+      if (name) {
+         UsersTable_setName(entry, name);
+         free(name);
       } else {
-         name = xStrdup("");
+         UsersTable_markUnresolved(this, entry);
       }
-      Hashtable_put(this->users, uid, name);
+      return;
    }
-   if (!name || !*name) {
-      return NULL;
+
+   UsersTableResolver* resolver = this->resolver;
+   pthread_mutex_lock(&resolver->lock);
+   if (resolver->requestCount == resolver->requestSize) {
+      resolver->requestSize = resolver->requestSize ? resolver->requestSize * 2 : 16;
+      resolver->requests = xReallocArray(resolver->requests, resolver->requestSize, sizeof(unsigned int));
    }
-   return name;
+   resolver->requests[resolver->requestCount++] = uid;
+   pthread_cond_signal(&resolver->wakeup);
+   pthread_mutex_unlock(&resolver->lock);
+
+   entry->pending = true;
+}
+
+char* UsersTable_getRef(UsersTable* this, unsigned int uid) {
+   UsersTableEntry* entry = Hashtable_get(this->users, uid);
+   if (entry == NULL) {
+      entry = xCalloc(1, sizeof(UsersTableEntry));
+      xSnprintf(entry->name, sizeof(entry->name), "%u", uid);
+      Hashtable_put(this->users, uid, entry);
+      UsersTable_request(this, uid, entry);
+   }
+   return entry->name;
+}
+
+typedef struct UsersTableRetry_ {
+   UsersTable* table;
+   uint64_t nextRetryMs;
+} UsersTableRetry;
+
+static void UsersTable_retryExpired(ht_key_t key, void* value, void* userData) {
+   UsersTableEntry* entry = value;
+   UsersTableRetry* retry = userData;
+   UsersTable* this = retry->table;
+
+   if (entry->resolved || entry->pending)
+      return;
+
+   if (entry->retryMs <= this->monotonicMs) {
+      this->unresolved--;
+      UsersTable_request(this, key, entry);
+   } else if (entry->retryMs < retry->nextRetryMs) {
+      retry->nextRetryMs = entry->retryMs;
+   }
+}
+
+void UsersTable_update(UsersTable* this, uint64_t monotonicMs) {
+   this->monotonicMs = monotonicMs;
+
+   UsersTableResolver* resolver = this->resolver;
+   if (resolver) {
+      pthread_mutex_lock(&resolver->lock);
+      UsersTableResult* results = resolver->results;
+      size_t resultCount = resolver->resultCount;
+      resolver->results = NULL;
+      resolver->resultCount = 0;
+      resolver->resultSize = 0;
+      pthread_mutex_unlock(&resolver->lock);
+
+      for (size_t i = 0; i < resultCount; i++) {
+         UsersTableEntry* entry = Hashtable_get(this->users, results[i].uid);
+         if (entry && !entry->resolved) {
+            if (results[i].name) {
+               UsersTable_setName(entry, results[i].name);
+            } else {
+               UsersTable_markUnresolved(this, entry);
+            }
+         }
+         free(results[i].name);
+      }
+      free(results);
+   }
+
+   if (this->unresolved > 0 && this->nextRetryMs <= monotonicMs) {
+      UsersTableRetry retry = { .table = this, .nextRetryMs = UINT64_MAX };
+      Hashtable_foreach(this->users, UsersTable_retryExpired, &retry);
+      this->nextRetryMs = retry.nextRetryMs;
+   }
+}
+
+typedef struct UsersTableForeach_ {
+   Hashtable_PairFunction f;
+   void* userData;
+} UsersTableForeach;
+
+static void UsersTable_foreachName(ht_key_t key, void* value, void* userData) {
+   UsersTableEntry* entry = value;
+   const UsersTableForeach* context = userData;
+   context->f(key, entry->name, context->userData);
 }
 
-inline void UsersTable_foreach(UsersTable* this, Hashtable_PairFunction f, void* userData) {
-   Hashtable_foreach(this->users, f, userData);
+void UsersTable_foreach(UsersTable* this, Hashtable_PairFunction f, void* userData) {
+   UsersTableForeach context = { .f = f, .userData = userData };
+   Hashtable_foreach(this->users, UsersTable_foreachName, &context);
 }
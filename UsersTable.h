@@ -7,19 +7,51 @@ Released under the GNU GPLv2+, see the COPYING file
 in the source distribution for its full text.
 */
 
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
 #include "Hashtable.h"
 
 
+/* Longer user names are truncated */
+#define USERSTABLE_NAME_MAX 64
+
+/* How long a failed lookup is remembered before asking NSS again */
+#define USERSTABLE_NEGATIVE_TTL_MS 60000
+
+typedef struct UsersTableEntry_ {
+   char name[USERSTABLE_NAME_MAX];   /* numeric ID until the name is resolved */
+   bool resolved;
+   bool pending;                     /* queued for the resolver thread */
+   uint64_t retryMs;                 /* next lookup of an unresolved ID */
+} UsersTableEntry;
+
+struct UsersTableResolver_;
+
 typedef struct UsersTable_ {
    Hashtable* users;
+   struct UsersTableResolver_* resolver;
+   uint64_t monotonicMs;
+   size_t unresolved;                /* entries waiting for their negative TTL to expire */
+   uint64_t nextRetryMs;
 } UsersTable;
 
 UsersTable* UsersTable_new(void);
 
 void UsersTable_delete(UsersTable* this);
 
+/* Fills the table from the local passwd file in one pass, without NSS */
+void UsersTable_preload(UsersTable* this);
+
+/* Returns a name that stays valid for the lifetime of the table. Unknown
+ * IDs are rendered numerically and resolved in the background; the string
+ * is updated in place once UsersTable_update() picks up the result. */
 char* UsersTable_getRef(UsersTable* this, unsigned int uid);
 
+/* Applies finished lookups and requeues expired negative entries */
+void UsersTable_update(UsersTable* this, uint64_t monotonicMs);
+
 void UsersTable_foreach(UsersTable* this, Hashtable_PairFunction f, void* userData);
 
 #endif
@@ -44,6 +44,7 @@ in the source distribution for its full text.
 #include "Macros.h"
 #include "MemoryMeter.h"
 #include "MemorySwapMeter.h"
+#include "OverheadMeter.h"
 #include "ProcessLocksScreen.h"
 #include "SwapMeter.h"
 #include "SysArchMeter.h"
@@ -168,6 +169,7 @@ const MeterClass* const Platform_meterTypes[] = {
    &DiskIOMeter_class,
    &NetworkIOMeter_class,
    &FileDescriptorMeter_class,
+   &OverheadMeter_class,
    &GPUMeter_class,
    &BlankMeter_class,
    NULL
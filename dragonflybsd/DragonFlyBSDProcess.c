@@ -114,6 +114,9 @@ const ProcessClass DragonFlyBSDProcess_class = {
       .isVisible = Process_rowIsVisible,
       .matchesFilter = Process_rowMatchesFilter,
       .compareByParent = Process_compareByParent,
+      .subtreeReset = Process_subtreeReset,
+      .subtreeAdd = Process_subtreeAdd,
+      .sortKeyValue = Process_rowSortKeyValue,
       .sortKeyString = Process_rowGetSortKey,
       .writeField = DragonFlyBSDProcess_rowWriteField
    },
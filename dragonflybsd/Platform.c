@@ -30,6 +30,7 @@ in the source distribution for its full text.
 #include "Macros.h"
 #include "MemoryMeter.h"
 #include "MemorySwapMeter.h"
+#include "OverheadMeter.h"
 #include "ProcessTable.h"
 #include "SwapMeter.h"
 #include "SysArchMeter.h"
@@ -142,6 +143,7 @@ const MeterClass* const Platform_meterTypes[] = {
    &DiskIOMeter_class,
    &NetworkIOMeter_class,
    &FileDescriptorMeter_class,
+   &OverheadMeter_class,
    &BlankMeter_class,
    NULL
 };
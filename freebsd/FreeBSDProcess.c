@@ -148,6 +148,9 @@ const ProcessClass FreeBSDProcess_class = {
       .isVisible = Process_rowIsVisible,
       .matchesFilter = Process_rowMatchesFilter,
       .compareByParent = Process_compareByParent,
+      .subtreeReset = Process_subtreeReset,
+      .subtreeAdd = Process_subtreeAdd,
+      .sortKeyValue = Process_rowSortKeyValue,
       .sortKeyString = Process_rowGetSortKey,
       .writeField = FreeBSDProcess_rowWriteField
    },
@@ -38,6 +38,7 @@ in the source distribution for its full text.
 #include "MemorySwapMeter.h"
 #include "Meter.h"
 #include "NetworkIOMeter.h"
+#include "OverheadMeter.h"
 #include "Settings.h"
 #include "SwapMeter.h"
 #include "SysArchMeter.h"
@@ -151,6 +152,7 @@ const MeterClass* const Platform_meterTypes[] = {
    &DiskIOTimeMeter_class,
    &DiskIOMeter_class,
    &FileDescriptorMeter_class,
+   &OverheadMeter_class,
    &NetworkIOMeter_class,
    NULL
 };
@@ -0,0 +1,140 @@
+/*
+htop - generic/SymbolCache.c
+(C) 2026 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "generic/SymbolCache.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "Object.h"
+#include "XUtils.h"
+
+
+#define SYMBOLCACHE_NONE SIZE_MAX
+
+SymbolCache* SymbolCache_new(size_t capacity) {
+   SymbolCache* this = xCalloc(1, sizeof(SymbolCache));
+   this->capacity = capacity ? capacity : 1;
+   this->entries = xCalloc(this->capacity, sizeof(SymbolCacheEntry));
+
+   this->bucketCount = 16;
+   while (this->bucketCount < this->capacity)
+      this->bucketCount *= 2;
+   this->buckets = xMallocArray(this->bucketCount, sizeof(size_t));
+   for (size_t i = 0; i < this->bucketCount; i++)
+      this->buckets[i] = SYMBOLCACHE_NONE;
+
+   this->lruHead = SYMBOLCACHE_NONE;
+   this->lruTail = SYMBOLCACHE_NONE;
+   return this;
+}
+
+void SymbolCache_delete(SymbolCache* this) {
+   if (!this)
+      return;
+
+   for (size_t i = 0; i < this->count; i++) {
+      free(this->entries[i].key);
+      BacktraceFrameData_delete((Object*)this->entries[i].frame);
+   }
+   free(this->entries);
+   free(this->buckets);
+   free(this);
+}
+
+/* FNV-1a over the key, mixed with the offset */
+static uint32_t SymbolCache_hash(const char* key, uint64_t offset) {
+   uint32_t hash = 2166136261U;
+   for (const unsigned char* p = (const unsigned char*)key; *p; p++)
+      hash = (hash ^ *p) * 16777619U;
+
+   hash ^= (uint32_t)offset ^ (uint32_t)(offset >> 32);
+   return hash * 2654435761U;
+}
+
+static void SymbolCache_unlink(SymbolCache* this, size_t index) {
+   SymbolCacheEntry* entry = &this->entries[index];
+
+   if (entry->lruPrev != SYMBOLCACHE_NONE)
+      this->entries[entry->lruPrev].lruNext = entry->lruNext;
+   else
+      this->lruHead = entry->lruNext;
+
+   if (entry->lruNext != SYMBOLCACHE_NONE)
+      this->entries[entry->lruNext].lruPrev = entry->lruPrev;
+   else
+      this->lruTail = entry->lruPrev;
+}
+
+static void SymbolCache_pushFront(SymbolCache* this, size_t index) {
+   SymbolCacheEntry* entry = &this->entries[index];
+   entry->lruPrev = SYMBOLCACHE_NONE;
+   entry->lruNext = this->lruHead;
+
+   if (this->lruHead != SYMBOLCACHE_NONE)
+      this->entries[this->lruHead].lruPrev = index;
+   else
+      this->lruTail = index;
+
+   this->lruHead = index;
+}
+
+const BacktraceFrameData* SymbolCache_get(SymbolCache* this, const char* key, uint64_t offset) {
+   uint32_t hash = SymbolCache_hash(key, offset);
+
+   for (size_t i = this->buckets[hash & (this->bucketCount - 1)]; i != SYMBOLCACHE_NONE; i = this->entries[i].hashNext) {
+      const SymbolCacheEntry* entry = &this->entries[i];
+      if (entry->hash != hash || entry->offset != offset || !String_eq(entry->key, key))
+         continue;
+
+      if (this->lruHead != i) {
+         SymbolCache_unlink(this, i);
+         SymbolCache_pushFront(this, i);
+      }
+      this->hits++;
+      return entry->frame;
+   }
+
+   this->misses++;
+   return NULL;
+}
+
+static void SymbolCache_removeFromBucket(SymbolCache* this, size_t index) {
+   size_t* link = &this->buckets[this->entries[index].hash & (this->bucketCount - 1)];
+   while (*link != index)
+      link = &this->entries[*link].hashNext;
+   *link = this->entries[index].hashNext;
+}
+
+void SymbolCache_put(SymbolCache* this, const char* key, uint64_t offset, BacktraceFrameData* frame) {
+   size_t index;
+
+   if (this->count < this->capacity) {
+      index = this->count++;
+   } else {
+      /* reuse the slot of the least recently used entry */
+      index = this->lruTail;
+      SymbolCache_unlink(this, index);
+      SymbolCache_removeFromBucket(this, index);
+      free(this->entries[index].key);
+      BacktraceFrameData_delete((Object*)this->entries[index].frame);
+   }
+
+   SymbolCacheEntry* entry = &this->entries[index];
+   entry->key = xStrdup(key);
+   entry->offset = offset;
+   entry->frame = frame;
+   entry->hash = SymbolCache_hash(key, offset);
+
+   size_t* bucket = &this->buckets[entry->hash & (this->bucketCount - 1)];
+   entry->hashNext = *bucket;
+   *bucket = index;
+
+   SymbolCache_pushFront(this, index);
+}
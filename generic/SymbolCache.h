@@ -0,0 +1,57 @@
+#ifndef HEADER_SymbolCache
+#define HEADER_SymbolCache
+/*
+htop - generic/SymbolCache.h
+(C) 2026 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "BacktraceScreen.h"
+
+
+/*
+ * Bounded cache of resolved frames, keyed by a string (an object path or a
+ * symbol name) and an offset within it. The least recently used entry is
+ * evicted when the cache is full.
+ */
+typedef struct SymbolCacheEntry_ {
+   char* key;
+   uint64_t offset;
+   BacktraceFrameData* frame;
+   uint32_t hash;
+
+   size_t hashNext;     /* next entry in the same bucket */
+   size_t lruPrev;      /* towards the most recently used entry */
+   size_t lruNext;      /* towards the least recently used entry */
+} SymbolCacheEntry;
+
+typedef struct SymbolCache_ {
+   SymbolCacheEntry* entries;
+   size_t count;
+   size_t capacity;
+
+   size_t* buckets;
+   size_t bucketCount;  /* a power of two */
+
+   size_t lruHead;
+   size_t lruTail;
+
+   size_t hits;
+   size_t misses;
+} SymbolCache;
+
+SymbolCache* SymbolCache_new(size_t capacity);
+
+void SymbolCache_delete(SymbolCache* this);
+
+/* Returns the cached frame and marks it as recently used, or NULL */
+const BacktraceFrameData* SymbolCache_get(SymbolCache* this, const char* key, uint64_t offset);
+
+/* Adds a frame, taking ownership of it; evicts the least recently used entry if full */
+void SymbolCache_put(SymbolCache* this, const char* key, uint64_t offset, BacktraceFrameData* frame);
+
+#endif
@@ -9,14 +9,29 @@ in the source distribution for its full text.
 
 #include "generic/UnwindPtrace.h"
 
+#include <dirent.h>
 #include <errno.h>
+#include <inttypes.h>
 #include <limits.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 #include <sys/ptrace.h>
 #include <sys/wait.h>
 
 #include "BacktraceScreen.h"
+#include "Macros.h"
 #include "XUtils.h"
+#include "generic/SymbolCache.h"
+
+#if defined(HTOP_LINUX)
+#include "generic/gettime.h"
+#include "linux/Compat.h"
+#endif
 
 #ifdef HAVE_LIBUNWIND_PTRACE
 #include <libunwind-ptrace.h>
@@ -40,6 +55,18 @@ static int ptraceAttach(pid_t pid) {
 # endif
 }
 
+static int ptraceDetachWithSignal(pid_t pid, int sig) {
+# if defined(HTOP_LINUX)
+   return !ptrace(PTRACE_DETACH, pid, (void*)0, (void*)(long)sig) ? 0 : errno;
+# elif defined(HTOP_FREEBSD) || defined(HTOP_NETBSD) || defined(HTOP_OPENBSD) || defined(HTOP_DARWIN)
+   return !ptrace(PT_DETACH, pid, (caddr_t)1, sig) ? 0 : errno;
+# else
+   (void)pid;
+   (void)sig;
+   return ENOSYS;
+# endif
+}
+
 static int ptraceDetach(pid_t pid) {
 # if defined(HTOP_LINUX)
    return !ptrace(PTRACE_DETACH, pid, (void*)0, (void*)0) ? 0 : errno;
@@ -51,29 +78,316 @@ static int ptraceDetach(pid_t pid) {
 # endif
 }
 
-void UnwindPtrace_makeBacktrace(Vector* frames, pid_t pid, char** error) {
-   *error = NULL;
+/* Resolved frames and demangled names kept between backtraces */
+#define UNWIND_SYMBOL_CACHE_SIZE 8192
+#define UNWIND_NAME_CACHE_SIZE 4096
+
+/* Threads unwinding different processes at once */
+#define UNWIND_MAX_WORKERS 8
+
+typedef struct UnwindPtraceMapping_ {
+   uint64_t start;
+   uint64_t end;
+   uint64_t fileOffset;
+   char* path;          /* NULL unless backed by a regular file */
+} UnwindPtraceMapping;
+
+/* Per-process unwinding state; used by one thread at a time */
+typedef struct UnwindPtraceUnwinder_ {
+   unw_addr_space_t addrSpace;
+   pid_t tgid;                  /* process the address space caches information of */
+
+   UnwindPtraceMapping* mappings;   /* executable mappings of tgid, sorted */
+   size_t mappingCount;
+   bool mappingsFresh;          /* re-read during the current backtrace */
+   bool busy;                   /* lent out from the pool; guarded by the cache lock */
+} UnwindPtraceUnwinder;
+
+struct UnwindPtraceCache_ {
+   UnwindPtraceUnwinder main;
+   UnwindPtraceUnwinder pool[UNWIND_MAX_WORKERS];   /* for workers and samplers; set up on first use */
+
+   pthread_mutex_t lock;        /* guards the symbol caches while unwinding in parallel */
+   SymbolCache* symbols;        /* frames by object path and file offset */
+   SymbolCache* names;          /* demangled names by mangled name */
+};
+
+static bool UnwindPtraceUnwinder_init(UnwindPtraceUnwinder* this) {
+   *this = (UnwindPtraceUnwinder) { .addrSpace = unw_create_addr_space(&_UPT_accessors, 0) };
+   if (!this->addrSpace)
+      return false;
+
+   unw_set_caching_policy(this->addrSpace, UNW_CACHE_GLOBAL);
+   return true;
+}
+
+static void UnwindPtraceUnwinder_clearMappings(UnwindPtraceUnwinder* this) {
+   for (size_t i = 0; i < this->mappingCount; i++)
+      free(this->mappings[i].path);
+   free(this->mappings);
+   this->mappings = NULL;
+   this->mappingCount = 0;
+}
+
+static void UnwindPtraceUnwinder_done(UnwindPtraceUnwinder* this) {
+   UnwindPtraceUnwinder_clearMappings(this);
+   if (this->addrSpace)
+      unw_destroy_addr_space(this->addrSpace);
+   this->addrSpace = NULL;
+}
+
+static void UnwindPtraceUnwinder_setProcess(UnwindPtraceUnwinder* this, pid_t tgid) {
+   if (this->tgid != tgid) {
+      /* cached unwind information is only valid within one process */
+      unw_flush_cache(this->addrSpace, 0, 0);
+      UnwindPtraceUnwinder_clearMappings(this);
+      this->tgid = tgid;
+   }
+   this->mappingsFresh = false;
+}
+
+static void UnwindPtraceUnwinder_readMappings(UnwindPtraceUnwinder* this) {
+   UnwindPtraceUnwinder_clearMappings(this);
+   this->mappingsFresh = true;
+
+# if defined(HTOP_LINUX)
+   char path[64];
+   xSnprintf(path, sizeof(path), PROCDIR "/%d/maps", this->tgid);
+   FILE* file = fopen(path, "r");
+   if (!file)
+      return;
+
+   size_t size = 0;
+   char buffer[PATH_MAX + 128];
+   while (fgets(buffer, sizeof(buffer), file)) {
+      uint64_t start;
+      uint64_t end;
+      uint64_t fileOffset;
+      char perms[8];
+      int pathStart = 0;
+      if (sscanf(buffer, "%" SCNx64 "-%" SCNx64 " %7s %" SCNx64 " %*s %*u %n", &start, &end, perms, &fileOffset, &pathStart) != 4 || !pathStart)
+         continue;
+      if (!strchr(perms, 'x'))
+         continue;
+
+      char* name = buffer + pathStart;
+      name[strcspn(name, "\n")] = '\0';
+
+      if (this->mappingCount == size) {
+         size = size ? size * 2 : 64;
+         this->mappings = xReallocArray(this->mappings, size, sizeof(UnwindPtraceMapping));
+      }
+      this->mappings[this->mappingCount++] = (UnwindPtraceMapping) {
+         .start = start,
+         .end = end,
+         .fileOffset = fileOffset,
+         .path = name[0] == '/' ? xStrdup(name) : NULL,
+      };
+   }
+   fclose(file);
+# endif
+}
+
+static const UnwindPtraceMapping* UnwindPtraceUnwinder_findMapping(UnwindPtraceUnwinder* this, uint64_t ip) {
+   for (;;) {
+      size_t lo = 0;
+      size_t hi = this->mappingCount;
+      while (lo < hi) {
+         size_t mid = lo + (hi - lo) / 2;
+         const UnwindPtraceMapping* mapping = &this->mappings[mid];
+         if (ip < mapping->start) {
+            hi = mid;
+         } else if (ip >= mapping->end) {
+            lo = mid + 1;
+         } else {
+            return mapping;
+         }
+      }
+
+      /* the process may have loaded more code since the mappings were read */
+      if (this->mappingsFresh)
+         return NULL;
+      UnwindPtraceUnwinder_readMappings(this);
+   }
+}
+
+/*
+ * Lends the idle unwinder of the pool that last worked on tgid, so its
+ * cached unwind information is used again, else preferably an unused one.
+ * Sets up own instead if all are lent out.
+ */
+static UnwindPtraceUnwinder* UnwindPtraceCache_takeUnwinder(UnwindPtraceCache* this, pid_t tgid, UnwindPtraceUnwinder* own) {
+   pthread_mutex_lock(&this->lock);
+   UnwindPtraceUnwinder* found = NULL;
+   for (size_t i = 0; i < ARRAYSIZE(this->pool); i++) {
+      UnwindPtraceUnwinder* unwinder = &this->pool[i];
+      if (unwinder->busy)
+         continue;
+      if (unwinder->addrSpace && unwinder->tgid == tgid) {
+         found = unwinder;
+         break;
+      }
+      if (!found || (found->addrSpace && !unwinder->addrSpace))
+         found = unwinder;
+   }
+   if (found) {
+      if (!found->addrSpace)
+         UnwindPtraceUnwinder_init(found);
+      found->busy = true;
+   }
+   pthread_mutex_unlock(&this->lock);
+
+   if (!found) {
+      UnwindPtraceUnwinder_init(own);
+      found = own;
+   }
+   return found;
+}
+
+static void UnwindPtraceCache_releaseUnwinder(UnwindPtraceCache* this, UnwindPtraceUnwinder* unwinder, UnwindPtraceUnwinder* own) {
+   if (unwinder == own) {
+      UnwindPtraceUnwinder_done(own);
+      return;
+   }
+
+   pthread_mutex_lock(&this->lock);
+   unwinder->busy = false;
+   pthread_mutex_unlock(&this->lock);
+}
+
+UnwindPtraceCache* UnwindPtraceCache_new(void) {
+   UnwindPtraceCache* this = xCalloc(1, sizeof(UnwindPtraceCache));
+   UnwindPtraceUnwinder_init(&this->main);
+   pthread_mutex_init(&this->lock, NULL);
+   this->symbols = SymbolCache_new(UNWIND_SYMBOL_CACHE_SIZE);
+   this->names = SymbolCache_new(UNWIND_NAME_CACHE_SIZE);
+   return this;
+}
+
+void UnwindPtraceCache_delete(UnwindPtraceCache* this) {
+   if (!this)
+      return;
+
+   UnwindPtraceUnwinder_done(&this->main);
+   for (size_t i = 0; i < ARRAYSIZE(this->pool); i++)
+      UnwindPtraceUnwinder_done(&this->pool[i]);
+   SymbolCache_delete(this->symbols);
+   SymbolCache_delete(this->names);
+   pthread_mutex_destroy(&this->lock);
+   free(this);
+}
+
+# if defined(HAVE_DEMANGLING)
+/* Called with the cache locked */
+static char* UnwindPtraceCache_demangle(UnwindPtraceCache* this, const char* mangled) {
+   const BacktraceFrameData* cached = SymbolCache_get(this->names, mangled, 0);
+   if (!cached) {
+      BacktraceFrameData* name = BacktraceFrameData_new();
+      name->demangleFunctionName = Demangle_demangle(mangled);
+      SymbolCache_put(this->names, mangled, 0, name);
+      cached = name;
+   }
+
+   return cached->demangleFunctionName ? xStrdup(cached->demangleFunctionName) : NULL;
+}
+# endif
+
+static void BacktraceFrameData_copySymbol(BacktraceFrameData* to, const BacktraceFrameData* from) {
+   to->offset = from->offset;
+   to->isSignalFrame = from->isSignalFrame;
+   to->functionName = from->functionName ? xStrdup(from->functionName) : NULL;
+   to->demangleFunctionName = from->demangleFunctionName ? xStrdup(from->demangleFunctionName) : NULL;
+   to->objectPath = from->objectPath ? xStrdup(from->objectPath) : NULL;
+}
+
+static void UnwindPtrace_describeFrame(UnwindPtraceCache* cache, UnwindPtraceUnwinder* unwinder, unw_cursor_t* cursor, BacktraceFrameData* frame) {
+   /* code in a file mapping resolves to the same symbol in any process */
+   const UnwindPtraceMapping* mapping = UnwindPtraceUnwinder_findMapping(unwinder, frame->address);
+   const char* mappedPath = mapping ? mapping->path : NULL;
+   uint64_t fileOffset = mapping ? frame->address - mapping->start + mapping->fileOffset : 0;
+
+   if (mappedPath) {
+      pthread_mutex_lock(&cache->lock);
+      const BacktraceFrameData* cached = SymbolCache_get(cache->symbols, mappedPath, fileOffset);
+      if (cached)
+         BacktraceFrameData_copySymbol(frame, cached);
+      pthread_mutex_unlock(&cache->lock);
+
+      if (cached)
+         return;
+   }
+
+   char buffer[2048] = {0};
+
+   frame->isSignalFrame = unw_is_signal_frame(cursor) > 0;
+
+# if defined(HAVE_LIBUNWIND_ELF_FILENAME)
+   unw_word_t offsetElfFileName;
+   if (unw_get_elf_filename(cursor, buffer, sizeof(buffer), &offsetElfFileName) == 0)
+      frame->objectPath = xStrndup(buffer, sizeof(buffer));
+# endif
+
+   unw_word_t offset;
+   if (unw_get_proc_name(cursor, buffer, sizeof(buffer), &offset) == 0) {
+      frame->offset = offset;
+      frame->functionName = xStrndup(buffer, sizeof(buffer));
+
+# if defined(HAVE_DEMANGLING)
+      pthread_mutex_lock(&cache->lock);
+      frame->demangleFunctionName = UnwindPtraceCache_demangle(cache, frame->functionName);
+      pthread_mutex_unlock(&cache->lock);
+# endif
+   }
+
+   if (mappedPath) {
+      BacktraceFrameData* copy = BacktraceFrameData_new();
+      BacktraceFrameData_copySymbol(copy, frame);
+
+      pthread_mutex_lock(&cache->lock);
+      if (!SymbolCache_get(cache->symbols, mappedPath, fileOffset)) {
+         SymbolCache_put(cache->symbols, mappedPath, fileOffset, copy);
+         copy = NULL;
+      }
+      pthread_mutex_unlock(&cache->lock);
+
+      if (copy)
+         BacktraceFrameData_delete((Object*)copy);
+   }
+}
+
+static int UnwindPtrace_waitStopped(pid_t pid, int* status) {
+# if defined(HTOP_LINUX)
+   return waitpid(pid, status, __WALL) == pid ? 0 : errno;
+# else
+   return waitpid(pid, status, 0) == pid ? 0 : errno;
+# endif
+}
+
+static void UnwindPtrace_unwind(UnwindPtraceCache* cache, UnwindPtraceUnwinder* unwinder, UnwindPtraceTask* task) {
+   pid_t pid = task->pid;
+   char** error = &task->error;
 
    if (pid <= 0) {
       *error = xStrdup("Invalid PID");
       return;
    }
 
-   unw_addr_space_t addrSpace = unw_create_addr_space(&_UPT_accessors, 0);
-   if (!addrSpace) {
+   if (!unwinder->addrSpace) {
       *error = xStrdup("Cannot initialize libunwind");
       return;
    }
 
+   UnwindPtraceUnwinder_setProcess(unwinder, task->tgid > 0 ? task->tgid : pid);
+
    int ptraceErrno = ptraceAttach(pid);
    if (ptraceErrno) {
       xAsprintf(error, "ptrace: %s (%d)", strerror(ptraceErrno), ptraceErrno);
-      goto addr_space_error;
+      return;
    }
 
    int waitStatus = 0;
-   if (wait(&waitStatus) == -1) {
-      int waitErrno = errno;
+   int waitErrno = UnwindPtrace_waitStopped(pid, &waitStatus);
+   if (waitErrno) {
       xAsprintf(error, "wait: %s (%d)", strerror(waitErrno), waitErrno);
       goto ptrace_error;
    }
@@ -90,7 +404,7 @@ void UnwindPtrace_makeBacktrace(Vector* frames, pid_t pid, char** error) {
    }
 
    unw_cursor_t cursor;
-   int ret = unw_init_remote(&cursor, addrSpace, context);
+   int ret = unw_init_remote(&cursor, unwinder->addrSpace, context);
    if (ret < 0) {
       xAsprintf(error, "libunwind cursor: ret=%d", ret);
       goto context_error;
@@ -98,8 +412,6 @@ void UnwindPtrace_makeBacktrace(Vector* frames, pid_t pid, char** error) {
 
    unsigned int index = 0;
    do {
-      char buffer[2048] = {0};
-
       BacktraceFrameData* frame = BacktraceFrameData_new();
       frame->index = index;
 
@@ -112,25 +424,8 @@ void UnwindPtrace_makeBacktrace(Vector* frames, pid_t pid, char** error) {
       }
       frame->address = pc;
 
-      frame->isSignalFrame = unw_is_signal_frame(&cursor) > 0;
-
-# if defined(HAVE_LIBUNWIND_ELF_FILENAME)
-      unw_word_t offsetElfFileName;
-      if (unw_get_elf_filename(&cursor, buffer, sizeof(buffer), &offsetElfFileName) == 0)
-         frame->objectPath = xStrndup(buffer, sizeof(buffer));
-# endif
-
-      unw_word_t offset;
-      if (unw_get_proc_name(&cursor, buffer, sizeof(buffer), &offset) == 0) {
-         frame->offset = offset;
-         frame->functionName = xStrndup(buffer, sizeof(buffer));
-
-# if defined(HAVE_DEMANGLING)
-         char* demangledName = Demangle_demangle(frame->functionName);
-         frame->demangleFunctionName = demangledName;
-# endif
-      }
-      Vector_add(frames, (Object *)frame);
+      UnwindPtrace_describeFrame(cache, unwinder, &cursor, frame);
+      Vector_add(task->frames, (Object *)frame);
       index++;
    } while (unw_step(&cursor) > 0 && index < INT_MAX);
 
@@ -139,8 +434,457 @@ context_error:
 
 ptrace_error:
    ptraceDetach(pid);
+}
+
+void UnwindPtrace_makeBacktrace(UnwindPtraceCache* cache, Vector* frames, pid_t pid, pid_t tgid, char** error) {
+   UnwindPtraceTask task = { .pid = pid, .tgid = tgid, .frames = frames };
+   UnwindPtrace_unwind(cache, &cache->main, &task);
+   *error = task.error;
+}
+
+typedef struct UnwindPtraceWorkers_ {
+   UnwindPtraceCache* cache;
+   UnwindPtraceTask** tasks;    /* sorted by thread group */
+   size_t count;
+   size_t next;                 /* first task not taken yet; guarded by the cache lock */
+} UnwindPtraceWorkers;
+
+/* Takes all tasks of the next thread group, as ptrace ties a tracee to one tracing thread */
+static bool UnwindPtraceWorkers_take(UnwindPtraceWorkers* this, size_t* first, size_t* last) {
+   pthread_mutex_lock(&this->cache->lock);
+   size_t begin = this->next;
+   size_t end = begin;
+   while (end < this->count && this->tasks[end]->tgid == this->tasks[begin]->tgid)
+      end++;
+   this->next = end;
+   pthread_mutex_unlock(&this->cache->lock);
+
+   *first = begin;
+   *last = end;
+   return begin < end;
+}
+
+static void UnwindPtraceWorkers_work(UnwindPtraceWorkers* this) {
+   size_t first;
+   size_t last;
+   while (UnwindPtraceWorkers_take(this, &first, &last)) {
+      UnwindPtraceUnwinder own;
+      UnwindPtraceUnwinder* unwinder = UnwindPtraceCache_takeUnwinder(this->cache, this->tasks[first]->tgid, &own);
+      for (size_t i = first; i < last; i++)
+         UnwindPtrace_unwind(this->cache, unwinder, this->tasks[i]);
+      UnwindPtraceCache_releaseUnwinder(this->cache, unwinder, &own);
+   }
+}
+
+static void* UnwindPtraceWorkers_run(void* arg) {
+   UnwindPtraceWorkers_work(arg);
+   return NULL;
+}
+
+static int UnwindPtraceTask_compareByThreadGroup(const void* a, const void* b) {
+   const UnwindPtraceTask* ta = *(const UnwindPtraceTask* const*)a;
+   const UnwindPtraceTask* tb = *(const UnwindPtraceTask* const*)b;
+   return SPACESHIP_NUMBER(ta->tgid, tb->tgid);
+}
+
+void UnwindPtrace_makeBacktraces(UnwindPtraceCache* cache, UnwindPtraceTask* tasks, size_t count) {
+   if (!count)
+      return;
+
+   UnwindPtraceTask** sorted = xMallocArray(count, sizeof(UnwindPtraceTask*));
+   for (size_t i = 0; i < count; i++) {
+      tasks[i].error = NULL;
+      if (tasks[i].tgid <= 0)
+         tasks[i].tgid = tasks[i].pid;
+      sorted[i] = &tasks[i];
+   }
+   qsort(sorted, count, sizeof(UnwindPtraceTask*), UnwindPtraceTask_compareByThreadGroup);
+
+   size_t groups = 1;
+   for (size_t i = 1; i < count; i++) {
+      if (sorted[i]->tgid != sorted[i - 1]->tgid)
+         groups++;
+   }
+
+   long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+   size_t workerCount = MINIMUM(groups, (size_t)CLAMP(cpus, 1L, (long)UNWIND_MAX_WORKERS));
+
+   UnwindPtraceWorkers workers = { .cache = cache, .tasks = sorted, .count = count };
+   pthread_t threads[UNWIND_MAX_WORKERS];
+
+   /* the calling thread is a worker as well; keep signal delivery on it */
+   sigset_t all;
+   sigset_t old;
+   sigfillset(&all);
+   pthread_sigmask(SIG_BLOCK, &all, &old);
+   size_t started = 0;
+   while (started + 1 < workerCount && pthread_create(&threads[started], NULL, UnwindPtraceWorkers_run, &workers) == 0)
+      started++;
+   pthread_sigmask(SIG_SETMASK, &old, NULL);
+
+   UnwindPtraceWorkers_work(&workers);
+
+   for (size_t i = 0; i < started; i++)
+      pthread_join(threads[i], NULL);
+
+   free(sorted);
+}
+
+/* Linux keeps the threads seized for the whole run and only interrupts them per sample */
+#if defined(HTOP_LINUX) && defined(PTRACE_SEIZE)
+# define UNWIND_SAMPLE_SEIZE
+#endif
+
+/* How often the thread list of the sampled process is read again */
+#define UNWIND_SAMPLE_RESCAN_MS 1000
+
+typedef struct UnwindPtraceThread_ {
+   pid_t tid;
+   struct UPT_info* context;
+   bool stopped;
+   bool gone;
+   bool groupStop;      /* in a job control stop, to be kept stopped when resumed */
+   int pendingSignal;   /* signal that stopped the thread instead of our interrupt */
+} UnwindPtraceThread;
+
+typedef struct UnwindPtraceSymbol_ {
+   unw_word_t ip;
+   BacktraceFrameData* frame;
+} UnwindPtraceSymbol;
+
+struct UnwindPtraceSampler_ {
+   pid_t pid;
+   UnwindPtraceCache* cache;
+   UnwindPtraceUnwinder* unwinder;   /* lent from the cache, or own */
+   UnwindPtraceUnwinder own;
+   UnwindPtraceThread* threads;
+   size_t threadCount;
+   size_t threadsSeen;     /* threads sampled at some point, including exited ones */
+   uint64_t listedMs;      /* when the thread list was last read */
+
+   /* frames by instruction pointer; open addressing, size is a power of two */
+   UnwindPtraceSymbol* symbols;
+   size_t symbolCount;
+   size_t symbolSize;
+};
+
+static bool UnwindPtraceSampler_hasThread(const UnwindPtraceSampler* this, pid_t tid) {
+   for (size_t i = 0; i < this->threadCount; i++) {
+      if (this->threads[i].tid == tid)
+         return true;
+   }
+   return false;
+}
+
+static bool UnwindPtraceSampler_addThread(UnwindPtraceSampler* this, pid_t tid) {
+   if (UnwindPtraceSampler_hasThread(this, tid))
+      return true;
+
+# ifdef UNWIND_SAMPLE_SEIZE
+   if (ptrace(PTRACE_SEIZE, tid, (void*)0, (void*)0) != 0)
+      return false;
+# endif
+
+   struct UPT_info* context = _UPT_create(tid);
+   if (!context) {
+# ifdef UNWIND_SAMPLE_SEIZE
+      /* detaching needs the thread stopped */
+      if (ptrace(PTRACE_INTERRUPT, tid, (void*)0, (void*)0) == 0 && waitpid(tid, NULL, __WALL) == tid)
+         ptraceDetach(tid);
+# endif
+      return false;
+   }
+
+   this->threads = xReallocArray(this->threads, this->threadCount + 1, sizeof(UnwindPtraceThread));
+   this->threads[this->threadCount++] = (UnwindPtraceThread) { .tid = tid, .context = context };
+   this->threadsSeen++;
+   return true;
+}
+
+/* Adds the threads started since the last call; Linux only, elsewhere just the main thread is sampled */
+static void UnwindPtraceSampler_listThreads(UnwindPtraceSampler* this) {
+# if defined(HTOP_LINUX)
+   Generic_gettime_monotonic(&this->listedMs);
+
+   char path[64];
+   xSnprintf(path, sizeof(path), PROCDIR "/%d/task", this->pid);
+   DIR* dir = opendir(path);
+   if (!dir)
+      return;
+
+   for (const struct dirent* entry; (entry = readdir(dir)); ) {
+      char* end;
+      long tid = strtol(entry->d_name, &end, 10);
+      if (end != entry->d_name && *end == '\0' && tid > 0)
+         UnwindPtraceSampler_addThread(this, (pid_t)tid);
+   }
+   closedir(dir);
+# else
+   (void)this;
+# endif
+}
+
+/* Frees the threads that have exited */
+static void UnwindPtraceSampler_dropGone(UnwindPtraceSampler* this) {
+   size_t kept = 0;
+   for (size_t i = 0; i < this->threadCount; i++) {
+      if (this->threads[i].gone) {
+         _UPT_destroy(this->threads[i].context);
+      } else {
+         this->threads[kept++] = this->threads[i];
+      }
+   }
+   this->threadCount = kept;
+}
+
+UnwindPtraceSampler* UnwindPtraceSampler_new(UnwindPtraceCache* cache, pid_t pid, char** error) {
+   *error = NULL;
+
+   if (pid <= 0) {
+      *error = xStrdup("Invalid PID");
+      return NULL;
+   }
+
+   UnwindPtraceSampler* this = xCalloc(1, sizeof(UnwindPtraceSampler));
+   this->pid = pid;
+   this->cache = cache;
+
+   this->unwinder = UnwindPtraceCache_takeUnwinder(cache, pid, &this->own);
+
+   if (!this->unwinder->addrSpace) {
+      *error = xStrdup("Cannot initialize libunwind");
+      UnwindPtraceSampler_delete(this);
+      return NULL;
+   }
+
+   UnwindPtraceSampler_listThreads(this);
+
+   if (!this->threadCount && !UnwindPtraceSampler_addThread(this, pid)) {
+      char buffer[128];
+      xSnprintf(buffer, sizeof(buffer), "Cannot trace process %d: %s", pid, strerror(errno));
+      *error = xStrdup(buffer);
+      UnwindPtraceSampler_delete(this);
+      return NULL;
+   }
+
+   return this;
+}
+
+size_t UnwindPtraceSampler_threadCount(const UnwindPtraceSampler* this) {
+   return this->threadsSeen;
+}
+
+static size_t UnwindPtraceSampler_slot(const UnwindPtraceSymbol* symbols, size_t size, unw_word_t ip) {
+   size_t mask = size - 1;
+   size_t i = (size_t)(((uint64_t)ip * UINT64_C(0x9E3779B97F4A7C15)) >> 32) & mask;
+   while (symbols[i].frame && symbols[i].ip != ip)
+      i = (i + 1) & mask;
+   return i;
+}
+
+static const BacktraceFrameData* UnwindPtraceSampler_frame(UnwindPtraceSampler* this, unw_cursor_t* cursor, unw_word_t ip) {
+   if ((this->symbolCount + 1) * 2 > this->symbolSize) {
+      size_t size = this->symbolSize ? this->symbolSize * 2 : 256;
+      UnwindPtraceSymbol* symbols = xCalloc(size, sizeof(UnwindPtraceSymbol));
+      for (size_t i = 0; i < this->symbolSize; i++) {
+         if (this->symbols[i].frame)
+            symbols[UnwindPtraceSampler_slot(symbols, size, this->symbols[i].ip)] = this->symbols[i];
+      }
+      free(this->symbols);
+      this->symbols = symbols;
+      this->symbolSize = size;
+   }
+
+   UnwindPtraceSymbol* symbol = &this->symbols[UnwindPtraceSampler_slot(this->symbols, this->symbolSize, ip)];
+   if (!symbol->frame) {
+      BacktraceFrameData* frame = BacktraceFrameData_new();
+      frame->address = ip;
+      UnwindPtrace_describeFrame(this->cache, this->unwinder, cursor, frame);
+      BacktraceFrameData_hashSymbol(frame);
+
+      symbol->ip = ip;
+      symbol->frame = frame;
+      this->symbolCount++;
+   }
+
+   return symbol->frame;
+}
+
+/*
+ * Collects a stop of the thread, without blocking if WNOHANG is given.
+ * Marks the thread gone once it has exited.
+ */
+static bool UnwindPtraceSampler_wait(UnwindPtraceThread* thread, int options) {
+   int status = 0;
+# if defined(HTOP_LINUX)
+   pid_t res = waitpid(thread->tid, &status, __WALL | options);
+# else
+   pid_t res = waitpid(thread->tid, &status, options);
+# endif
+   if (res == 0)
+      return false;
+   if (res != thread->tid || !WIFSTOPPED(status)) {
+      thread->gone = res == -1 ? errno == ECHILD : (WIFEXITED(status) || WIFSIGNALED(status));
+      return false;
+   }
+
+# ifdef UNWIND_SAMPLE_SEIZE
+   if ((status >> 16) == PTRACE_EVENT_STOP) {
+      /* our interrupt reports SIGTRAP, a job control stop its stop signal */
+      thread->pendingSignal = 0;
+      thread->groupStop = WSTOPSIG(status) != SIGTRAP;
+   } else {
+      thread->pendingSignal = WSTOPSIG(status);
+      thread->groupStop = false;
+   }
+# else
+   thread->pendingSignal = WSTOPSIG(status) == SIGSTOP ? 0 : WSTOPSIG(status);
+# endif
+   return true;
+}
+
+/* Lets a stopped thread go on, delivering the signal that stopped it */
+static void UnwindPtraceSampler_resume(UnwindPtraceThread* thread) {
+# ifdef UNWIND_SAMPLE_SEIZE
+   if (thread->groupStop) {
+      ptrace(PTRACE_LISTEN, thread->tid, (void*)0, (void*)0);
+   } else {
+      ptrace(PTRACE_CONT, thread->tid, (void*)0, (void*)(long)thread->pendingSignal);
+   }
+# else
+   ptraceDetachWithSignal(thread->tid, thread->pendingSignal);
+# endif
+   thread->stopped = false;
+}
+
+void UnwindPtraceSampler_delete(UnwindPtraceSampler* this) {
+   if (!this)
+      return;
+
+   for (size_t i = 0; i < this->symbolSize; i++) {
+      if (this->symbols[i].frame)
+         BacktraceFrameData_delete((Object*)this->symbols[i].frame);
+   }
+   free(this->symbols);
+
+   for (size_t i = 0; i < this->threadCount; i++) {
+      UnwindPtraceThread* thread = &this->threads[i];
+# ifdef UNWIND_SAMPLE_SEIZE
+      /* a seized thread can only be detached from a stop */
+      bool stopped = UnwindPtraceSampler_wait(thread, WNOHANG);
+      if (!stopped && !thread->gone && ptrace(PTRACE_INTERRUPT, thread->tid, (void*)0, (void*)0) == 0)
+         stopped = UnwindPtraceSampler_wait(thread, 0);
+      if (stopped)
+         ptraceDetachWithSignal(thread->tid, thread->pendingSignal);
+# endif
+      _UPT_destroy(thread->context);
+   }
+   free(this->threads);
+
+   if (this->unwinder)
+      UnwindPtraceCache_releaseUnwinder(this->cache, this->unwinder, &this->own);
+   free(this);
+}
+
+/* Linux only: whether the thread was on a CPU (or runnable) just before the stop */
+static bool UnwindPtraceSampler_isRunning(pid_t pid, pid_t tid) {
+# if defined(HTOP_LINUX)
+   char path[64];
+   xSnprintf(path, sizeof(path), PROCDIR "/%d/task/%d/stat", pid, tid);
+
+   char buffer[512];
+   if (Compat_readfile(path, buffer, sizeof(buffer)) <= 0)
+      return true;
+
+   const char* state = strrchr(buffer, ')');
+   return !state || state[1] != ' ' || state[2] == 'R';
+# else
+   (void)pid;
+   (void)tid;
+   return true;
+# endif
+}
+
+size_t UnwindPtraceSampler_sample(UnwindPtraceSampler* this, UnwindPtraceSampler_StackFn fn, void* data) {
+# if defined(HTOP_LINUX)
+   uint64_t nowMs;
+   Generic_gettime_monotonic(&nowMs);
+   if (nowMs - this->listedMs >= UNWIND_SAMPLE_RESCAN_MS)
+      UnwindPtraceSampler_listThreads(this);
+# endif
+
+   UnwindPtraceUnwinder_setProcess(this->unwinder, this->pid);
+
+   bool* running = xCalloc(this->threadCount, sizeof(bool));
+   bool* waiting = xCalloc(this->threadCount, sizeof(bool));
+
+   for (size_t i = 0; i < this->threadCount; i++) {
+      UnwindPtraceThread* thread = &this->threads[i];
+      running[i] = UnwindPtraceSampler_isRunning(this->pid, thread->tid);
+# ifdef UNWIND_SAMPLE_SEIZE
+      /* a signal may have stopped the thread since the last sample; it is passed on when resuming */
+      if (UnwindPtraceSampler_wait(thread, WNOHANG)) {
+         thread->stopped = true;
+         continue;
+      }
+      if (thread->gone || ptrace(PTRACE_INTERRUPT, thread->tid, (void*)0, (void*)0) != 0) {
+         thread->gone = true;
+         continue;
+      }
+      waiting[i] = true;
+# else
+      waiting[i] = ptraceAttach(thread->tid) == 0;
+# endif
+   }
+
+   for (size_t i = 0; i < this->threadCount; i++) {
+      UnwindPtraceThread* thread = &this->threads[i];
+      if (!waiting[i])
+         continue;
+
+      thread->stopped = UnwindPtraceSampler_wait(thread, 0);
+# ifndef UNWIND_SAMPLE_SEIZE
+      if (!thread->stopped)
+         ptraceDetach(thread->tid);
+# endif
+   }
+
+   size_t sampled = 0;
+   const BacktraceFrameData* frames[UNWIND_SAMPLE_MAX_DEPTH];
+
+   for (size_t i = 0; i < this->threadCount; i++) {
+      UnwindPtraceThread* thread = &this->threads[i];
+      if (!thread->stopped)
+         continue;
+
+      unw_cursor_t cursor;
+      if (unw_init_remote(&cursor, this->unwinder->addrSpace, thread->context) < 0)
+         continue;
+
+      size_t depth = 0;
+      do {
+         unw_word_t ip;
+         if (unw_get_reg(&cursor, UNW_REG_IP, &ip) != 0)
+            break;
+         frames[depth++] = UnwindPtraceSampler_frame(this, &cursor, ip);
+      } while (depth < ARRAYSIZE(frames) && unw_step(&cursor) > 0);
+
+      if (depth) {
+         fn(data, running[i], frames, depth);
+         sampled++;
+      }
+   }
+
+   for (size_t i = 0; i < this->threadCount; i++) {
+      UnwindPtraceThread* thread = &this->threads[i];
+      if (thread->stopped)
+         UnwindPtraceSampler_resume(thread);
+   }
+
+   UnwindPtraceSampler_dropGone(this);
 
-addr_space_error:
-   unw_destroy_addr_space(addrSpace);
+   free(waiting);
+   free(running);
+   return sampled;
 }
 #endif
@@ -7,13 +7,70 @@ Released under the GNU GPLv2+, see the COPYING file
 in the source distribution for its full text.
 */
 
+#include <stdbool.h>
+#include <stddef.h>
 #include <sys/types.h>
 
 #include "Vector.h"
 
 
+/* Deepest stack recorded per thread and sample */
+#define UNWIND_SAMPLE_MAX_DEPTH 128
+
+struct BacktraceFrameData_;
+
+/* Called once per thread and sample with the frames of its stack, innermost first */
+typedef void (*UnwindPtraceSampler_StackFn)(void* data, bool running, const struct BacktraceFrameData_* const* frames, size_t depth);
+
+typedef struct UnwindPtraceSampler_ UnwindPtraceSampler;
+
+typedef struct UnwindPtraceCache_ UnwindPtraceCache;
+
+/* One thread to unwind with UnwindPtrace_makeBacktraces */
+typedef struct UnwindPtraceTask_ {
+   pid_t pid;
+   pid_t tgid;
+   Vector* frames;      /* receives the frames, innermost first */
+   char* error;         /* set on failure, to be freed by the caller */
+} UnwindPtraceTask;
+
 #ifdef HAVE_LIBUNWIND_PTRACE
-void UnwindPtrace_makeBacktrace(Vector* frames, pid_t pid, char** error);
+/*
+ * State kept between backtraces: libunwind address spaces with their
+ * unwind information caches, and bounded caches of resolved symbols (by
+ * object path and file offset) and of demangled names. Parallel workers and
+ * samplers borrow address spaces from a pool, preferably the one that last
+ * unwound the same process; an address space cache is flushed whenever it
+ * is used for a different process.
+ */
+UnwindPtraceCache* UnwindPtraceCache_new(void);
+
+void UnwindPtraceCache_delete(UnwindPtraceCache* this);
+
+void UnwindPtrace_makeBacktrace(UnwindPtraceCache* cache, Vector* frames, pid_t pid, pid_t tgid, char** error);
+
+/*
+ * Unwinds many threads; different processes are unwound in parallel, the
+ * threads of one process by the same worker.
+ */
+void UnwindPtrace_makeBacktraces(UnwindPtraceCache* cache, UnwindPtraceTask* tasks, size_t count);
+
+/*
+ * Samples the stacks of all threads of a process. On Linux the threads are
+ * seized once, interrupted for each sample and detached on delete; threads
+ * started later are picked up every second. The per-thread contexts are
+ * created once and reused for every sample; frames are described once per
+ * instruction pointer and owned by the sampler.
+ */
+UnwindPtraceSampler* UnwindPtraceSampler_new(UnwindPtraceCache* cache, pid_t pid, char** error);
+
+void UnwindPtraceSampler_delete(UnwindPtraceSampler* this);
+
+/* Threads sampled so far, including those that have exited */
+size_t UnwindPtraceSampler_threadCount(const UnwindPtraceSampler* this);
+
+/* Stops all threads at once, unwinds each and resumes them all; returns the threads sampled */
+size_t UnwindPtraceSampler_sample(UnwindPtraceSampler* this, UnwindPtraceSampler_StackFn fn, void* data);
 #endif
 
 #endif
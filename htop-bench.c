@@ -0,0 +1,596 @@
+/*
+htop - htop-bench.c
+(C) 2026 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include <errno.h>
+#include <getopt.h>
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include "CRT.h"
+#include "DynamicColumn.h"
+#include "DynamicMeter.h"
+#include "DynamicScreen.h"
+#include "FunctionBar.h"
+#include "Hashtable.h"
+#include "Machine.h"
+#include "Macros.h"
+#include "Panel.h"
+#include "Platform.h"
+#include "Process.h"
+#include "ProcessTable.h"
+#include "Profiler.h"
+#include "RichString.h"
+#include "Row.h"
+#include "Settings.h"
+#include "Table.h"
+#include "UsersTable.h"
+#include "Vector.h"
+#include "XUtils.h"
+
+#include "linux/ProcFile.h"
+
+
+/*
+ * Headless benchmark of the scan/sort/display pipeline.
+ *
+ * This program is compiled with PROCDIR pointing into the build tree
+ * ("make bench"). It first writes a synthetic procfs tree there and then
+ * times repeated table scans, sorts, panel rebuilds and row formatting
+ * against it, without ever touching the terminal.
+ */
+
+const char* program = "htop-bench";
+
+typedef struct BenchConfig_ {
+   unsigned int processes;
+   unsigned int threads;
+   unsigned int cmdlineLen;
+   unsigned int mapsLines;
+   unsigned int iterations;
+   unsigned int cpus;
+   const char* statFile;
+   int sortKey;
+   bool treeView;
+   bool generate;
+   bool profile;
+} BenchConfig;
+
+typedef struct BenchStat_ {
+   const char* name;
+   uint64_t minNs;
+   uint64_t maxNs;
+   uint64_t totalNs;
+   unsigned int samples;
+} BenchStat;
+
+static uint64_t Bench_now(void) {
+   struct timespec ts;
+   if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0)
+      return 0;
+
+   return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void BenchStat_add(BenchStat* this, uint64_t ns) {
+   if (!this->samples || ns < this->minNs)
+      this->minNs = ns;
+   if (ns > this->maxNs)
+      this->maxNs = ns;
+   this->totalNs += ns;
+   this->samples++;
+}
+
+static void BenchStat_print(const BenchStat* this) {
+   unsigned int n = this->samples ? this->samples : 1;
+   printf("%-10s %10.3f %10.3f %10.3f\n",
+      this->name,
+      this->minNs / 1e6,
+      this->totalNs / (double)n / 1e6,
+      this->maxNs / 1e6);
+}
+
+/* Deterministic pseudo random numbers, so fixtures are identical across runs */
+static uint32_t fixtureSeed = 2463534242U;
+
+static uint32_t Fixture_rand(void) {
+   fixtureSeed ^= fixtureSeed << 13;
+   fixtureSeed ^= fixtureSeed >> 17;
+   fixtureSeed ^= fixtureSeed << 5;
+   return fixtureSeed;
+}
+
+static void Fixture_mkdir(const char* path) {
+   if (mkdir(path, 0755) != 0 && errno != EEXIST)
+      CRT_fatalError("Cannot create fixture directory");
+}
+
+static void Fixture_write(const char* dir, const char* name, const char* data, size_t len) {
+   char path[4096];
+   xSnprintf(path, sizeof(path), "%s/%s", dir, name);
+
+   FILE* fp = fopen(path, "w");
+   if (!fp)
+      CRT_fatalError("Cannot create fixture file");
+
+   if (len && fwrite(data, 1, len, fp) != len) {
+      fclose(fp);
+      CRT_fatalError("Cannot write fixture file");
+   }
+   fclose(fp);
+}
+
+static void Fixture_printf(const char* dir, const char* name, const char* fmt, ...) ATTR_FORMAT(printf, 3, 4);
+
+static void Fixture_printf(const char* dir, const char* name, const char* fmt, ...) {
+   char buffer[4096];
+
+   va_list ap;
+   va_start(ap, fmt);
+   int len = vsnprintf(buffer, sizeof(buffer), fmt, ap);
+   va_end(ap);
+
+   if (len < 0)
+      CRT_fatalError("Cannot format fixture file");
+
+   Fixture_write(dir, name, buffer, MINIMUM((size_t)len, sizeof(buffer) - 1));
+}
+
+static void Fixture_writeSystemFiles(unsigned int cpus, unsigned int tasks) {
+   /* field widths as seen on a machine with a few weeks of uptime */
+   size_t size = 256 + (size_t)(cpus + 1) * 160;
+   char* buffer = xMalloc(size);
+   size_t len = 0;
+
+   len += (size_t)xSnprintf(buffer + len, size - len,
+      "cpu  %llu 1200 %llu %llu 40000 0 8000 0 0 0\n",
+      120000000ULL * cpus, 30000000ULL * cpus, 2700000000ULL * cpus);
+   for (unsigned int i = 0; i < cpus; i++) {
+      len += (size_t)xSnprintf(buffer + len, size - len,
+         "cpu%u %u %u %u %u %u %u %u %u 0 0\n", i,
+         100000000 + Fixture_rand() % 40000000, Fixture_rand() % 2000,
+         20000000 + Fixture_rand() % 20000000, 2000000000 + Fixture_rand() % 1000000000,
+         Fixture_rand() % 100000, Fixture_rand() % 1000, Fixture_rand() % 20000, Fixture_rand() % 100);
+   }
+   len += (size_t)xSnprintf(buffer + len, size - len,
+      "intr 0\nctxt 123456789\nbtime 1700000000\nprocesses %u\nprocs_running 3\nprocs_blocked 0\n", tasks);
+   Fixture_write(PROCDIR, "stat", buffer, len);
+   free(buffer);
+
+   Fixture_printf(PROCDIR, "meminfo",
+      "MemTotal:       32768000 kB\n"
+      "MemFree:         8192000 kB\n"
+      "MemAvailable:   20480000 kB\n"
+      "Buffers:          512000 kB\n"
+      "Cached:          8192000 kB\n"
+      "SwapCached:            0 kB\n"
+      "Shmem:            256000 kB\n"
+      "SReclaimable:     512000 kB\n"
+      "SwapTotal:       8192000 kB\n"
+      "SwapFree:        8192000 kB\n");
+   Fixture_printf(PROCDIR, "uptime", "100000.00 350000.00\n");
+   Fixture_printf(PROCDIR, "loadavg", "1.00 0.75 0.50 3/%u %u\n", tasks, tasks);
+
+   char sysDir[4096];
+   xSnprintf(sysDir, sizeof(sysDir), "%s/sys", PROCDIR);
+   Fixture_mkdir(sysDir);
+   xSnprintf(sysDir, sizeof(sysDir), "%s/sys/kernel", PROCDIR);
+   Fixture_mkdir(sysDir);
+   Fixture_printf(sysDir, "pid_max", "4194304\n");
+}
+
+static void Fixture_writeTask(const char* dir, const BenchConfig* config, unsigned int pid, unsigned int tgid, unsigned int ppid, unsigned int index, bool withMaps) {
+   unsigned long long int starttime = 1000 + (unsigned long long int)index * 37;
+   unsigned long int utime = Fixture_rand() % 100000;
+   unsigned long int stime = Fixture_rand() % 20000;
+   unsigned long int vsize = 4096UL * (1000 + Fixture_rand() % 500000);
+   unsigned long int rss = 100 + Fixture_rand() % 100000;
+   unsigned int threads = config->threads + 1;
+
+   Fixture_printf(dir, "stat",
+      "%u (bench-%u) S %u %u %u 0 -1 4194304 %u 0 %u 0 %lu %lu 0 0 20 0 %u 0 %llu %lu %lu "
+      "18446744073709551615 1 1 0 0 0 0 0 4096 0 0 0 0 17 %u 0 0 0 0 0 0 0 0 0 0 0 0 0\n",
+      pid, tgid % 1000, ppid, tgid, tgid,
+      Fixture_rand() % 10000, Fixture_rand() % 100,
+      utime, stime, threads, starttime, vsize, rss, index % 8);
+
+   Fixture_printf(dir, "statm", "%lu %lu %lu 100 0 %lu 0\n", vsize / 4096, rss, rss / 4, rss / 2);
+
+   Fixture_printf(dir, "status",
+      "Name:\tbench-%u\n"
+      "State:\tS (sleeping)\n"
+      "Tgid:\t%u\n"
+      "Pid:\t%u\n"
+      "PPid:\t%u\n"
+      "Threads:\t%u\n"
+      "NSpid:\t%u\n"
+      "voluntary_ctxt_switches:\t%u\n"
+      "nonvoluntary_ctxt_switches:\t%u\n",
+      tgid % 1000, tgid, pid, ppid, threads, pid,
+      Fixture_rand() % 100000, Fixture_rand() % 1000);
+
+   Fixture_printf(dir, "comm", "bench-%u\n", tgid % 1000);
+
+   Fixture_printf(dir, "io",
+      "rchar: %u\nwchar: %u\nsyscr: %u\nsyscw: %u\nread_bytes: %u\nwrite_bytes: %u\ncancelled_write_bytes: 0\n",
+      Fixture_rand(), Fixture_rand(), Fixture_rand() % 100000, Fixture_rand() % 100000,
+      Fixture_rand(), Fixture_rand());
+
+   Fixture_printf(dir, "cgroup", "0::/system.slice/bench-%u.service\n", tgid % 64);
+   Fixture_printf(dir, "oom_score", "%u\n", Fixture_rand() % 1000);
+   Fixture_printf(dir, "oom_score_adj", "0\n");
+
+   /* arguments separated by NUL bytes, as in the real file */
+   char cmdline[4096];
+   size_t cmdlineLen = MINIMUM((size_t)config->cmdlineLen, sizeof(cmdline) - 1);
+   size_t len = (size_t)xSnprintf(cmdline, sizeof(cmdline), "/usr/bin/bench-%u", tgid % 1000);
+   len = MINIMUM(len, cmdlineLen);
+   while (len < cmdlineLen) {
+      cmdline[len++] = '\0';
+      for (unsigned int i = 0; i < 8 && len < cmdlineLen; i++)
+         cmdline[len++] = (char)('a' + Fixture_rand() % 26);
+   }
+   cmdline[len++] = '\0';
+   Fixture_write(dir, "cmdline", cmdline, len);
+
+   if (!withMaps)
+      return;
+
+   char path[4096];
+   xSnprintf(path, sizeof(path), "%s/maps", dir);
+   FILE* fp = fopen(path, "w");
+   if (!fp)
+      CRT_fatalError("Cannot create fixture file");
+
+   unsigned long int addr = 0x400000;
+   for (unsigned int i = 0; i < config->mapsLines; i++) {
+      unsigned long int size = 4096UL * (1 + Fixture_rand() % 64);
+      fprintf(fp, "%012lx-%012lx %s %08lx 08:01 %u /usr/lib/libbench%u.so.1\n",
+         addr, addr + size, (i % 3 == 0) ? "r-xp" : "rw-p", 0UL, 100000 + i % 50, i % 50);
+      addr += size;
+   }
+   fclose(fp);
+}
+
+static void Fixture_generate(const BenchConfig* config) {
+   unsigned int tasksPerProcess = config->threads + 1;
+
+   if (mkdir(PROCDIR, 0755) != 0)
+      CRT_fatalError("Cannot create fixture directory");
+   Fixture_writeSystemFiles(config->cpus, config->processes * tasksPerProcess);
+
+   for (unsigned int i = 0; i < config->processes; i++) {
+      unsigned int pid = 1 + i * tasksPerProcess;
+      /* parents always precede children; keep the tree a few levels deep */
+      unsigned int ppid = i == 0 ? 0 : 1 + (Fixture_rand() % i) / 4 * 4 * tasksPerProcess;
+
+      char procDir[4096];
+      xSnprintf(procDir, sizeof(procDir), "%s/%u", PROCDIR, pid);
+      Fixture_mkdir(procDir);
+      Fixture_writeTask(procDir, config, pid, pid, ppid, i, true);
+
+      char taskDir[4096];
+      xSnprintf(taskDir, sizeof(taskDir), "%s/task", procDir);
+      Fixture_mkdir(taskDir);
+
+      for (unsigned int t = 0; t < tasksPerProcess; t++) {
+         char threadDir[4096];
+         xSnprintf(threadDir, sizeof(threadDir), "%s/%u", taskDir, pid + t);
+         Fixture_mkdir(threadDir);
+         Fixture_writeTask(threadDir, config, pid + t, pid, ppid, i, false);
+      }
+   }
+}
+
+static void Bench_waitForTick(const Machine* host) {
+   /* Machine_scanTables skips a scan within the same millisecond */
+   uint64_t now;
+   do {
+      Platform_gettime_monotonic(&now);
+   } while (now <= host->monotonicMs);
+}
+
+/* The /proc/stat CPU line parser, on its own */
+static unsigned long long Bench_parseStat(ProcFile* file) {
+   if (!ProcFile_read(file))
+      CRT_fatalError("Cannot read /proc/stat fixture");
+
+   unsigned long long sum = 0;
+   for (const char* line = file->buffer; *line; line = ProcFile_nextLine(line)) {
+      unsigned long long values[PROCFILE_CPU_FIELDS];
+      int cpuId;
+      if (!ProcFile_parseCPUTimes(line, &cpuId, values))
+         break;
+      sum += values[0] + values[3];
+   }
+   return sum;
+}
+
+/* The fopen/fgets/sscanf parser it replaced, as a baseline */
+static unsigned long long Bench_parseStatScanf(const char* path) {
+   FILE* fp = fopen(path, "r");
+   if (!fp)
+      CRT_fatalError("Cannot read /proc/stat fixture");
+
+   unsigned long long sum = 0;
+   char buffer[4096 + 1];
+   while (fgets(buffer, sizeof(buffer), fp) && String_startsWith(buffer, "cpu")) {
+      unsigned long long v[PROCFILE_CPU_FIELDS] = { 0 };
+      unsigned int cpuId;
+      if (buffer[3] == ' ')
+         (void) sscanf(buffer, "cpu  %16llu %16llu %16llu %16llu %16llu %16llu %16llu %16llu %16llu %16llu", &v[0], &v[1], &v[2], &v[3], &v[4], &v[5], &v[6], &v[7], &v[8], &v[9]);
+      else
+         (void) sscanf(buffer, "cpu%4u %16llu %16llu %16llu %16llu %16llu %16llu %16llu %16llu %16llu %16llu", &cpuId, &v[0], &v[1], &v[2], &v[3], &v[4], &v[5], &v[6], &v[7], &v[8], &v[9]);
+      sum += v[0] + v[3];
+   }
+   fclose(fp);
+   return sum;
+}
+
+static void printHelp(void) {
+   printf("%s " VERSION " - headless scan benchmark\n\n"
+          "Fixture is written to " PROCDIR "\n\n"
+          "-N --processes=COUNT      Number of processes in the fixture (default 2000)\n"
+          "-T --threads=COUNT        Additional threads per process (default 2)\n"
+          "-c --cmdline=LENGTH       Length of each command line in bytes (default 128)\n"
+          "-m --maps=LINES           Lines in each /proc/PID/maps (default 64)\n"
+          "-C --cpus=COUNT           CPU lines in the fixture's /proc/stat (default 512)\n"
+          "-n --iterations=COUNT     Number of timed refresh cycles (default 50)\n"
+          "-s --sort-key=COLUMN      Sort by COLUMN\n"
+          "-t --tree                 Sort in tree view\n"
+          "   --no-generate          Reuse an existing fixture\n"
+          "   --stat=FILE            Time the /proc/stat parser on FILE, e.g. one captured\n"
+          "                          from a large machine (default: the fixture's)\n"
+          "-p --profile              Also print the per-phase self-profile\n"
+          "-h --help                 Print this help screen\n", program);
+}
+
+static bool parseArguments(int argc, char** argv, BenchConfig* config) {
+   const struct option long_opts[] = {
+      {"processes",   required_argument, 0, 'N'},
+      {"threads",     required_argument, 0, 'T'},
+      {"cmdline",     required_argument, 0, 'c'},
+      {"maps",        required_argument, 0, 'm'},
+      {"iterations",  required_argument, 0, 'n'},
+      {"cpus",        required_argument, 0, 'C'},
+      {"sort-key",    required_argument, 0, 's'},
+      {"tree",        no_argument,       0, 't'},
+      {"no-generate", no_argument,       0, 128},
+      {"stat",        required_argument, 0, 129},
+      {"profile",     no_argument,       0, 'p'},
+      {"help",        no_argument,       0, 'h'},
+      {0, 0, 0, 0}
+   };
+
+   int opt;
+   while ((opt = getopt_long(argc, argv, "N:T:c:m:n:C:s:tph", long_opts, NULL)) != -1) {
+      switch (opt) {
+         case 'N':
+            config->processes = (unsigned int)strtoul(optarg, NULL, 10);
+            break;
+         case 'T':
+            config->threads = (unsigned int)strtoul(optarg, NULL, 10);
+            break;
+         case 'c':
+            config->cmdlineLen = (unsigned int)strtoul(optarg, NULL, 10);
+            break;
+         case 'm':
+            config->mapsLines = (unsigned int)strtoul(optarg, NULL, 10);
+            break;
+         case 'n':
+            config->iterations = (unsigned int)strtoul(optarg, NULL, 10);
+            break;
+         case 'C':
+            config->cpus = (unsigned int)strtoul(optarg, NULL, 10);
+            break;
+         case 's':
+            config->sortKey = 0;
+            for (int j = 1; j < LAST_PROCESSFIELD; j++) {
+               if (Process_fields[j].name && String_eq(optarg, Process_fields[j].name)) {
+                  config->sortKey = j;
+                  break;
+               }
+            }
+            if (config->sortKey == 0) {
+               fprintf(stderr, "Error: invalid column \"%s\".\n", optarg);
+               return false;
+            }
+            break;
+         case 't':
+            config->treeView = true;
+            break;
+         case 128:
+            config->generate = false;
+            break;
+         case 129:
+            config->statFile = optarg;
+            break;
+         case 'p':
+            config->profile = true;
+            break;
+         case 'h':
+            printHelp();
+            exit(0);
+         default:
+            return false;
+      }
+   }
+
+   if (config->processes == 0 || config->iterations == 0 || config->cpus == 0) {
+      fprintf(stderr, "Error: need at least one process, CPU and iteration.\n");
+      return false;
+   }
+
+   return true;
+}
+
+int main(int argc, char** argv) {
+   BenchConfig config = {
+      .processes = 2000,
+      .threads = 2,
+      .cmdlineLen = 128,
+      .mapsLines = 64,
+      .iterations = 50,
+      .cpus = 512,
+      .statFile = PROCDIR "/stat",
+      .sortKey = 0,
+      .treeView = false,
+      .generate = true,
+      .profile = false,
+   };
+
+   if (!parseArguments(argc, argv, &config))
+      return 1;
+
+   if (String_eq(PROCDIR, "/proc")) {
+      fprintf(stderr, "Error: %s must be built with PROCDIR pointing at a fixture directory (use \"make bench\").\n", program);
+      return 1;
+   }
+
+   if (config.generate) {
+      if (access(PROCDIR, F_OK) == 0) {
+         fprintf(stderr, "Error: fixture %s already exists; remove it or pass --no-generate.\n", PROCDIR);
+         return 1;
+      }
+
+      uint64_t start = Bench_now();
+      Fixture_generate(&config);
+      printf("fixture: %u processes, %u tasks, %u byte cmdlines, %u line maps, %u CPUs in %s (%.1f ms)\n",
+         config.processes, config.processes * (config.threads + 1), config.cmdlineLen, config.mapsLines,
+         config.cpus, PROCDIR, (Bench_now() - start) / 1e6);
+   }
+
+   if (!Platform_init())
+      return 1;
+
+   UsersTable* ut = UsersTable_new();
+   UsersTable_preload(ut);
+   Hashtable* dm = DynamicMeters_new();
+   Hashtable* dc = DynamicColumns_new();
+   Hashtable* ds = DynamicScreens_new();
+
+   Machine* host = Machine_new(ut, (uid_t)-1);
+   ProcessTable* pt = ProcessTable_new(host, NULL);
+   Settings* settings = Settings_new(host, dm, dc, ds);
+   Machine_populateTablesFromSettings(host, settings, &pt->super);
+
+   settings->ss->treeView = config.treeView;
+   if (config.sortKey > 0)
+      ScreenSettings_setSortKey(settings->ss, config.sortKey);
+
+   /* no terminal: only the color table is needed for formatting rows */
+   CRT_setColors(COLORSCHEME_MONOCHROME);
+
+   Panel* panel = Panel_new(0, 0, 200, 50, Class(Row), false, FunctionBar_new(NULL, NULL, NULL));
+   Machine_setTablesPanel(host, panel);
+
+   /* prime the tables once, as htop does before entering the main loop */
+   Machine_scan(host);
+   Machine_scanTables(host);
+
+   if (config.profile)
+      Profiler_enable();
+
+   BenchStat scan = { .name = "scan" };
+   BenchStat sort = { .name = "sort" };
+   BenchStat rebuild = { .name = "rebuild" };
+   BenchStat display = { .name = "display" };
+
+   Table* table = host->activeTable;
+
+   for (unsigned int i = 0; i < config.iterations; i++) {
+      Bench_waitForTick(host);
+      Profiler_cycle();
+
+      uint64_t t0 = Bench_now();
+      Machine_scan(host);
+      Machine_scanTables(host);
+      uint64_t t1 = Bench_now();
+
+      table->needsSort = true;
+      Table_updateDisplayList(table);
+      uint64_t t2 = Bench_now();
+
+      Table_rebuildPanel(table);
+      uint64_t t3 = Bench_now();
+
+      RichString_begin(out);
+      for (int j = 0; j < Panel_size(panel); j++) {
+         RichString_rewind(&out, RichString_size(&out));
+         Row_display(Panel_get(panel, j), &out);
+      }
+      RichString_delete(&out);
+      uint64_t t4 = Bench_now();
+
+      BenchStat_add(&scan, t1 - t0);
+      BenchStat_add(&sort, t2 - t1);
+      BenchStat_add(&rebuild, t3 - t2);
+      BenchStat_add(&display, t4 - t3);
+   }
+   Profiler_cycle();
+
+   BenchStat stat = { .name = "stat" };
+   BenchStat statScanf = { .name = "stat-scanf" };
+
+   ProcFile statFile;
+   ProcFile_init(&statFile, config.statFile);
+   for (unsigned int i = 0; i < config.iterations; i++) {
+      uint64_t t0 = Bench_now();
+      unsigned long long sum = Bench_parseStat(&statFile);
+      uint64_t t1 = Bench_now();
+      unsigned long long sumScanf = Bench_parseStatScanf(config.statFile);
+      uint64_t t2 = Bench_now();
+
+      if (sum != sumScanf)
+         CRT_fatalError("/proc/stat parsers disagree");
+
+      BenchStat_add(&stat, t1 - t0);
+      BenchStat_add(&statScanf, t2 - t1);
+   }
+   ProcFile_done(&statFile);
+
+#ifndef NDEBUG
+   printf("note: built with assertions enabled, timings include consistency checks\n");
+#endif
+   printf("rows: %d of %d, %u iterations, %s\n",
+      Panel_size(panel), Vector_size(table->rows), config.iterations,
+      config.treeView ? "tree view" : "list view");
+   printf("%-10s %10s %10s %10s\n", "phase", "min ms", "avg ms", "max ms");
+   BenchStat_print(&scan);
+   BenchStat_print(&sort);
+   BenchStat_print(&rebuild);
+   BenchStat_print(&display);
+   BenchStat_print(&stat);
+   BenchStat_print(&statScanf);
+
+   if (config.profile) {
+      printf("\n");
+      Profiler_dump(stdout);
+   }
+
+   Platform_done();
+
+   Machine_delete(host);
+   Panel_delete((Object*)panel);
+   UsersTable_delete(ut);
+   Settings_delete(settings);
+   DynamicColumns_delete(dc);
+   DynamicMeters_delete(dm);
+   DynamicScreens_delete(ds);
+
+   return 0;
+}
@@ -0,0 +1,230 @@
+/*
+htop - linux/CGroupRollup.c
+(C) 2026 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/CGroupRollup.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Macros.h"
+#include "Process.h"
+#include "Row.h"
+#include "Settings.h"
+#include "Vector.h"
+#include "XUtils.h"
+
+#include "linux/CGroupUtils.h"
+#include "linux/LinuxProcess.h"
+
+
+static unsigned int CGroupRollup_lastGeneration;
+
+void CGroupRollup_init(CGroupRollup* this, CGroupRollupKind kind) {
+   *this = (CGroupRollup) {
+      .kind = kind,
+      .generation = ++CGroupRollup_lastGeneration,
+   };
+}
+
+static void CGroupRollup_freeGroups(CGroupRollup* this) {
+   for (size_t i = 0; i < this->bucketCount; i++) {
+      CGroupRollupGroup* group = this->buckets[i];
+      while (group) {
+         CGroupRollupGroup* next = group->next;
+         free(group->name);
+         free(group);
+         group = next;
+      }
+   }
+   free(this->buckets);
+}
+
+void CGroupRollup_done(CGroupRollup* this) {
+   CGroupRollup_freeGroups(this);
+   *this = (CGroupRollup) { .buckets = NULL };
+}
+
+void CGroupRollup_setKind(CGroupRollup* this, CGroupRollupKind kind) {
+   CGroupRollup_done(this);
+   CGroupRollup_init(this, kind);
+}
+
+/* FNV-1a */
+static uint32_t CGroupRollup_hash(const char* name) {
+   uint32_t hash = 2166136261U;
+   for (const unsigned char* p = (const unsigned char*)name; *p; p++)
+      hash = (hash ^ *p) * 16777619U;
+   return hash;
+}
+
+static void CGroupRollup_resize(CGroupRollup* this, size_t bucketCount) {
+   CGroupRollupGroup** buckets = xCalloc(bucketCount, sizeof(CGroupRollupGroup*));
+
+   for (size_t i = 0; i < this->bucketCount; i++) {
+      CGroupRollupGroup* group = this->buckets[i];
+      while (group) {
+         CGroupRollupGroup* next = group->next;
+         CGroupRollupGroup** bucket = &buckets[group->hash & (bucketCount - 1)];
+         group->next = *bucket;
+         *bucket = group;
+         group = next;
+      }
+   }
+
+   free(this->buckets);
+   this->buckets = buckets;
+   this->bucketCount = bucketCount;
+}
+
+static CGroupRollupGroup* CGroupRollup_lookup(CGroupRollup* this, const char* name) {
+   uint32_t hash = CGroupRollup_hash(name);
+
+   if (this->buckets) {
+      for (CGroupRollupGroup* group = this->buckets[hash & (this->bucketCount - 1)]; group; group = group->next) {
+         if (group->hash == hash && String_eq(group->name, name))
+            return group;
+      }
+   }
+
+   if (this->count >= this->bucketCount)
+      CGroupRollup_resize(this, this->bucketCount ? this->bucketCount * 2 : 64);
+
+   CGroupRollupGroup* group = xCalloc(1, sizeof(CGroupRollupGroup));
+   group->name = xStrdup(name);
+   group->hash = hash;
+
+   CGroupRollupGroup** bucket = &this->buckets[hash & (this->bucketCount - 1)];
+   group->next = *bucket;
+   *bucket = group;
+   this->count++;
+
+   return group;
+}
+
+static const char* CGroupRollup_groupName(const CGroupRollup* this, const LinuxProcess* lp) {
+   const CGroupName* cgroup = lp->cgroup;
+   if (!cgroup)
+      return "N/A";
+
+   if (this->kind == CGROUP_ROLLUP_CONTAINER)
+      return cgroup->container ? cgroup->container : "N/A";
+
+   return cgroup->shortName ? cgroup->shortName : cgroup->path;
+}
+
+void CGroupRollup_update(CGroupRollup* this, const Table* processes) {
+   /* hidden kernel threads are not rescanned and have no cgroup */
+   const bool hideKernelThreads = processes->host->settings->hideKernelThreads;
+
+   for (size_t i = 0; i < this->bucketCount; i++) {
+      for (CGroupRollupGroup* group = this->buckets[i]; group; group = group->next) {
+         group->cpuPercent = 0.0;
+         group->residentKiB = 0;
+         group->ioReadRate = 0.0;
+         group->ioWriteRate = 0.0;
+         group->processes = 0;
+         group->threads = 0;
+      }
+   }
+
+   for (int i = 0; i < Vector_size(processes->rows); i++) {
+      LinuxProcess* lp = (LinuxProcess*) Vector_get(processes->rows, i);
+      const Process* proc = &lp->super;
+
+      /* exited processes kept for highlighting, and threads already counted in their process */
+      if (proc->super.tombStampMs > 0 || Process_isUserlandThread(proc))
+         continue;
+      if (hideKernelThreads && Process_isKernelThread(proc))
+         continue;
+
+      CGroupRollupGroup* group = lp->rollup_group;
+      if (!group || lp->rollup_generation != this->generation) {
+         group = CGroupRollup_lookup(this, CGroupRollup_groupName(this, lp));
+         lp->rollup_group = group;
+         lp->rollup_generation = this->generation;
+      }
+
+      if (isNonnegative(proc->percent_cpu))
+         group->cpuPercent += proc->percent_cpu;
+      if (proc->m_resident > 0)
+         group->residentKiB += (unsigned long long int)proc->m_resident;
+      if (isNonnegative(lp->io_rate_read_bps))
+         group->ioReadRate += lp->io_rate_read_bps;
+      if (isNonnegative(lp->io_rate_write_bps))
+         group->ioWriteRate += lp->io_rate_write_bps;
+      group->processes++;
+      group->threads += proc->nlwp > 0 ? (unsigned int)proc->nlwp : 1;
+   }
+
+   /* a group nobody was counted in is not cached by any live process */
+   for (size_t i = 0; i < this->bucketCount; i++) {
+      CGroupRollupGroup** link = &this->buckets[i];
+      while (*link) {
+         CGroupRollupGroup* group = *link;
+         if (group->processes) {
+            link = &group->next;
+            continue;
+         }
+
+         *link = group->next;
+         free(group->name);
+         free(group);
+         this->count--;
+      }
+   }
+}
+
+static double CGroupRollupGroup_sortValue(const CGroupRollupGroup* group, CGroupRollupSort sort) {
+   switch (sort) {
+      case CGROUP_ROLLUP_SORT_MEMORY:
+         return (double)group->residentKiB;
+      case CGROUP_ROLLUP_SORT_IO:
+         return group->ioReadRate + group->ioWriteRate;
+      case CGROUP_ROLLUP_SORT_TASKS:
+         return group->threads;
+      default:
+         return group->cpuPercent;
+   }
+}
+
+typedef struct CGroupRollupSortEntry_ {
+   double value;
+   const CGroupRollupGroup* group;
+} CGroupRollupSortEntry;
+
+static int CGroupRollup_compareEntries(const void* a, const void* b) {
+   const CGroupRollupSortEntry* ea = a;
+   const CGroupRollupSortEntry* eb = b;
+   if (ea->value > eb->value)
+      return -1;
+   if (ea->value < eb->value)
+      return 1;
+   return strcmp(ea->group->name, eb->group->name);
+}
+
+const CGroupRollupGroup** CGroupRollup_getSorted(const CGroupRollup* this, CGroupRollupSort sort, size_t* count) {
+   CGroupRollupSortEntry* entries = xMallocArray(MAXIMUM(this->count, 1), sizeof(CGroupRollupSortEntry));
+
+   size_t n = 0;
+   for (size_t i = 0; i < this->bucketCount; i++) {
+      for (const CGroupRollupGroup* group = this->buckets[i]; group; group = group->next)
+         entries[n++] = (CGroupRollupSortEntry) { .value = CGroupRollupGroup_sortValue(group, sort), .group = group };
+   }
+
+   qsort(entries, n, sizeof(CGroupRollupSortEntry), CGroupRollup_compareEntries);
+
+   const CGroupRollupGroup** groups = xMallocArray(MAXIMUM(n, 1), sizeof(CGroupRollupGroup*));
+   for (size_t i = 0; i < n; i++)
+      groups[i] = entries[i].group;
+   free(entries);
+
+   *count = n;
+   return groups;
+}
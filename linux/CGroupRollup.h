@@ -0,0 +1,69 @@
+#ifndef HEADER_CGroupRollup
+#define HEADER_CGroupRollup
+/*
+htop - linux/CGroupRollup.h
+(C) 2026 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "Table.h"
+
+
+typedef enum CGroupRollupKind_ {
+   CGROUP_ROLLUP_CONTAINER,
+   CGROUP_ROLLUP_CGROUP,
+} CGroupRollupKind;
+
+typedef enum CGroupRollupSort_ {
+   CGROUP_ROLLUP_SORT_CPU,
+   CGROUP_ROLLUP_SORT_MEMORY,
+   CGROUP_ROLLUP_SORT_IO,
+   CGROUP_ROLLUP_SORT_TASKS,
+   LAST_CGROUP_ROLLUP_SORT
+} CGroupRollupSort;
+
+typedef struct CGroupRollupGroup_ {
+   char* name;
+   uint32_t hash;
+   struct CGroupRollupGroup_* next;
+
+   double cpuPercent;
+   unsigned long long int residentKiB;
+   double ioReadRate;      /* bytes per second */
+   double ioWriteRate;
+   unsigned int processes;
+   unsigned int threads;
+} CGroupRollupGroup;
+
+/*
+ * Resource usage summed per container or per cgroup. Groups persist
+ * between updates and each process caches the group it was counted in,
+ * so only processes that are new or changed cgroup are looked up again.
+ */
+typedef struct CGroupRollup_ {
+   CGroupRollupKind kind;
+   unsigned int generation;   /* invalidates the group cached in processes */
+
+   CGroupRollupGroup** buckets;
+   size_t bucketCount;        /* a power of two */
+   size_t count;
+} CGroupRollup;
+
+void CGroupRollup_init(CGroupRollup* this, CGroupRollupKind kind);
+
+void CGroupRollup_done(CGroupRollup* this);
+
+/* Regroups from scratch, e.g. when switching between containers and cgroups */
+void CGroupRollup_setKind(CGroupRollup* this, CGroupRollupKind kind);
+
+/* Sums the rows of a process table in one pass; call after the table was scanned */
+void CGroupRollup_update(CGroupRollup* this, const Table* processes);
+
+/* Returns the groups ordered by sort, largest first; the caller frees the array */
+const CGroupRollupGroup** CGroupRollup_getSorted(const CGroupRollup* this, CGroupRollupSort sort, size_t* count);
+
+#endif
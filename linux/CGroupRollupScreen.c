@@ -0,0 +1,163 @@
+/*
+htop - linux/CGroupRollupScreen.c
+(C) 2026 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/CGroupRollupScreen.h"
+
+#include <stdlib.h>
+
+#include "FunctionBar.h"
+#include "Macros.h"
+#include "Meter.h"
+#include "Panel.h"
+#include "ProvideCurses.h"
+#include "Vector.h"
+#include "XUtils.h"
+
+#include "linux/LinuxProcessTable.h"
+
+
+static const char* const CGroupRollupScreenFunctions[] = {"Search ", "Filter ", "Refresh", "Cgroups   ", "Sort: CPU   ", "Done   ", NULL};
+
+static const char* const CGroupRollupScreenKeys[] = {"F3", "F4", "F5", "F6", "F7", "Esc"};
+
+static const int CGroupRollupScreenEvents[] = {KEY_F(3), KEY_F(4), KEY_F(5), KEY_F(6), KEY_F(7), 27};
+
+static const char* const CGroupRollupScreen_sortLabels[LAST_CGROUP_ROLLUP_SORT] = {
+   [CGROUP_ROLLUP_SORT_CPU]    = "Sort: CPU   ",
+   [CGROUP_ROLLUP_SORT_MEMORY] = "Sort: Memory",
+   [CGROUP_ROLLUP_SORT_IO]     = "Sort: IO    ",
+   [CGROUP_ROLLUP_SORT_TASKS]  = "Sort: Tasks ",
+};
+
+CGroupRollupScreen* CGroupRollupScreen_new(Machine* host, bool paused) {
+   CGroupRollupScreen* this = xMalloc(sizeof(CGroupRollupScreen));
+   Object_setClass(this, Class(CGroupRollupScreen));
+   this->host = host;
+   this->paused = paused;
+   this->sort = CGROUP_ROLLUP_SORT_CPU;
+   CGroupRollup_init(&this->rollup, CGROUP_ROLLUP_CONTAINER);
+
+   /* the rollup needs the cgroup of every process, with or without a cgroup column */
+   ((LinuxProcessTable*)host->processTable)->readCGroups = true;
+
+   FunctionBar* bar = FunctionBar_new(CGroupRollupScreenFunctions, CGroupRollupScreenKeys, CGroupRollupScreenEvents);
+   return (CGroupRollupScreen*) InfoScreen_init(&this->super, NULL, bar, LINES - 2, "  CPU%    RES   READ/s  WRITE/s  PROCS   TASKS  CONTAINER");
+}
+
+void CGroupRollupScreen_delete(Object* cast) {
+   CGroupRollupScreen* this = (CGroupRollupScreen*) cast;
+   ((LinuxProcessTable*)this->host->processTable)->readCGroups = false;
+   CGroupRollup_done(&this->rollup);
+   free(InfoScreen_done((InfoScreen*)this));
+}
+
+static void CGroupRollupScreen_draw(InfoScreen* this) {
+   bool byContainer = ((CGroupRollupScreen*)this)->rollup.kind == CGROUP_ROLLUP_CONTAINER;
+   InfoScreen_drawTitled(this, "Resource usage per %s", byContainer ? "container" : "cgroup");
+}
+
+static void CGroupRollupScreen_list(CGroupRollupScreen* this) {
+   InfoScreen* super = &this->super;
+   Panel* panel = super->display;
+   int idx = MAXIMUM(Panel_getSelectedIndex(panel), 0);
+
+   Panel_prune(panel);
+
+   size_t count;
+   const CGroupRollupGroup** groups = CGroupRollup_getSorted(&this->rollup, this->sort, &count);
+
+   for (size_t i = 0; i < count; i++) {
+      const CGroupRollupGroup* group = groups[i];
+
+      char resident[8];
+      char readRate[8];
+      char writeRate[8];
+      Meter_humanUnit(resident, (double)group->residentKiB, sizeof(resident));
+      Meter_humanUnit(readRate, group->ioReadRate / ONE_K, sizeof(readRate));
+      Meter_humanUnit(writeRate, group->ioWriteRate / ONE_K, sizeof(writeRate));
+
+      char* line;
+      xAsprintf(&line, "%6.1f %6s %8s %8s %6u %7u  %s",
+         group->cpuPercent,
+         resident,
+         readRate,
+         writeRate,
+         group->processes,
+         group->threads,
+         group->name);
+      InfoScreen_addLine(super, line);
+      free(line);
+   }
+
+   free(groups);
+
+   if (!count)
+      InfoScreen_addLine(super, "No processes found.");
+
+   Panel_setSelected(panel, idx);
+}
+
+static void CGroupRollupScreen_scan(InfoScreen* super) {
+   CGroupRollupScreen* this = (CGroupRollupScreen*) super;
+
+   Machine_rescan(this->host, !this->paused);
+   CGroupRollup_update(&this->rollup, this->host->processTable);
+   CGroupRollupScreen_list(this);
+}
+
+static void CGroupRollupScreen_refresh(InfoScreen* this) {
+   Vector_prune(this->lines);
+   CGroupRollupScreen_scan(this);
+   InfoScreen_draw(this);
+}
+
+/* Regroups or reorders the current values without scanning again */
+static void CGroupRollupScreen_relist(CGroupRollupScreen* this) {
+   Vector_prune(this->super.lines);
+   CGroupRollup_update(&this->rollup, this->host->processTable);
+   CGroupRollupScreen_list(this);
+   InfoScreen_draw(this);
+}
+
+static bool CGroupRollupScreen_onKey(InfoScreen* super, int ch) {
+   CGroupRollupScreen* this = (CGroupRollupScreen*) super;
+
+   switch (ch) {
+      case 'g':
+      case KEY_F(6): {
+         bool byContainer = this->rollup.kind == CGROUP_ROLLUP_CONTAINER;
+         CGroupRollup_setKind(&this->rollup, byContainer ? CGROUP_ROLLUP_CGROUP : CGROUP_ROLLUP_CONTAINER);
+         FunctionBar_setLabel(super->display->defaultBar, KEY_F(6), byContainer ? "Containers" : "Cgroups   ");
+         Panel_setHeader(super->display, byContainer
+            ? "  CPU%    RES   READ/s  WRITE/s  PROCS   TASKS  CGROUP"
+            : "  CPU%    RES   READ/s  WRITE/s  PROCS   TASKS  CONTAINER");
+         CGroupRollupScreen_relist(this);
+         return true;
+      }
+      case 's':
+      case KEY_F(7):
+         this->sort = (this->sort + 1) % LAST_CGROUP_ROLLUP_SORT;
+         FunctionBar_setLabel(super->display->defaultBar, KEY_F(7), CGroupRollupScreen_sortLabels[this->sort]);
+         CGroupRollupScreen_relist(this);
+         return true;
+   }
+
+   return false;
+}
+
+const InfoScreenClass CGroupRollupScreen_class = {
+   .super = {
+      .extends = Class(Object),
+      .delete = CGroupRollupScreen_delete
+   },
+   .scan = CGroupRollupScreen_scan,
+   .draw = CGroupRollupScreen_draw,
+   .onErr = CGroupRollupScreen_refresh,
+   .onKey = CGroupRollupScreen_onKey
+};
@@ -0,0 +1,33 @@
+#ifndef HEADER_CGroupRollupScreen
+#define HEADER_CGroupRollupScreen
+/*
+htop - linux/CGroupRollupScreen.h
+(C) 2026 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+
+#include "InfoScreen.h"
+#include "Machine.h"
+#include "Object.h"
+
+#include "linux/CGroupRollup.h"
+
+
+typedef struct CGroupRollupScreen_ {
+   InfoScreen super;
+   Machine* host;
+   bool paused;
+   CGroupRollup rollup;
+   CGroupRollupSort sort;
+} CGroupRollupScreen;
+
+extern const InfoScreenClass CGroupRollupScreen_class;
+
+CGroupRollupScreen* CGroupRollupScreen_new(Machine* host, bool paused);
+
+void CGroupRollupScreen_delete(Object* this);
+
+#endif
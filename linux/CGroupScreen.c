@@ -0,0 +1,122 @@
+/*
+htop - linux/CGroupScreen.c
+(C) 2026 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/CGroupScreen.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "Macros.h"
+#include "Meter.h"
+#include "Panel.h"
+#include "Platform.h"
+#include "ProvideCurses.h"
+#include "Vector.h"
+#include "XUtils.h"
+
+#include "linux/CGroupUtils.h"
+
+
+CGroupScreen* CGroupScreen_new(void) {
+   CGroupScreen* this = xMalloc(sizeof(CGroupScreen));
+   Object_setClass(this, Class(CGroupScreen));
+   this->available = CGroupTree_init(&this->tree);
+   return (CGroupScreen*) InfoScreen_init(&this->super, NULL, NULL, LINES - 2, "  CPU%    MEMORY  CPU-S  MEM-S  MEM-F   IO-S   IO-F  CGROUP");
+}
+
+void CGroupScreen_delete(Object* cast) {
+   CGroupScreen* this = (CGroupScreen*) cast;
+   CGroupTree_done(&this->tree);
+   free(InfoScreen_done((InfoScreen*)this));
+}
+
+static void CGroupScreen_draw(InfoScreen* this) {
+   InfoScreen_drawTitled(this, "Pressure stall (avg10) and usage per cgroup");
+}
+
+static void CGroupScreen_formatValue(char* buffer, size_t size, double value, int decimals) {
+   if (isnan(value))
+      xSnprintf(buffer, size, "-");
+   else
+      xSnprintf(buffer, size, "%.*f", decimals, value);
+}
+
+static void CGroupScreen_addNode(InfoScreen* this, const CGroupNode* node) {
+   if (!node->populated)
+      return;
+
+   char cpu[8];
+   char memory[8] = "-";
+   char pressure[5][8];
+   CGroupScreen_formatValue(cpu, sizeof(cpu), node->cpuPercent, 1);
+   if (node->haveMemory)
+      Meter_humanUnit(memory, node->memoryCurrent / (double)ONE_K, sizeof(memory));
+   CGroupScreen_formatValue(pressure[0], sizeof(pressure[0]), node->cpu.some, 2);
+   CGroupScreen_formatValue(pressure[1], sizeof(pressure[1]), node->memory.some, 2);
+   CGroupScreen_formatValue(pressure[2], sizeof(pressure[2]), node->memory.full, 2);
+   CGroupScreen_formatValue(pressure[3], sizeof(pressure[3]), node->io.some, 2);
+   CGroupScreen_formatValue(pressure[4], sizeof(pressure[4]), node->io.full, 2);
+
+   char* path;
+   xAsprintf(&path, "/%s", node->path);
+   char* label = CGroup_filterName(path);
+
+   char* line;
+   xAsprintf(&line, "%6s %9s %6s %6s %6s %6s %6s  %s",
+      cpu,
+      memory,
+      pressure[0], pressure[1], pressure[2], pressure[3], pressure[4],
+      label ? label : path);
+   InfoScreen_addLine(this, line);
+
+   free(line);
+   free(label);
+   free(path);
+
+   for (size_t i = 0; i < node->childCount; i++)
+      CGroupScreen_addNode(this, node->children[i]);
+}
+
+static void CGroupScreen_scan(InfoScreen* super) {
+   CGroupScreen* this = (CGroupScreen*) super;
+   Panel* panel = super->display;
+   int idx = MAXIMUM(Panel_getSelectedIndex(panel), 0);
+
+   Panel_prune(panel);
+
+   if (!this->available) {
+      InfoScreen_addLine(super, "No cgroup v2 hierarchy found.");
+      return;
+   }
+
+   uint64_t monotonicMs;
+   Platform_gettime_monotonic(&monotonicMs);
+   CGroupTree_update(&this->tree, monotonicMs);
+
+   CGroupScreen_addNode(super, this->tree.root);
+
+   Panel_setSelected(panel, idx);
+}
+
+static void CGroupScreen_refresh(InfoScreen* this) {
+   Vector_prune(this->lines);
+   CGroupScreen_scan(this);
+   InfoScreen_draw(this);
+}
+
+const InfoScreenClass CGroupScreen_class = {
+   .super = {
+      .extends = Class(Object),
+      .delete = CGroupScreen_delete
+   },
+   .scan = CGroupScreen_scan,
+   .draw = CGroupScreen_draw,
+   .onErr = CGroupScreen_refresh
+};
@@ -0,0 +1,30 @@
+#ifndef HEADER_CGroupScreen
+#define HEADER_CGroupScreen
+/*
+htop - linux/CGroupScreen.h
+(C) 2026 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+
+#include "InfoScreen.h"
+#include "Object.h"
+
+#include "linux/CGroupTree.h"
+
+
+typedef struct CGroupScreen_ {
+   InfoScreen super;
+   CGroupTree tree;
+   bool available;
+} CGroupScreen;
+
+extern const InfoScreenClass CGroupScreen_class;
+
+CGroupScreen* CGroupScreen_new(void);
+
+void CGroupScreen_delete(Object* this);
+
+#endif
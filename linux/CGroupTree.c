@@ -0,0 +1,279 @@
+/*
+htop - linux/CGroupTree.c
+(C) 2026 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/CGroupTree.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "Macros.h"
+#include "XUtils.h"
+#include "linux/LinuxProcessTable.h"
+
+
+static const char* const CGroupTree_mountPoints[] = {
+   "/sys/fs/cgroup",
+   "/sys/fs/cgroup/unified",   /* hybrid hierarchy */
+};
+
+static CGroupNode* CGroupTree_newNode(char* path) {
+   CGroupNode* node = xCalloc(1, sizeof(CGroupNode));
+   node->path = path;
+   node->fd = -1;
+   node->cpu = node->memory = node->io = (CGroupPressure) { .some = NAN, .full = NAN };
+   node->cpuPercent = NAN;
+   return node;
+}
+
+static void CGroupTree_deleteNode(CGroupTree* this, CGroupNode* node) {
+   for (size_t i = 0; i < node->childCount; i++)
+      CGroupTree_deleteNode(this, node->children[i]);
+   free(node->children);
+
+   if (node->fd >= 0) {
+      close(node->fd);
+      this->cachedFds--;
+   }
+   free(node->path);
+   free(node);
+}
+
+bool CGroupTree_init(CGroupTree* this) {
+   *this = (CGroupTree) { .rootFd = -1 };
+
+   for (size_t i = 0; i < ARRAYSIZE(CGroupTree_mountPoints); i++) {
+      int fd = open(CGroupTree_mountPoints[i], O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+      if (fd < 0)
+         continue;
+
+      if (faccessat(fd, "cgroup.controllers", F_OK, 0) == 0) {
+         this->rootFd = fd;
+         break;
+      }
+      close(fd);
+   }
+
+   if (this->rootFd < 0)
+      return false;
+
+   this->root = CGroupTree_newNode(xStrdup(""));
+   this->root->populated = true;
+   return true;
+}
+
+void CGroupTree_done(CGroupTree* this) {
+   if (this->root)
+      CGroupTree_deleteNode(this, this->root);
+   if (this->rootFd >= 0)
+      close(this->rootFd);
+   *this = (CGroupTree) { .rootFd = -1 };
+}
+
+static bool CGroupTree_readFile(int dfd, const char* name, char* buffer, size_t size) {
+   int fd = openat(dfd, name, O_RDONLY | O_CLOEXEC);
+   if (fd < 0)
+      return false;
+
+   ssize_t len = read(fd, buffer, size - 1);
+   close(fd);
+   if (len < 0)
+      return false;
+
+   buffer[len] = '\0';
+   return true;
+}
+
+static double CGroupTree_parseAvg10(const char* buffer, const char* prefix) {
+   const char* p = strstr(buffer, prefix);
+   return p ? strtod(p + strlen(prefix), NULL) : NAN;
+}
+
+static uint64_t CGroupTree_parseCount(const char* buffer, const char* key) {
+   const char* p = strstr(buffer, key);
+   return p ? strtoull(p + strlen(key), NULL, 10) : 0;
+}
+
+/* "some avg10=0.47 avg60=1.42 avg300=1.59 total=84286388\nfull avg10=..." */
+static CGroupPressure CGroupTree_readPressure(int dfd, const char* name) {
+   char buffer[256];
+   if (!CGroupTree_readFile(dfd, name, buffer, sizeof(buffer)))
+      return (CGroupPressure) { .some = NAN, .full = NAN };
+
+   return (CGroupPressure) {
+      .some = CGroupTree_parseAvg10(buffer, "some avg10="),
+      .full = CGroupTree_parseAvg10(buffer, "full avg10="),
+   };
+}
+
+static void CGroupTree_readStats(CGroupNode* node, int dfd, double intervalSec, bool fresh) {
+   node->cpu = CGroupTree_readPressure(dfd, "cpu.pressure");
+   node->memory = CGroupTree_readPressure(dfd, "memory.pressure");
+   node->io = CGroupTree_readPressure(dfd, "io.pressure");
+
+   char buffer[1024];
+   node->cpuPercent = NAN;
+   if (CGroupTree_readFile(dfd, "cpu.stat", buffer, sizeof(buffer)) && String_startsWith(buffer, "usage_usec ")) {
+      uint64_t usage = strtoull(buffer + strlen("usage_usec "), NULL, 10);
+      if (!fresh && intervalSec > 0 && usage >= node->cpuUsageUsec)
+         node->cpuPercent = (double)(usage - node->cpuUsageUsec) / 1e4 / intervalSec;
+      node->cpuUsageUsec = usage;
+   }
+
+   node->haveMemory = CGroupTree_readFile(dfd, "memory.current", buffer, sizeof(buffer));
+   node->memoryCurrent = node->haveMemory ? strtoull(buffer, NULL, 10) : 0;
+}
+
+static int CGroupTree_compareNodes(const void* v1, const void* v2) {
+   const CGroupNode* n1 = *(const CGroupNode* const*)v1;
+   const CGroupNode* n2 = *(const CGroupNode* const*)v2;
+   return strcmp(n1->path, n2->path);
+}
+
+static void CGroupTree_listChildren(CGroupTree* this, CGroupNode* node, int dfd) {
+   /* fdopendir takes over the descriptor, which may be the cached one */
+   int listFd = openat(dfd, ".", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+   DIR* dir = listFd >= 0 ? fdopendir(listFd) : NULL;
+   if (!dir) {
+      if (listFd >= 0)
+         close(listFd);
+      return;
+   }
+
+   size_t known = node->childCount;
+   bool* keep = xCalloc(MAXIMUM(known, 1), sizeof(bool));
+   size_t prefixLen = node->path[0] ? strlen(node->path) + 1 : 0;
+
+   for (const struct dirent* entry; (entry = readdir(dir)); ) {
+      if (entry->d_type != DT_DIR || entry->d_name[0] == '.')
+         continue;
+
+      size_t i = 0;
+      while (i < known && !String_eq(node->children[i]->path + prefixLen, entry->d_name))
+         i++;
+
+      if (i < known) {
+         keep[i] = true;
+         continue;
+      }
+
+      char* path;
+      if (prefixLen)
+         xAsprintf(&path, "%s/%s", node->path, entry->d_name);
+      else
+         path = xStrdup(entry->d_name);
+
+      node->children = xReallocArray(node->children, node->childCount + 1, sizeof(CGroupNode*));
+      node->children[node->childCount++] = CGroupTree_newNode(path);
+   }
+
+   closedir(dir);
+
+   size_t kept = 0;
+   for (size_t i = 0; i < node->childCount; i++) {
+      if (i < known && !keep[i]) {
+         CGroupTree_deleteNode(this, node->children[i]);
+         continue;
+      }
+      node->children[kept++] = node->children[i];
+   }
+   node->childCount = kept;
+   free(keep);
+
+   if (node->childCount > 1)
+      qsort(node->children, node->childCount, sizeof(CGroupNode*), CGroupTree_compareNodes);
+
+   node->listed = true;
+}
+
+/* Returns false if the cgroup is gone */
+static bool CGroupTree_updateNode(CGroupTree* this, CGroupNode* node, double intervalSec) {
+   bool isRoot = node == this->root;
+
+   int dfd = isRoot ? this->rootFd : node->fd;
+   if (dfd < 0) {
+      dfd = openat(this->rootFd, node->path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+      if (dfd < 0)
+         return false;
+
+      if (this->cachedFds < CGROUP_TREE_MAX_FDS) {
+         node->fd = dfd;
+         this->cachedFds++;
+      }
+   }
+
+   bool ok = true;
+   bool wasPopulated = node->populated;
+
+   if (!isRoot) {
+      char events[128];
+      if (!CGroupTree_readFile(dfd, "cgroup.events", events, sizeof(events))) {
+         ok = false;
+         goto out;
+      }
+      node->populated = strstr(events, "populated 1") != NULL;
+   }
+
+   /* no process anywhere below: nothing to list or sample in this subtree */
+   if (!node->populated)
+      goto out;
+
+   char stat[1024];
+   if (CGroupTree_readFile(dfd, "cgroup.stat", stat, sizeof(stat))) {
+      uint64_t descendants = CGroupTree_parseCount(stat, "nr_descendants ");
+      uint64_t dying = CGroupTree_parseCount(stat, "nr_dying_descendants ");
+      if (!node->listed || this->relistAll || descendants != node->descendants || dying != node->dying) {
+         node->descendants = descendants;
+         node->dying = dying;
+         CGroupTree_listChildren(this, node, dfd);
+      }
+   } else if (!node->listed || this->relistAll) {
+      CGroupTree_listChildren(this, node, dfd);
+   }
+
+   CGroupTree_readStats(node, dfd, intervalSec, !wasPopulated);
+
+   size_t kept = 0;
+   for (size_t i = 0; i < node->childCount; i++) {
+      CGroupNode* child = node->children[i];
+      if (!CGroupTree_updateNode(this, child, intervalSec)) {
+         CGroupTree_deleteNode(this, child);
+         continue;
+      }
+      node->children[kept++] = child;
+   }
+
+   /* a child is gone, and another one may have been created in its place */
+   if (kept < node->childCount) {
+      node->childCount = kept;
+      CGroupTree_listChildren(this, node, dfd);
+   }
+
+out:
+   if (dfd != node->fd && dfd != this->rootFd)
+      close(dfd);
+   return ok;
+}
+
+void CGroupTree_update(CGroupTree* this, uint64_t monotonicMs) {
+   if (!this->root)
+      return;
+
+   this->intervalMs = this->sampleMs ? monotonicMs - this->sampleMs : 0;
+   this->sampleMs = monotonicMs;
+
+   this->relistAll = monotonicMs - this->relistMs >= LINUX_SLOW_SCAN_INTERVAL_MS;
+   if (this->relistAll)
+      this->relistMs = monotonicMs;
+
+   CGroupTree_updateNode(this, this->root, this->intervalMs / 1000.0);
+}
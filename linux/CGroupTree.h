@@ -0,0 +1,70 @@
+#ifndef HEADER_CGroupTree
+#define HEADER_CGroupTree
+/*
+htop - linux/CGroupTree.h
+(C) 2026 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+
+/* Directory descriptors kept open across updates, to stay clear of RLIMIT_NOFILE */
+#define CGROUP_TREE_MAX_FDS 128
+
+typedef struct CGroupPressure_ {
+   double some;           /* avg10 in percent, NAN if the file is missing */
+   double full;
+} CGroupPressure;
+
+typedef struct CGroupNode_ {
+   char* path;            /* relative to the cgroup2 root, "" for the root */
+   int fd;                /* cached directory descriptor, or -1 */
+   uint64_t descendants;  /* nr_descendants and nr_dying_descendants from */
+   uint64_t dying;        /* cgroup.stat, which change when a child comes or goes */
+   bool listed;           /* children known as of these counts */
+   bool populated;        /* from cgroup.events; the root always is */
+
+   CGroupPressure cpu;
+   CGroupPressure memory;
+   CGroupPressure io;
+   uint64_t cpuUsageUsec;
+   double cpuPercent;     /* over the last update interval, NAN on the first */
+   uint64_t memoryCurrent;
+   bool haveMemory;
+
+   struct CGroupNode_** children;
+   size_t childCount;
+} CGroupNode;
+
+/*
+ * The cgroup v2 hierarchy, kept across updates. A directory is listed again
+ * when its descendant counts changed or a known child is gone, and every
+ * slow scan period, as a child created and another one removed within one
+ * update leave the counts unchanged once the removed one is freed. Subtrees
+ * without processes are not descended into, so an update of a quiet tree
+ * costs a read of cgroup.events and cgroup.stat and the statistics of the
+ * populated groups. (The mtime of cgroupfs directories is not updated on
+ * mkdir or rmdir.)
+ */
+typedef struct CGroupTree_ {
+   int rootFd;
+   CGroupNode* root;
+   size_t cachedFds;
+   uint64_t sampleMs;
+   uint64_t intervalMs;
+   uint64_t relistMs;     /* when all directories were last listed */
+   bool relistAll;        /* list every directory during this update */
+} CGroupTree;
+
+/* Returns false if no cgroup2 hierarchy is mounted */
+bool CGroupTree_init(CGroupTree* this);
+
+void CGroupTree_done(CGroupTree* this);
+
+void CGroupTree_update(CGroupTree* this, uint64_t monotonicMs);
+
+#endif
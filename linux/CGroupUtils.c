@@ -9,6 +9,7 @@ in the source distribution for its full text.
 
 #include "linux/CGroupUtils.h"
 
+#include <assert.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdlib.h>
@@ -530,3 +531,97 @@ char* CGroup_filterContainer(const char* cgroup) {
    s.buf[s.size] = '\0';
    return s.buf;
 }
+
+typedef struct CGroupNameTable_ {
+   CGroupName** buckets;
+   size_t bucketCount;     /* a power of two */
+   size_t count;
+} CGroupNameTable;
+
+static CGroupNameTable CGroupName_table;
+
+/* FNV-1a */
+static uint32_t CGroupName_hash(const char* path, size_t len) {
+   uint32_t hash = 2166136261U;
+   for (size_t i = 0; i < len; i++)
+      hash = (hash ^ (unsigned char)path[i]) * 16777619U;
+   return hash;
+}
+
+static void CGroupNameTable_resize(CGroupNameTable* this, size_t bucketCount) {
+   CGroupName** buckets = xCalloc(bucketCount, sizeof(CGroupName*));
+
+   for (size_t i = 0; i < this->bucketCount; i++) {
+      CGroupName* name = this->buckets[i];
+      while (name) {
+         CGroupName* next = name->next;
+         CGroupName** bucket = &buckets[name->hash & (bucketCount - 1)];
+         name->next = *bucket;
+         *bucket = name;
+         name = next;
+      }
+   }
+
+   free(this->buckets);
+   this->buckets = buckets;
+   this->bucketCount = bucketCount;
+}
+
+CGroupName* CGroupName_intern(const char* path, size_t len) {
+   CGroupNameTable* this = &CGroupName_table;
+   uint32_t hash = CGroupName_hash(path, len);
+
+   if (this->buckets) {
+      for (CGroupName* name = this->buckets[hash & (this->bucketCount - 1)]; name; name = name->next) {
+         if (name->hash == hash && name->pathLen == len && memcmp(name->path, path, len) == 0) {
+            name->refCount++;
+            return name;
+         }
+      }
+   }
+
+   if (this->count >= this->bucketCount)
+      CGroupNameTable_resize(this, this->bucketCount ? this->bucketCount * 2 : 64);
+
+   CGroupName* name = xCalloc(1, sizeof(CGroupName));
+   name->path = xStrndup(path, len);
+   name->pathLen = len;
+   name->shortName = CGroup_filterName(name->path);
+   name->shortNameLen = name->shortName ? strlen(name->shortName) : 0;
+   name->container = CGroup_filterContainer(name->path);
+   name->containerLen = name->container ? strlen(name->container) : 0;
+   name->hash = hash;
+   name->refCount = 1;
+
+   CGroupName** bucket = &this->buckets[hash & (this->bucketCount - 1)];
+   name->next = *bucket;
+   *bucket = name;
+   this->count++;
+
+   return name;
+}
+
+void CGroupName_release(CGroupName* name) {
+   if (!name)
+      return;
+
+   assert(name->refCount > 0);
+   if (--name->refCount > 0)
+      return;
+
+   CGroupNameTable* this = &CGroupName_table;
+   CGroupName** link = &this->buckets[name->hash & (this->bucketCount - 1)];
+   while (*link != name)
+      link = &(*link)->next;
+   *link = name->next;
+
+   free(name->container);
+   free(name->shortName);
+   free(name->path);
+   free(name);
+
+   if (--this->count == 0) {
+      free(this->buckets);
+      *this = (CGroupNameTable) { .buckets = NULL };
+   }
+}
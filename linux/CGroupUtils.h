@@ -7,8 +7,34 @@ Released under the GNU GPLv2+, see the COPYING file
 in the source distribution for its full text.
 */
 
+#include <stddef.h>
+#include <stdint.h>
+
 
 char* CGroup_filterName(const char* cgroup);
 char* CGroup_filterContainer(const char* cgroup);
 
+/*
+ * A cgroup path shared by every process in that group, together with its
+ * shortened and container forms, which are computed once per path.
+ */
+typedef struct CGroupName_ {
+   char* path;
+   char* shortName;        /* NULL if the path could not be shortened */
+   char* container;        /* NULL if not in a container */
+   size_t pathLen;
+   size_t shortNameLen;
+   size_t containerLen;
+
+   uint32_t hash;
+   unsigned int refCount;
+   struct CGroupName_* next;
+} CGroupName;
+
+/* Returns the entry for path with a new reference, adding it if needed */
+CGroupName* CGroupName_intern(const char* path, size_t len);
+
+/* Drops a reference; the entry is freed once unused */
+void CGroupName_release(CGroupName* name);
+
 #endif /* HEADER_CGroupUtils */
@@ -0,0 +1,142 @@
+/*
+htop - linux/CPUFreqSampler.c
+(C) 2026 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/CPUFreqSampler.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "XUtils.h"
+
+
+#define CPUFREQ_FD_CLOSED (-1)
+#define CPUFREQ_FD_UNSUPPORTED (-2)
+
+static uint64_t CPUFreqSampler_nowUs(void) {
+   struct timespec ts;
+   if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0)
+      return 0;
+
+   return (uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000;
+}
+
+void CPUFreqSampler_init(CPUFreqSampler* this) {
+   *this = (CPUFreqSampler) { .cpus = 0 };
+}
+
+void CPUFreqSampler_done(CPUFreqSampler* this) {
+   for (unsigned int i = 0; i < this->cpus; i++) {
+      if (this->fds[i] >= 0)
+         close(this->fds[i]);
+   }
+
+   free(this->fds);
+   free(this->mhz);
+   CPUFreqSampler_init(this);
+}
+
+static void CPUFreqSampler_resize(CPUFreqSampler* this, unsigned int cpus) {
+   for (unsigned int i = cpus; i < this->cpus; i++) {
+      if (this->fds[i] >= 0)
+         close(this->fds[i]);
+   }
+
+   this->fds = xReallocArray(this->fds, cpus, sizeof(int));
+   this->mhz = xReallocArray(this->mhz, cpus, sizeof(double));
+
+   for (unsigned int i = this->cpus; i < cpus; i++) {
+      this->fds[i] = CPUFREQ_FD_CLOSED;
+      this->mhz[i] = NAN;
+   }
+
+   this->cpus = cpus;
+   if (this->next >= cpus)
+      this->next = 0;
+}
+
+static void CPUFreqSampler_readCPU(CPUFreqSampler* this, unsigned int cpu) {
+   int fd = this->fds[cpu];
+   if (fd == CPUFREQ_FD_UNSUPPORTED)
+      return;
+
+   if (fd < 0) {
+      char path[64];
+      xSnprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/cpufreq/scaling_cur_freq", cpu);
+      fd = open(path, O_RDONLY | O_CLOEXEC);
+      if (fd < 0) {
+         if (errno == ENOENT)
+            this->fds[cpu] = CPUFREQ_FD_UNSUPPORTED;
+         return;
+      }
+      this->fds[cpu] = fd;
+   }
+
+   char buffer[32];
+   ssize_t n = pread(fd, buffer, sizeof(buffer) - 1, 0);
+   if (n <= 0) {
+      /* e.g. the policy went away on CPU hotplug; reopen next time */
+      close(fd);
+      this->fds[cpu] = CPUFREQ_FD_CLOSED;
+      return;
+   }
+
+   unsigned long kHz = 0;
+   ssize_t i = 0;
+   for (; i < n && buffer[i] >= '0' && buffer[i] <= '9'; i++)
+      kHz = kHz * 10 + (unsigned long)(buffer[i] - '0');
+
+   if (i > 0) {
+      /* convert kHz to MHz */
+      this->mhz[cpu] = (double)(kHz / 1000);
+   }
+}
+
+bool CPUFreqSampler_sample(CPUFreqSampler* this, const Machine* host) {
+   if (host->existingCPUs != this->cpus)
+      CPUFreqSampler_resize(this, host->existingCPUs);
+
+   if (this->cpus == 0)
+      return false;
+
+   const uint64_t deadline = CPUFreqSampler_nowUs() + CPUFREQ_TICK_BUDGET_US;
+   const unsigned int minimum = (this->cpus + CPUFREQ_MAX_STALE_SCANS - 1) / CPUFREQ_MAX_STALE_SCANS;
+
+   unsigned int visited = 0;
+   while (visited < this->cpus) {
+      unsigned int cpu = (this->next + visited) % this->cpus;
+      visited++;
+
+      if (!Machine_isCPUonline(host, cpu)) {
+         this->mhz[cpu] = NAN;
+         continue;
+      }
+
+      CPUFreqSampler_readCPU(this, cpu);
+
+      /* even past the deadline, refresh enough CPUs to go round within CPUFREQ_MAX_STALE_SCANS scans */
+      if (visited >= minimum && CPUFreqSampler_nowUs() > deadline)
+         break;
+   }
+   this->next = (this->next + visited) % this->cpus;
+
+   this->supported = false;
+   for (unsigned int i = 0; i < this->cpus; i++) {
+      if (this->fds[i] >= 0 || !isnan(this->mhz[i])) {
+         this->supported = true;
+         break;
+      }
+   }
+
+   return this->supported;
+}
@@ -0,0 +1,49 @@
+#ifndef HEADER_CPUFreqSampler
+#define HEADER_CPUFreqSampler
+/*
+htop - linux/CPUFreqSampler.h
+(C) 2026 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+
+#include "Machine.h"
+
+
+/* Wall-clock budget for reading scaling_cur_freq files in one scan */
+#define CPUFREQ_TICK_BUDGET_US 500
+
+/* Every CPU is read at least once within this many scans, whatever the budget */
+#define CPUFREQ_MAX_STALE_SCANS 8
+
+/*
+ * Samples /sys/devices/system/cpu/cpuN/cpufreq/scaling_cur_freq through
+ * descriptors kept open across scans. Reading the file can be slow on some
+ * AMD and Intel CPUs (see issue#471), so each scan reads CPUs round-robin
+ * until the tick budget is used up and continues with the next CPU on the
+ * following scan. CPUs not reached keep their last sampled frequency, but
+ * each scan reads at least 1/CPUFREQ_MAX_STALE_SCANS of the CPUs to bound
+ * how old a value can get.
+ */
+typedef struct CPUFreqSampler_ {
+   unsigned int cpus;
+   int* fds;            /* -1 not open, -2 no cpufreq support for this CPU */
+   double* mhz;         /* last sampled frequency, NAN if never read */
+   unsigned int next;   /* first CPU to read on the next scan */
+   bool supported;      /* at least one CPU has a scaling_cur_freq file */
+} CPUFreqSampler;
+
+void CPUFreqSampler_init(CPUFreqSampler* this);
+
+void CPUFreqSampler_done(CPUFreqSampler* this);
+
+/* Returns false if no CPU exposes its frequency through cpufreq */
+bool CPUFreqSampler_sample(CPUFreqSampler* this, const Machine* host);
+
+static inline double CPUFreqSampler_get(const CPUFreqSampler* this, unsigned int cpu) {
+   return this->mhz[cpu];
+}
+
+#endif
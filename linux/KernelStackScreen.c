@@ -0,0 +1,155 @@
+/*
+htop - linux/KernelStackScreen.c
+(C) 2026 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/KernelStackScreen.h"
+
+#include <dirent.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Macros.h"
+#include "Panel.h"
+#include "ProvideCurses.h"
+#include "Vector.h"
+#include "XUtils.h"
+
+#include "linux/Compat.h"
+#include "linux/LinuxProcess.h"
+
+
+KernelStackScreen* KernelStackScreen_new(const Process* process) {
+   KernelStackScreen* this = xMalloc(sizeof(KernelStackScreen));
+   Object_setClass(this, Class(KernelStackScreen));
+   this->pid = Process_getThreadGroup(process);
+   this->tid = Process_isThread(process) ? Process_getPid(process) : 0;
+   return (KernelStackScreen*) InfoScreen_init(&this->super, process, NULL, LINES - 2, "TASK [STATE] WCHAN, KERNEL STACK");
+}
+
+void KernelStackScreen_delete(Object* this) {
+   free(InfoScreen_done((InfoScreen*)this));
+}
+
+static void KernelStackScreen_draw(InfoScreen* this) {
+   InfoScreen_drawTitled(this, "Kernel stack of process %d - %s", ((KernelStackScreen*)this)->pid, Process_getCommand(this->process));
+}
+
+static void KernelStackScreen_addTask(InfoScreen* this, pid_t pid, pid_t tid) {
+   char state = LinuxProcess_readTaskState(pid, tid);
+   if (!state)
+      return;
+
+   char wchan[64];
+   bool waiting = state == 'D' || state == 'S';
+   if (!waiting || !LinuxProcess_readWchan(pid, tid, wchan, sizeof(wchan)))
+      xSnprintf(wchan, sizeof(wchan), "-");
+
+   char* line;
+   xAsprintf(&line, "Thread %d [%c] %s", tid, state, wchan);
+   InfoScreen_addLine(this, line);
+   free(line);
+
+   /* the stack of a running task is stale as soon as it is read */
+   if (!waiting) {
+      InfoScreen_addLine(this, "    (not waiting)");
+      InfoScreen_addLine(this, "");
+      return;
+   }
+
+   char path[64];
+   xSnprintf(path, sizeof(path), PROCDIR "/%d/task/%d/stack", pid, tid);
+
+   char buffer[4096];
+   ssize_t len = Compat_readfile(path, buffer, sizeof(buffer));
+   if (len < 0) {
+      char* error;
+      xAsprintf(&error, "    (stack not available: %s)", strerror((int)-len));
+      InfoScreen_addLine(this, error);
+      free(error);
+   } else {
+      /* lines look like "[<0>] schedule+0x27/0xa0", the address is hidden unless privileged */
+      char* saveptr = NULL;
+      for (char* entry = strtok_r(buffer, "\n", &saveptr); entry; entry = strtok_r(NULL, "\n", &saveptr)) {
+         const char* symbol = entry;
+         if (symbol[0] == '[') {
+            const char* end = strstr(symbol, "] ");
+            if (end)
+               symbol = end + 2;
+         }
+
+         char* frame;
+         xAsprintf(&frame, "    %s", symbol);
+         InfoScreen_addLine(this, frame);
+         free(frame);
+      }
+   }
+
+   InfoScreen_addLine(this, "");
+}
+
+static int KernelStackScreen_compareTids(const void* a, const void* b) {
+   pid_t ta = *(const pid_t*)a;
+   pid_t tb = *(const pid_t*)b;
+   return (ta > tb) - (ta < tb);
+}
+
+static void KernelStackScreen_scan(InfoScreen* super) {
+   const KernelStackScreen* this = (const KernelStackScreen*) super;
+   Panel* panel = super->display;
+   int idx = MAXIMUM(Panel_getSelectedIndex(panel), 0);
+
+   Panel_prune(panel);
+
+   if (this->tid) {
+      KernelStackScreen_addTask(super, this->pid, this->tid);
+   } else {
+      char path[64];
+      xSnprintf(path, sizeof(path), PROCDIR "/%d/task", this->pid);
+
+      DIR* dir = opendir(path);
+      if (dir) {
+         pid_t* tids = NULL;
+         size_t count = 0;
+         size_t size = 0;
+
+         const struct dirent* entry;
+         while ((entry = readdir(dir))) {
+            if (entry->d_name[0] < '0' || entry->d_name[0] > '9')
+               continue;
+
+            if (count == size) {
+               size = size ? size * 2 : 16;
+               tids = xReallocArray(tids, size, sizeof(pid_t));
+            }
+            tids[count++] = atoi(entry->d_name);
+         }
+         closedir(dir);
+
+         qsort(tids, count, sizeof(pid_t), KernelStackScreen_compareTids);
+         for (size_t i = 0; i < count; i++)
+            KernelStackScreen_addTask(super, this->pid, tids[i]);
+
+         free(tids);
+      }
+   }
+
+   if (Vector_size(super->lines) == 0)
+      InfoScreen_addLine(super, "Could not read the tasks of the selected process.");
+
+   Panel_setSelected(panel, idx);
+}
+
+const InfoScreenClass KernelStackScreen_class = {
+   .super = {
+      .extends = Class(Object),
+      .delete = KernelStackScreen_delete
+   },
+   .scan = KernelStackScreen_scan,
+   .draw = KernelStackScreen_draw
+};
@@ -0,0 +1,29 @@
+#ifndef HEADER_KernelStackScreen
+#define HEADER_KernelStackScreen
+/*
+htop - linux/KernelStackScreen.h
+(C) 2026 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <sys/types.h>
+
+#include "InfoScreen.h"
+#include "Object.h"
+#include "Process.h"
+
+
+typedef struct KernelStackScreen_ {
+   InfoScreen super;
+   pid_t pid;
+   pid_t tid;     /* a single thread, or 0 for all threads of pid */
+} KernelStackScreen;
+
+extern const InfoScreenClass KernelStackScreen_class;
+
+KernelStackScreen* KernelStackScreen_new(const Process* process);
+
+void KernelStackScreen_delete(Object* this);
+
+#endif
@@ -21,11 +21,11 @@ in the source distribution for its full text.
 #include <string.h>
 #include <strings.h>
 #include <unistd.h>
-#include <time.h>
 
 #include "CRT.h"
 #include "Macros.h"
 #include "ProcessTable.h"
+#include "Profiler.h"
 #include "Row.h"
 #include "Settings.h"
 #include "UsersTable.h"
@@ -169,32 +169,32 @@ static void LinuxMachine_scanMemoryInfo(LinuxMachine* this) {
    bool zswapCompAvailable = false;
    bool zswapOrigAvailable = false;
 
-   FILE* file = fopen(PROCMEMINFOFILE, "r");
-   if (!file)
-      CRT_fatalError("Cannot open " PROCMEMINFOFILE);
+   if (!ProcFile_read(&this->meminfoFile))
+      CRT_fatalError("Cannot read " PROCMEMINFOFILE);
 
-   char buffer[128];
-   while (fgets(buffer, sizeof(buffer), file)) {
+   for (const char* line = this->meminfoFile.buffer; *line; line = ProcFile_nextLine(line)) {
 
       #define tryRead(label, variable)                                       \
-         if (String_startsWith(buffer, label)) {                             \
+         if (String_startsWith(line, label)) {                               \
+            const char* value_ = ProcFile_skipSpaces(line + strlen(label));  \
             memory_t parsed_;                                                \
-            if (sscanf(buffer + strlen(label), "%llu kB", &parsed_) == 1) {  \
+            if (ProcFile_parseNumber(value_, &parsed_) != value_) {          \
                (variable) = parsed_;                                         \
             }                                                                \
             break;                                                           \
          } else (void) 0 /* Require a ";" after the macro use. */
       #define tryReadFlag(label, variable, flag)                             \
-         if (String_startsWith(buffer, label)) {                             \
+         if (String_startsWith(line, label)) {                               \
+            const char* value_ = ProcFile_skipSpaces(line + strlen(label));  \
             memory_t parsed_;                                                \
-            (flag) = sscanf(buffer + strlen(label), "%llu kB", &parsed_) == 1; \
-            if (flag) {                                                       \
+            (flag) = ProcFile_parseNumber(value_, &parsed_) != value_;       \
+            if (flag) {                                                      \
                (variable) = parsed_;                                         \
             }                                                                \
             break;                                                           \
          } else (void) 0 /* Require a ";" after the macro use. */
 
-      switch (buffer[0]) {
+      switch (line[0]) {
          case 'M':
             tryRead("MemAvailable:", availableMem);
             tryRead("MemFree:", freeMem);
@@ -207,7 +207,7 @@ static void LinuxMachine_scanMemoryInfo(LinuxMachine* this) {
             tryRead("Cached:", cachedMem);
             break;
          case 'S':
-            switch (buffer[1]) {
+            switch (line[1]) {
                case 'h':
                   tryRead("Shmem:", sharedMem);
                   break;
@@ -231,8 +231,6 @@ static void LinuxMachine_scanMemoryInfo(LinuxMachine* this) {
       #undef tryRead
    }
 
-   fclose(file);
-
    /*
     * Compute memory partition like procps(free)
     *  https://gitlab.com/procps-ng/procps/-/blob/master/proc/sysinfo.c
@@ -496,45 +494,46 @@ static void LinuxMachine_scanCPUTime(LinuxMachine* this) {
 
    LinuxMachine_updateCPUcount(this);
 
-   FILE* file = fopen(PROCSTATFILE, "r");
-   if (!file)
-      CRT_fatalError("Cannot open " PROCSTATFILE);
+   if (!ProcFile_read(&this->statFile))
+      CRT_fatalError("Cannot read " PROCSTATFILE);
+
+   const char* line = this->statFile.buffer;
 
    // One thread per CPU thread + one for the average
    assert(super->existingCPUs < UINT_MAX - 1);
    bool adjCpuIdProcessed[super->existingCPUs + 1];
    memset(adjCpuIdProcessed, 0, sizeof(adjCpuIdProcessed));
 
-   for (unsigned int i = 0; i <= super->existingCPUs; i++) {
-      char buffer[PROC_LINE_LENGTH + 1];
-      unsigned long long int usertime, nicetime, systemtime, idletime;
-      unsigned long long int ioWait = 0, irq = 0, softIrq = 0, steal = 0, guest = 0, guestnice = 0;
-
-      const char* ok = fgets(buffer, sizeof(buffer), file);
-      if (!ok)
-         break;
+   for (unsigned int i = 0; i <= super->existingCPUs; i++, line = ProcFile_nextLine(line)) {
+      unsigned long long int times[PROCFILE_CPU_FIELDS];
+      int cpuid;
 
       // cpu fields are sorted first
-      if (!String_startsWith(buffer, "cpu"))
-         break;
-
       // Depending on your kernel version,
       // 5, 7, 8 or 9 of these fields will be set.
       // The rest will remain at zero.
+      if (!ProcFile_parseCPUTimes(line, &cpuid, times))
+         break;
+
       unsigned int adjCpuId;
       if (i == 0) {
-         (void) sscanf(buffer, "cpu  %16llu %16llu %16llu %16llu %16llu %16llu %16llu %16llu %16llu %16llu", &usertime, &nicetime, &systemtime, &idletime, &ioWait, &irq, &softIrq, &steal, &guest, &guestnice);
          adjCpuId = 0;
       } else {
-         unsigned int cpuid;
-         (void) sscanf(buffer, "cpu%4u %16llu %16llu %16llu %16llu %16llu %16llu %16llu %16llu %16llu %16llu", &cpuid, &usertime, &nicetime, &systemtime, &idletime, &ioWait, &irq, &softIrq, &steal, &guest, &guestnice);
-         if (cpuid >= super->existingCPUs)
+         if (cpuid < 0 || (unsigned int)cpuid >= super->existingCPUs)
             break;
-         adjCpuId = cpuid + 1;
+         adjCpuId = (unsigned int)cpuid + 1;
       }
 
-      if (adjCpuId > super->existingCPUs)
-         break;
+      unsigned long long int usertime = times[0];
+      unsigned long long int nicetime = times[1];
+      unsigned long long int systemtime = times[2];
+      unsigned long long int idletime = times[3];
+      unsigned long long int ioWait = times[4];
+      unsigned long long int irq = times[5];
+      unsigned long long int softIrq = times[6];
+      unsigned long long int steal = times[7];
+      unsigned long long int guest = times[8];
+      unsigned long long int guestnice = times[9];
 
       // Guest time is already accounted in usertime
       usertime -= guest;
@@ -586,79 +585,14 @@ static void LinuxMachine_scanCPUTime(LinuxMachine* this) {
 
    this->period = (double)this->cpuData[0].totalPeriod / super->activeCPUs;
 
-   if (!ferror(file) && !feof(file)) {
-      char buffer[PROC_LINE_LENGTH + 1];
-      while (fgets(buffer, sizeof(buffer), file)) {
-         if (String_startsWith(buffer, "procs_running")) {
-            this->runningTasks = (unsigned int) strtoul(buffer + strlen("procs_running"), NULL, 10);
-            break;
-         }
-      }
-   }
-
-   fclose(file);
-}
-
-static int scanCPUFrequencyFromSysCPUFreq(LinuxMachine* this) {
-   const Machine* super = &this->super;
-   int numCPUsWithFrequency = 0;
-   unsigned long totalFrequency = 0;
-
-   /*
-    * On some AMD and Intel CPUs read()ing scaling_cur_freq is quite slow (> 1ms). This delay
-    * accumulates for every core. For details see issue#471.
-    * If the read on CPU 0 takes longer than 500us bail out and fall back to reading the
-    * frequencies from /proc/cpuinfo.
-    * Once the condition has been met, bail out early for the next couple of scans.
-    */
-   static int timeout = 0;
-
-   if (timeout > 0) {
-      timeout--;
-      return -1;
-   }
-
-   for (unsigned int i = 0; i < super->existingCPUs; ++i) {
-      if (!Machine_isCPUonline(super, i))
-         continue;
-
-      char pathBuffer[64];
-      xSnprintf(pathBuffer, sizeof(pathBuffer), "/sys/devices/system/cpu/cpu%u/cpufreq/scaling_cur_freq", i);
-
-      struct timespec start;
-      if (i == 0)
-         clock_gettime(CLOCK_MONOTONIC, &start);
-
-      FILE* file = fopen(pathBuffer, "r");
-      if (!file)
-         return -errno;
-
-      unsigned long frequency;
-      if (fscanf(file, "%lu", &frequency) == 1) {
-         /* convert kHz to MHz */
-         frequency = frequency / 1000;
-         this->cpuData[i + 1].frequency = frequency;
-         numCPUsWithFrequency++;
-         totalFrequency += frequency;
-      }
-
-      fclose(file);
-
-      if (i == 0) {
-         struct timespec end;
-         clock_gettime(CLOCK_MONOTONIC, &end);
-         const time_t timeTakenUs = (end.tv_sec - start.tv_sec) * 1000000 + (end.tv_nsec - start.tv_nsec) / 1000;
-         if (timeTakenUs > 500) {
-            timeout = 30;
-            return -1;
-         }
+   for (; *line; line = ProcFile_nextLine(line)) {
+      if (String_startsWith(line, "procs_running")) {
+         unsigned long long int running = 0;
+         (void) ProcFile_parseNumber(ProcFile_skipSpaces(line + strlen("procs_running")), &running);
+         this->runningTasks = (unsigned int) running;
+         break;
       }
    }
-
-   if (numCPUsWithFrequency > 0)
-      this->cpuData[0].frequency = (double)totalFrequency / numCPUsWithFrequency;
-
-   return 0;
 }
 
 static void scanCPUFrequencyFromCPUinfo(LinuxMachine* this) {
@@ -803,6 +737,73 @@ static void LinuxMachine_assignCCDs(LinuxMachine* this, int ccds) {
    }
 }
 
+static void LinuxMachine_assignNodeCPUs(LinuxMachine* this, int node, const char* cpulist) {
+   /* cpulist is a comma-separated list of ranges, e.g. "0-3,8-11" */
+   const Machine* super = &this->super;
+   const char* p = cpulist;
+
+   while (*p >= '0' && *p <= '9') {
+      char* endp;
+      unsigned long first = strtoul(p, &endp, 10);
+      unsigned long last = first;
+      if (*endp == '-')
+         last = strtoul(endp + 1, &endp, 10);
+
+      for (unsigned long cpu = first; cpu <= last && cpu < super->existingCPUs; cpu++)
+         this->cpuData[cpu + 1].nodeID = node;
+
+      if (*endp != ',')
+         break;
+      p = endp + 1;
+   }
+}
+
+static void LinuxMachine_fetchCPUNodes(LinuxMachine* this) {
+   const Machine* super = &this->super;
+
+   for (size_t i = 0; i <= super->existingCPUs; i++)
+      this->cpuData[i].nodeID = 0;
+
+#ifdef HAVE_LIBHWLOC
+   if (super->topologyOk) {
+      for (unsigned int i = 0; i < super->existingCPUs; i++) {
+         hwloc_obj_t pu = hwloc_get_pu_obj_by_os_index(super->topology, i);
+         if (pu && pu->nodeset) {
+            int node = hwloc_bitmap_first(pu->nodeset);
+            if (node >= 0)
+               this->cpuData[i + 1].nodeID = node;
+         }
+      }
+      return;
+   }
+#endif
+
+   DIR* dir = opendir("/sys/devices/system/node");
+   if (!dir)
+      return;
+
+   const struct dirent* entry;
+   while ((entry = readdir(dir)) != NULL) {
+      if (!String_startsWith(entry->d_name, "node"))
+         continue;
+
+      char* endp;
+      unsigned long int node = strtoul(entry->d_name + 4, &endp, 10);
+      if (node >= INT_MAX || endp == entry->d_name + 4 || *endp != '\0')
+         continue;
+
+      char path[64];
+      char cpulist[1024];
+      xSnprintf(path, sizeof(path), "/sys/devices/system/node/%s/cpulist", entry->d_name);
+      if (Compat_readfile(path, cpulist, sizeof(cpulist)) < 1)
+         continue;
+
+      LinuxMachine_assignNodeCPUs(this, (int)node, cpulist);
+   }
+
+   closedir(dir);
+}
+
 static void LinuxMachine_computeThreadIndices(LinuxMachine* this) {
    /* For SMT/Hyperthreading: compute the thread index for each CPU.
       CPUs sharing the same physicalID and coreID are SMT siblings.
@@ -855,33 +856,67 @@ static void LinuxMachine_scanCPUFrequency(LinuxMachine* this) {
    for (unsigned int i = 0; i <= super->existingCPUs; i++)
       this->cpuData[i].frequency = NAN;
 
-   if (scanCPUFrequencyFromSysCPUFreq(this) == 0)
+   if (!CPUFreqSampler_sample(&this->cpuFreq, super)) {
+      scanCPUFrequencyFromCPUinfo(this);
       return;
+   }
+
+   int numCPUsWithFrequency = 0;
+   double totalFrequency = 0;
+
+   for (unsigned int i = 0; i < super->existingCPUs; i++) {
+      double frequency = CPUFreqSampler_get(&this->cpuFreq, i);
+      if (!isNonnegative(frequency))
+         continue;
+
+      this->cpuData[i + 1].frequency = frequency;
+      numCPUsWithFrequency++;
+      totalFrequency += frequency;
+   }
 
-   scanCPUFrequencyFromCPUinfo(this);
+   if (numCPUsWithFrequency > 0)
+      this->cpuData[0].frequency = totalFrequency / numCPUsWithFrequency;
 }
 
 void Machine_scan(Machine* super) {
    LinuxMachine* this = (LinuxMachine*) super;
 
+   PROFILER_BEGIN(memoryPhase, "LinuxMachine_scanMemoryInfo", true);
    LinuxMachine_scanMemoryInfo(this);
+   PROFILER_END(memoryPhase);
+   PROFILER_BEGIN(zswapPhase, "LinuxMachine_scanZswapInfo", true);
    LinuxMachine_scanZswapInfo(this);
+   PROFILER_END(zswapPhase);
+   PROFILER_BEGIN(hugePagesPhase, "LinuxMachine_scanHugePages", true);
    LinuxMachine_scanHugePages(this);
+   PROFILER_END(hugePagesPhase);
+   PROFILER_BEGIN(zfsPhase, "LinuxMachine_scanZfsArcstats", true);
    LinuxMachine_scanZfsArcstats(this);
+   PROFILER_END(zfsPhase);
+   PROFILER_BEGIN(zramPhase, "LinuxMachine_scanZramInfo", true);
    LinuxMachine_scanZramInfo(this);
+   PROFILER_END(zramPhase);
+   PROFILER_BEGIN(cpuTimePhase, "LinuxMachine_scanCPUTime", true);
    LinuxMachine_scanCPUTime(this);
+   PROFILER_END(cpuTimePhase);
 
    const Settings* settings = super->settings;
    if (settings->showCPUFrequency
 #ifdef HAVE_SENSORS_SENSORS_H
        || settings->showCPUTemperature
 #endif
-   )
+   ) {
+      PROFILER_BEGIN(cpuFreqPhase, "LinuxMachine_scanCPUFrequency", true);
       LinuxMachine_scanCPUFrequency(this);
+      PROFILER_END(cpuFreqPhase);
+   }
 
    #ifdef HAVE_SENSORS_SENSORS_H
-   if (settings->showCPUTemperature)
+   if (settings->showCPUTemperature) {
+      PROFILER_BEGIN(sensorsPhase, "LibSensors_getCPUTemperatures", true);
       LibSensors_getCPUTemperatures(this->cpuData, super->existingCPUs, super->activeCPUs);
+      PROFILER_END(sensorsPhase);
+   }
    #endif
 }
 
@@ -927,6 +962,10 @@ Machine* Machine_new(UsersTable* usersTable, uid_t userId) {
    // Initialize CPU count
    LinuxMachine_updateCPUcount(this);
 
+   CPUFreqSampler_init(&this->cpuFreq);
+   ProcFile_init(&this->statFile, PROCSTATFILE);
+   ProcFile_init(&this->meminfoFile, PROCMEMINFOFILE);
+
    // Fetch CPU topology
    int ccds = 0;
    LinuxMachine_fetchCPUTopologyFromCPUinfo(this);
@@ -934,6 +973,7 @@ Machine* Machine_new(UsersTable* usersTable, uid_t userId) {
    ccds = LibSensors_countCCDs();
    #endif
    LinuxMachine_assignCCDs(this, ccds);
+   LinuxMachine_fetchCPUNodes(this);
    LinuxMachine_computeThreadIndices(this);
 
    return super;
@@ -945,6 +985,10 @@ void Machine_delete(Machine* super) {
 
    Machine_done(super);
 
+   CPUFreqSampler_done(&this->cpuFreq);
+   ProcFile_done(&this->statFile);
+   ProcFile_done(&this->meminfoFile);
+
    while (gpuEngineData) {
       GPUEngineData* next = gpuEngineData->next;
       free(gpuEngineData->key);
@@ -11,6 +11,8 @@ in the source distribution for its full text.
 #include <stddef.h>
 
 #include "Machine.h"
+#include "linux/CPUFreqSampler.h"
+#include "linux/ProcFile.h"
 #include "linux/ZramStats.h"
 #include "linux/ZswapStats.h"
 #include "zfs/ZfsArcStats.h"
@@ -54,6 +56,7 @@ typedef struct CPUData_ {
    int physicalID;      /* different for each CPU socket */
    int coreID;          /* same for hyperthreading */
    int ccdID;           /* same for each AMD chiplet */
+   int nodeID;          /* NUMA node */
    int coreIndex;       /* Normalized physical core ID */
    int threadIndex;     /* SMT thread index: 0 for first thread, 1 for second, etc. */
 
@@ -86,6 +89,10 @@ typedef struct LinuxMachine_ {
    memory_t availableMem;
 
    CPUData* cpuData;
+   CPUFreqSampler cpuFreq;
+
+   ProcFile statFile;
+   ProcFile meminfoFile;
 
    int maxPhysicalID;
    int maxCoreID;
@@ -16,6 +16,7 @@ in the source distribution for its full text.
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <syscall.h>
 #include <unistd.h>
 
@@ -27,6 +28,7 @@ in the source distribution for its full text.
 #include "RowField.h"
 #include "Scheduling.h"
 #include "Settings.h"
+#include "XUtils.h"
 #include "linux/Compat.h"
 #include "linux/IOPriority.h"
 #include "linux/LinuxMachine.h"
@@ -107,21 +109,33 @@ const ProcessFieldData Process_fields[LAST_PROCESSFIELD] = {
 #endif
    [GPU_TIME] = { .name = "GPU_TIME", .title = "GPU_TIME ", .description = "Total GPU time", .flags = PROCESS_FLAG_LINUX_GPU, .defaultSortDesc = true, },
    [GPU_PERCENT] = { .name = "GPU_PERCENT", .title = " GPU% ", .description = "Percentage of the GPU time the process used in the last sampling", .flags = PROCESS_FLAG_LINUX_GPU, .defaultSortDesc = true, },
+   [NUMA_HOME] = { .name = "NUMA_HOME", .title = "HOME ", .description = "NUMA node holding most of the process's pages", .flags = PROCESS_FLAG_LINUX_NUMA, },
+   [M_NUMA_REMOTE] = { .name = "M_NUMA_REMOTE", .title = " RMEM ", .description = "Memory of the process placed outside its home NUMA node", .flags = PROCESS_FLAG_LINUX_NUMA, .defaultSortDesc = true, },
+   [NUMA_PAGES] = { .name = "NUMA_PAGES", .title = "NUMA%        ", .description = "Share of the process's pages on each NUMA node, in node order", .flags = PROCESS_FLAG_LINUX_NUMA, },
+   [NUMA_MEMS] = { .name = "NUMA_MEMS", .title = "MEMS     ", .description = "NUMA nodes the process may allocate memory from (Mems_allowed_list)", .flags = PROCESS_FLAG_LINUX_NUMA, },
+   [SOCK_ESTABLISHED] = { .name = "SOCK_ESTABLISHED", .title = "ESTAB ", .description = "Established TCP connections of the process", .flags = PROCESS_FLAG_LINUX_SOCKETS, .defaultSortDesc = true, },
+   [SOCK_LISTEN] = { .name = "SOCK_LISTEN", .title = "LISTN ", .description = "Listening TCP sockets of the process", .flags = PROCESS_FLAG_LINUX_SOCKETS, .defaultSortDesc = true, },
+   [SOCKETS] = { .name = "SOCKETS", .title = "SOCKS ", .description = "Open sockets of any family and state", .flags = PROCESS_FLAG_LINUX_SOCKETS, .defaultSortDesc = true, },
+   [FD_COUNT] = { .name = "FD_COUNT", .title = "  FDS ", .description = "Open file descriptors of the process", .flags = PROCESS_FLAG_LINUX_FDCOUNT, .defaultSortDesc = true, },
+   [WCHAN] = { .name = "WCHAN", .title = "WCHAN               ", .description = "Kernel function a task in state D or S waits in", .flags = PROCESS_FLAG_LINUX_WCHAN, },
 };
 
 Process* LinuxProcess_new(const Machine* host) {
    LinuxProcess* this = xCalloc(1, sizeof(LinuxProcess));
    Object_setClass(this, Class(LinuxProcess));
    Process_init(&this->super, host);
+   this->numa_home = -1;
+   this->sock_tcp_established = -1;
+   this->sock_tcp_listen = -1;
+   this->sock_total = -1;
+   this->fd_count = -1;
    return (Process*)this;
 }
 
 void Process_delete(Object* cast) {
    LinuxProcess* this = (LinuxProcess*) cast;
    Process_done((Process*)cast);
-   free(this->container_short);
-   free(this->cgroup_short);
-   free(this->cgroup);
+   CGroupName_release(this->cgroup);
    free(this->secattr);
    free(this);
 }
@@ -175,6 +189,32 @@ bool LinuxProcess_rowSetIOPriority(Row* super, Arg ioprio) {
    return LinuxProcess_setIOPriority(p, ioprio);
 }
 
+char LinuxProcess_readTaskState(pid_t pid, pid_t tid) {
+   char path[64];
+   xSnprintf(path, sizeof(path), PROCDIR "/%d/task/%d/stat", pid, tid);
+
+   char buffer[512];
+   if (Compat_readfile(path, buffer, sizeof(buffer)) <= 0)
+      return 0;
+
+   /* the command may contain anything, the state follows its closing parenthesis */
+   const char* end = strrchr(buffer, ')');
+   return end && end[1] == ' ' ? end[2] : 0;
+}
+
+bool LinuxProcess_readWchan(pid_t pid, pid_t tid, char* buffer, size_t size) {
+   char path[64];
+   xSnprintf(path, sizeof(path), PROCDIR "/%d/task/%d/wchan", pid, tid);
+
+   ssize_t len = Compat_readfile(path, buffer, size);
+   if (len <= 0)
+      return false;
+
+   buffer[strcspn(buffer, "\n")] = '\0';
+   /* "0" when running or when the address is hidden from us */
+   return buffer[0] && !String_eq(buffer, "0");
+}
+
 bool LinuxProcess_isAutogroupEnabled(void) {
    char buf[16];
    if (Compat_readfile(PROCDIR "/sys/kernel/sched_autogroup_enabled", buf, sizeof(buf)) < 0)
@@ -210,7 +250,19 @@ bool LinuxProcess_rowChangeAutogroupPriorityBy(Row* super, Arg delta) {
    return LinuxProcess_changeAutogroupPriorityBy(p, delta);
 }
 
-static double LinuxProcess_totalIORate(const LinuxProcess* lp) {
+static const char* LinuxProcess_cgroupPath(const LinuxProcess* lp) {
+   return lp->cgroup ? lp->cgroup->path : NULL;
+}
+
+static const char* LinuxProcess_cgroupShortName(const LinuxProcess* lp) {
+   return lp->cgroup ? lp->cgroup->shortName : NULL;
+}
+
+static const char* LinuxProcess_cgroupContainer(const LinuxProcess* lp) {
+   return lp->cgroup ? lp->cgroup->container : NULL;
+}
+
+double LinuxProcess_totalIORate(const LinuxProcess* lp) {
    double totalRate = NAN;
    if (isNonnegative(lp->io_rate_read_bps)) {
       totalRate = lp->io_rate_read_bps;
@@ -223,6 +275,32 @@ static double LinuxProcess_totalIORate(const LinuxProcess* lp) {
    return totalRate;
 }
 
+/* Rounded percentage of the process's pages on each node, as shown; false if unknown */
+static bool LinuxProcess_numaShares(const LinuxProcess* lp, long shares[LINUX_NUMA_MAX_NODES]) {
+   long total = 0;
+   for (unsigned int i = 0; i < lp->numa_nodes; i++)
+      total += lp->numa_kb[i];
+
+   if (total <= 0)
+      return false;
+
+   for (unsigned int i = 0; i < LINUX_NUMA_MAX_NODES; i++)
+      shares[i] = i < lp->numa_nodes ? (lp->numa_kb[i] * 100 + total / 2) / total : 0;
+   return true;
+}
+
+/* The shares as digits of one number, so rows sort by the share on node 0, then on node 1 and so on */
+static uint64_t LinuxProcess_numaPagesKey(const LinuxProcess* lp) {
+   long shares[LINUX_NUMA_MAX_NODES];
+   if (!LinuxProcess_numaShares(lp, shares))
+      return 0;
+
+   uint64_t key = 0;
+   for (unsigned int i = 0; i < LINUX_NUMA_MAX_NODES; i++)
+      key = key * 101 + (uint64_t)shares[i];
+   return key;
+}
+
 static void LinuxProcess_rowWriteField(const Row* super, RichString* str, ProcessField field) {
    const Process* this = (const Process*) super;
    const LinuxProcess* lp = (const LinuxProcess*) super;
@@ -269,17 +347,17 @@ static void LinuxProcess_rowWriteField(const Row* super, RichString* str, Proces
    case CNCLWB: Row_printBytes(str, lp->io_cancelled_write_bytes, coloring); return;
    case IO_READ_RATE:  Row_printRate(str, lp->io_rate_read_bps, coloring); return;
    case IO_WRITE_RATE: Row_printRate(str, lp->io_rate_write_bps, coloring); return;
-   case IO_RATE: Row_printRate(str, LinuxProcess_totalIORate(lp), coloring); return;
+   case IO_RATE: Row_printRate(str, Process_showsSubtree(this) ? this->subtree_io_rate : LinuxProcess_totalIORate(lp), coloring); return;
    case CGROUP:
-      xSnprintf(buffer, n, "%-*.*s ", Row_fieldWidths[CGROUP], Row_fieldWidths[CGROUP], lp->cgroup ? lp->cgroup : "N/A");
+      xSnprintf(buffer, n, "%-*.*s ", Row_fieldWidths[CGROUP], Row_fieldWidths[CGROUP], lp->cgroup ? lp->cgroup->path : "N/A");
       RichString_appendWide(str, attr, buffer);
       return;
    case CCGROUP:
-      xSnprintf(buffer, n, "%-*.*s ", Row_fieldWidths[CCGROUP], Row_fieldWidths[CCGROUP], lp->cgroup_short ? lp->cgroup_short : (lp->cgroup ? lp->cgroup : "N/A"));
+      xSnprintf(buffer, n, "%-*.*s ", Row_fieldWidths[CCGROUP], Row_fieldWidths[CCGROUP], LinuxProcess_cgroupShortName(lp) ? LinuxProcess_cgroupShortName(lp) : (lp->cgroup ? lp->cgroup->path : "N/A"));
       RichString_appendWide(str, attr, buffer);
       return;
    case CONTAINER:
-      xSnprintf(buffer, n, "%-*.*s ", Row_fieldWidths[CONTAINER], Row_fieldWidths[CONTAINER], lp->container_short ? lp->container_short : "N/A");
+      xSnprintf(buffer, n, "%-*.*s ", Row_fieldWidths[CONTAINER], Row_fieldWidths[CONTAINER], LinuxProcess_cgroupContainer(lp) ? LinuxProcess_cgroupContainer(lp) : "N/A");
       RichString_appendWide(str, attr, buffer);
       return;
    case OOM:
@@ -342,6 +420,69 @@ static void LinuxProcess_rowWriteField(const Row* super, RichString* str, Proces
          xSnprintf(buffer, n, "N/A ");
       }
       break;
+   case NUMA_HOME:
+      if (lp->numa_home >= 0) {
+         xSnprintf(buffer, n, "%4d ", lp->numa_home);
+      } else {
+         attr = CRT_colors[PROCESS_SHADOW];
+         xSnprintf(buffer, n, " N/A ");
+      }
+      break;
+   case M_NUMA_REMOTE:
+      if (lp->numa_home >= 0) {
+         Row_printKBytes(str, lp->m_numa_remote, coloring);
+         return;
+      }
+
+      attr = CRT_colors[PROCESS_SHADOW];
+      xSnprintf(buffer, n, "  N/A ");
+      break;
+   case NUMA_PAGES: {
+      long shares[LINUX_NUMA_MAX_NODES];
+      if (!LinuxProcess_numaShares(lp, shares)) {
+         attr = CRT_colors[PROCESS_SHADOW];
+         xSnprintf(buffer, n, "%-12s ", "N/A");
+         break;
+      }
+
+      char pages[64] = "";
+      size_t len = 0;
+      for (unsigned int i = 0; i < lp->numa_nodes && len < sizeof(pages); i++)
+         len += (size_t)xSnprintf(pages + len, sizeof(pages) - len, "%s%ld", i ? "/" : "", shares[i]);
+      xSnprintf(buffer, n, "%-12.12s ", pages);
+      break;
+   }
+   case NUMA_MEMS:
+      if (!lp->numa_mems[0])
+         attr = CRT_colors[PROCESS_SHADOW];
+      xSnprintf(buffer, n, "%-8.8s ", lp->numa_mems[0] ? lp->numa_mems : "N/A");
+      break;
+   case WCHAN:
+      if (!lp->wchan[0]) {
+         attr = CRT_colors[PROCESS_SHADOW];
+         xSnprintf(buffer, n, "%-19s ", "-");
+      } else {
+         xSnprintf(buffer, n, "%-19.19s ", lp->wchan);
+      }
+      break;
+   case SOCK_ESTABLISHED:
+   case SOCK_LISTEN:
+   case SOCKETS:
+   case FD_COUNT: {
+      int count = field == SOCK_ESTABLISHED ? lp->sock_tcp_established
+                : field == SOCK_LISTEN ? lp->sock_tcp_listen
+                : field == SOCKETS ? lp->sock_total
+                : lp->fd_count;
+      if (count < 0) {
+         attr = CRT_colors[PROCESS_SHADOW];
+         xSnprintf(buffer, n, "  N/A ");
+      } else {
+         if (count == 0)
+            attr = CRT_colors[PROCESS_SHADOW];
+         xSnprintf(buffer, n, "%5d ", count);
+      }
+      break;
+   }
    case ISCONTAINER:
       switch (this->isRunningInContainer) {
       case TRI_ON:
@@ -415,11 +556,17 @@ static int LinuxProcess_compareByKey(const Process* v1, const Process* v2, Proce
    case IO_RATE:
       return compareRealNumbers(LinuxProcess_totalIORate(p1), LinuxProcess_totalIORate(p2));
    case CGROUP:
-      return SPACESHIP_NULLSTR(p1->cgroup, p2->cgroup);
+      if (p1->cgroup == p2->cgroup)
+         return 0;
+      return SPACESHIP_NULLSTR(LinuxProcess_cgroupPath(p1), LinuxProcess_cgroupPath(p2));
    case CCGROUP:
-      return SPACESHIP_NULLSTR(p1->cgroup_short, p2->cgroup_short);
+      if (p1->cgroup == p2->cgroup)
+         return 0;
+      return SPACESHIP_NULLSTR(LinuxProcess_cgroupShortName(p1), LinuxProcess_cgroupShortName(p2));
    case CONTAINER:
-      return SPACESHIP_NULLSTR(p1->container_short, p2->container_short);
+      if (p1->cgroup == p2->cgroup)
+         return 0;
+      return SPACESHIP_NULLSTR(LinuxProcess_cgroupContainer(p1), LinuxProcess_cgroupContainer(p2));
    case OOM:
       return SPACESHIP_NUMBER(p1->oom, p2->oom);
    #ifdef HAVE_DELAYACCT
@@ -451,11 +598,88 @@ static int LinuxProcess_compareByKey(const Process* v1, const Process* v2, Proce
       return SPACESHIP_NUMBER(p1->gpu_time, p2->gpu_time);
    case ISCONTAINER:
       return SPACESHIP_NUMBER(v1->isRunningInContainer, v2->isRunningInContainer);
+   case NUMA_HOME:
+      return SPACESHIP_NUMBER(p1->numa_home, p2->numa_home);
+   case M_NUMA_REMOTE:
+      return SPACESHIP_NUMBER(p1->m_numa_remote, p2->m_numa_remote);
+   case NUMA_PAGES:
+      return SPACESHIP_NUMBER(LinuxProcess_numaPagesKey(p1), LinuxProcess_numaPagesKey(p2));
+   case NUMA_MEMS:
+      return strcmp(p1->numa_mems, p2->numa_mems);
+   case SOCK_ESTABLISHED:
+      return SPACESHIP_NUMBER(p1->sock_tcp_established, p2->sock_tcp_established);
+   case SOCK_LISTEN:
+      return SPACESHIP_NUMBER(p1->sock_tcp_listen, p2->sock_tcp_listen);
+   case SOCKETS:
+      return SPACESHIP_NUMBER(p1->sock_total, p2->sock_total);
+   case FD_COUNT:
+      return SPACESHIP_NUMBER(p1->fd_count, p2->fd_count);
+   case WCHAN:
+      return strcmp(p1->wchan, p2->wchan);
    default:
       return Process_compareByKey_Base(v1, v2, key);
    }
 }
 
+static bool LinuxProcess_sortKeyValue(const Process* super, ProcessField key, uint64_t* value) {
+   const LinuxProcess* lp = (const LinuxProcess*) super;
+
+   switch (key) {
+   case M_DRS: *value = Row_sortKeySigned(lp->m_drs); return true;
+   case M_LRS: *value = Row_sortKeySigned(lp->m_lrs); return true;
+   case M_TRS: *value = Row_sortKeySigned(lp->m_trs); return true;
+   case M_SHARE: *value = Row_sortKeySigned(lp->m_share); return true;
+   case M_PRIV: *value = Row_sortKeySigned(lp->m_priv); return true;
+   case M_PSS: *value = Row_sortKeySigned(lp->m_pss); return true;
+   case M_SWAP: *value = Row_sortKeySigned(lp->m_swap); return true;
+   case M_PSSWP: *value = Row_sortKeySigned(lp->m_psswp); return true;
+   case M_EPSS: *value = Row_sortKeySigned(lp->m_epss); return true;
+   case UTIME: *value = Row_sortKeyUnsigned(lp->utime); return true;
+   case CUTIME: *value = Row_sortKeyUnsigned(lp->cutime); return true;
+   case STIME: *value = Row_sortKeyUnsigned(lp->stime); return true;
+   case CSTIME: *value = Row_sortKeyUnsigned(lp->cstime); return true;
+   case RCHAR: *value = Row_sortKeyUnsigned(lp->io_rchar); return true;
+   case WCHAR: *value = Row_sortKeyUnsigned(lp->io_wchar); return true;
+   case SYSCR: *value = Row_sortKeyUnsigned(lp->io_syscr); return true;
+   case SYSCW: *value = Row_sortKeyUnsigned(lp->io_syscw); return true;
+   case RBYTES: *value = Row_sortKeyUnsigned(lp->io_read_bytes); return true;
+   case WBYTES: *value = Row_sortKeyUnsigned(lp->io_write_bytes); return true;
+   case CNCLWB: *value = Row_sortKeyUnsigned(lp->io_cancelled_write_bytes); return true;
+   case IO_READ_RATE: *value = Row_sortKeyReal(lp->io_rate_read_bps); return true;
+   case IO_WRITE_RATE: *value = Row_sortKeyReal(lp->io_rate_write_bps); return true;
+   case IO_RATE: *value = Row_sortKeyReal(LinuxProcess_totalIORate(lp)); return true;
+   case OOM: *value = Row_sortKeyUnsigned(lp->oom); return true;
+   #ifdef HAVE_DELAYACCT
+   case PERCENT_CPU_DELAY: *value = Row_sortKeyReal(lp->cpu_delay_percent); return true;
+   case PERCENT_IO_DELAY: *value = Row_sortKeyReal(lp->blkio_delay_percent); return true;
+   case PERCENT_SWAP_DELAY: *value = Row_sortKeyReal(lp->swapin_delay_percent); return true;
+   #endif
+   case IO_PRIORITY: *value = Row_sortKeySigned(LinuxProcess_effectiveIOPriority(lp)); return true;
+   case CTXT: *value = Row_sortKeyUnsigned(lp->ctxt_diff); return true;
+   case AUTOGROUP_ID: *value = Row_sortKeySigned(lp->autogroup_id); return true;
+   case AUTOGROUP_NICE: *value = Row_sortKeySigned(lp->autogroup_nice); return true;
+   case GPU_TIME: *value = Row_sortKeyUnsigned(lp->gpu_time); return true;
+   case ISCONTAINER: *value = Row_sortKeySigned(super->isRunningInContainer); return true;
+   case NUMA_HOME: *value = Row_sortKeySigned(lp->numa_home); return true;
+   case M_NUMA_REMOTE: *value = Row_sortKeySigned(lp->m_numa_remote); return true;
+   case NUMA_PAGES: *value = Row_sortKeyUnsigned(LinuxProcess_numaPagesKey(lp)); return true;
+   case SOCK_ESTABLISHED: *value = Row_sortKeySigned(lp->sock_tcp_established); return true;
+   case SOCK_LISTEN: *value = Row_sortKeySigned(lp->sock_tcp_listen); return true;
+   case SOCKETS: *value = Row_sortKeySigned(lp->sock_total); return true;
+   case FD_COUNT: *value = Row_sortKeySigned(lp->fd_count); return true;
+   case NUMA_MEMS:
+   case WCHAN:
+   case CGROUP:
+   case CCGROUP:
+   case CONTAINER:
+   case SECATTR:
+   case GPU_PERCENT:
+      return false;
+   default:
+      return Process_sortKeyValue_Base(super, key, value);
+   }
+}
+
 const ProcessClass LinuxProcess_class = {
    .super = {
       .super = {
@@ -468,8 +692,12 @@ const ProcessClass LinuxProcess_class = {
       .isVisible = Process_rowIsVisible,
       .matchesFilter = Process_rowMatchesFilter,
       .compareByParent = Process_compareByParent,
+      .subtreeReset = Process_subtreeReset,
+      .subtreeAdd = Process_subtreeAdd,
+      .sortKeyValue = Process_rowSortKeyValue,
       .sortKeyString = Process_rowGetSortKey,
       .writeField = LinuxProcess_rowWriteField
    },
-   .compareByKey = LinuxProcess_compareByKey
+   .compareByKey = LinuxProcess_compareByKey,
+   .sortKeyValue = LinuxProcess_sortKeyValue
 };
@@ -9,12 +9,15 @@ in the source distribution for its full text.
 */
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <sys/types.h>
 
 #include "Machine.h"
 #include "Object.h"
 #include "Process.h"
 #include "Row.h"
 
+#include "linux/CGroupUtils.h"
 #include "linux/IOPriority.h"
 
 
@@ -29,6 +32,13 @@ in the source distribution for its full text.
 #define PROCESS_FLAG_LINUX_AUTOGROUP 0x00080000
 #define PROCESS_FLAG_LINUX_GPU       0x00100000
 #define PROCESS_FLAG_LINUX_CONTAINER 0x00200000
+#define PROCESS_FLAG_LINUX_NUMA      0x00400000
+#define PROCESS_FLAG_LINUX_SOCKETS   0x00800000
+#define PROCESS_FLAG_LINUX_FDCOUNT   0x01000000
+#define PROCESS_FLAG_LINUX_WCHAN     0x02000000
+
+/* NUMA nodes listed per process; pages on higher nodes only count as remote */
+#define LINUX_NUMA_MAX_NODES 8
 
 typedef struct LinuxProcess_ {
    Process super;
@@ -49,6 +59,9 @@ typedef struct LinuxProcess_ {
    long m_drs;
    long m_lrs;
 
+   /* Start time in clock ticks since boot; tells a reused pid apart */
+   unsigned long long int starttime;
+
    /* Process flags */
    unsigned long int flags;
 
@@ -82,9 +95,11 @@ typedef struct LinuxProcess_ {
    /* Storage data written (in bytes per second) */
    double io_rate_write_bps;
 
-   char* cgroup;
-   char* cgroup_short;
-   char* container_short;
+   /* Interned, shared with every other process in the same cgroups */
+   CGroupName* cgroup;
+   /* Group of the cgroup rollup this process was last counted in; reset when the cgroup changes */
+   struct CGroupRollupGroup_* rollup_group;
+   unsigned int rollup_generation;
    unsigned int oom;
    #ifdef HAVE_DELAYACCT
    unsigned long long int delay_read_time;
@@ -110,6 +125,27 @@ typedef struct LinuxProcess_ {
    /* Autogroup scheduling (CFS) information */
    long int autogroup_id;
    int autogroup_nice;
+
+   /* NUMA placement from /proc/<pid>/numa_maps, in kibibytes */
+   int numa_home;                           /* node with most pages, -1 if unknown */
+   unsigned int numa_nodes;                 /* entries used in numa_kb */
+   long numa_kb[LINUX_NUMA_MAX_NODES];
+   long m_numa_remote;                      /* resident outside the home node */
+   char numa_mems[16];                      /* Mems_allowed_list from /proc/<pid>/status */
+
+   /* Socket descriptors, recounted once per socket scan period; -1 if unknown */
+   int sock_tcp_established;
+   int sock_tcp_listen;
+   int sock_total;
+   unsigned int sock_epoch;                 /* scan period the counts are from */
+
+   /* Open descriptors, recounted once per slow scan period; -1 if unknown */
+   int fd_count;
+   unsigned int fd_epoch;
+
+   /* Kernel function a D or S task waits in; empty for other states */
+   char wchan[40];
+   unsigned int wchan_epoch;                /* slow scan period of the last read while sleeping */
 } LinuxProcess;
 
 extern int pageSize;
@@ -132,6 +168,20 @@ bool LinuxProcess_isAutogroupEnabled(void);
 
 bool LinuxProcess_rowChangeAutogroupPriorityBy(Row* super, Arg delta);
 
+/* Tasks whose wait channel and kernel stack are worth reading */
+static inline bool LinuxProcess_isWaitingState(ProcessState state) {
+   return state == UNINTERRUPTIBLE_WAIT || state == SLEEPING;
+}
+
+/* Reads a task state letter from PROCDIR/<pid>/task/<tid>/stat; 0 if unavailable */
+char LinuxProcess_readTaskState(pid_t pid, pid_t tid);
+
+/* Reads the wait channel of a task into buffer; false if unknown or not waiting */
+bool LinuxProcess_readWchan(pid_t pid, pid_t tid, char* buffer, size_t size);
+
+/* Storage read and write rate in bytes per second, NAN if unknown */
+double LinuxProcess_totalIORate(const LinuxProcess* lp);
+
 bool Process_isThread(const Process* this);
 
 #endif
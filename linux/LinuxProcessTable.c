@@ -13,10 +13,12 @@ in the source distribution for its full text.
 #include <assert.h>
 #include <ctype.h>
 #include <dirent.h>
+#include <errno.h>
 #include <fcntl.h>
 #include <inttypes.h>
 #include <limits.h>
 #include <math.h>
+#include <signal.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdio.h>
@@ -33,6 +35,7 @@ in the source distribution for its full text.
 #include "Macros.h"
 #include "Object.h"
 #include "Process.h"
+#include "Profiler.h"
 #include "Row.h"
 #include "RowField.h"
 #include "Scheduling.h"
@@ -258,6 +261,93 @@ finish:
    this->ttyDrivers = ttyDrivers;
 }
 
+/*
+ * Only tasks in D or S have a meaningful wait channel. Uninterruptible
+ * ones are what one looks for in an IO stall and are read every refresh;
+ * the many interruptibly sleeping ones are read once per slow scan period.
+ */
+static void LinuxProcessTable_readWchan(const LinuxProcessTable* this, LinuxProcess* process, openat_arg_t procFd) {
+   ProcessState state = process->super.state;
+   if (!LinuxProcess_isWaitingState(state)) {
+      process->wchan[0] = '\0';
+      return;
+   }
+
+   if (state == SLEEPING && process->wchan_epoch == this->slowScanEpoch)
+      return;
+
+   process->wchan_epoch = this->slowScanEpoch;
+
+   char buffer[sizeof(process->wchan)];
+   if (Compat_readfileat(procFd, "wchan", buffer, sizeof(buffer)) <= 0) {
+      process->wchan[0] = '\0';
+      return;
+   }
+
+   buffer[strcspn(buffer, "\n")] = '\0';
+   /* "0" when the task just woke up or the address is hidden from us */
+   if (String_eq(buffer, "0"))
+      buffer[0] = '\0';
+   memcpy(process->wchan, buffer, sizeof(process->wchan));
+}
+
+/*
+ * Count the descriptors in /proc/<pid>/fd (process-shared data). Since
+ * Linux 6.2 the directory size is the descriptor count, so a single stat
+ * is enough; older kernels report 0 and the directory is walked instead.
+ */
+static void LinuxProcessTable_readFdCount(LinuxProcess* process, openat_arg_t procFd) {
+   process->fd_count = -1;
+
+   struct stat sb;
+#if defined(HAVE_OPENAT) && defined(HAVE_FSTATAT)
+   int res = fstatat(procFd, "fd", &sb, 0);
+#else
+   char path[PATH_MAX];
+   xSnprintf(path, sizeof(path), "%s/fd", procFd);
+   int res = stat(path, &sb);
+#endif
+   if (res != 0)
+      return;
+
+   if (sb.st_size > 0) {
+      process->fd_count = sb.st_size > INT_MAX ? INT_MAX : (int)sb.st_size;
+      return;
+   }
+
+#ifdef HAVE_OPENAT
+   int fdDirFd = openat(procFd, "fd", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+   if (fdDirFd < 0)
+      return;
+   DIR* dir = fdopendir(fdDirFd);
+   if (!dir) {
+      close(fdDirFd);
+      return;
+   }
+#else
+   DIR* dir = opendir(path);
+   if (!dir)
+      return;
+#endif
+
+   int count = 0;
+   for (const struct dirent* entry; (entry = readdir(dir)); ) {
+      if (entry->d_name[0] != '.')
+         count++;
+   }
+   closedir(dir);
+
+   process->fd_count = count;
+}
+
+static void LinuxProcessTable_dropSocketTables(LinuxProcessTable* this) {
+   for (size_t i = 0; i < this->socketNamespaceCount; i++)
+      SocketTable_done(&this->socketNamespaces[i].sockets);
+   free(this->socketNamespaces);
+   this->socketNamespaces = NULL;
+   this->socketNamespaceCount = 0;
+}
+
 ProcessTable* ProcessTable_new(Machine* host, Hashtable* pidMatchList) {
    LinuxProcessTable* this = xCalloc(1, sizeof(LinuxProcessTable));
    Object_setClass(this, Class(ProcessTable));
@@ -293,6 +383,7 @@ void ProcessTable_delete(Object* cast) {
       }
       free(this->ttyDrivers);
    }
+   LinuxProcessTable_dropSocketTables(this);
    #ifdef HAVE_DELAYACCT
    LibNl_destroyNetlinkSocket(this);
    #endif
@@ -512,12 +603,10 @@ static bool LinuxProcessTable_readStatFile(LinuxProcess* lp, openat_arg_t procFd
    location += 1;
 
    /* (22) starttime  -  %llu */
-   if (process->starttime_ctime == 0) {
-      process->starttime_ctime = lhost->boottime + LinuxProcessTable_adjustTime(lhost, fast_strtoll_dec(&location, 0)) / 100;
-   } else {
-      location = strchr(location, ' ');
-      if (!location)
-         return false;
+   unsigned long long int starttime = fast_strtoull_dec(&location, 0);
+   if (process->starttime_ctime == 0 || starttime != lp->starttime) {
+      lp->starttime = starttime;
+      process->starttime_ctime = lhost->boottime + LinuxProcessTable_adjustTime(lhost, starttime) / 100;
    }
    location += 1;
 
@@ -578,6 +667,16 @@ static bool LinuxProcessTable_readStatusFile(Process* process, openat_arg_t proc
          if (pid_ns_count > 1)
             process->isRunningInContainer = TRI_ON;
 
+      } else if (String_startsWith(buffer, "Mems_allowed_list:")) {
+         const char* list = buffer + strlen("Mems_allowed_list:");
+         while (*list == ' ' || *list == '\t')
+            list++;
+
+         String_safeStrncpy(lp->numa_mems, list, sizeof(lp->numa_mems));
+         char* newline = strchr(lp->numa_mems, '\n');
+         if (newline)
+            *newline = '\0';
+
       } else if (String_startsWith(buffer, "voluntary_ctxt_switches:")) {
          unsigned long vctxt;
          int ok = sscanf(buffer, "voluntary_ctxt_switches:\t%lu", &vctxt);
@@ -912,31 +1011,179 @@ static bool LinuxProcessTable_readSmapsFile(LinuxProcess* process, openat_arg_t
    return true;
 }
 
+/*
+ * Read /proc/<pid>/numa_maps (process-shared data)
+ */
+static bool LinuxProcessTable_readNumaMapsFile(LinuxProcess* process, openat_arg_t procFd) {
+   FILE* fp = fopenat(procFd, "numa_maps", "r");
+   if (!fp)
+      return false;
+
+   long kb[LINUX_NUMA_MAX_NODES] = { 0 };
+   long otherKb = 0;
+   unsigned int nodes = 0;
+
+   char* line;
+   while ((line = String_readLine(fp))) {
+      /* tokens look like "N1=342"; the page size follows them on the same line */
+      unsigned long pages[LINUX_NUMA_MAX_NODES] = { 0 };
+      unsigned long otherPages = 0;
+      unsigned long pageKb = 4;
+
+      for (const char* token = line; token; token = strchr(token, ' ')) {
+         while (*token == ' ')
+            token++;
+
+         char* endp;
+         if (token[0] == 'N' && isdigit((unsigned char)token[1])) {
+            unsigned long node = strtoul(token + 1, &endp, 10);
+            if (*endp != '=')
+               continue;
+
+            unsigned long count = strtoul(endp + 1, NULL, 10);
+            if (node < LINUX_NUMA_MAX_NODES) {
+               pages[node] += count;
+               nodes = MAXIMUM(nodes, (unsigned int)node + 1);
+            } else {
+               otherPages += count;
+            }
+         } else if (String_startsWith(token, "kernelpagesize_kB=")) {
+            pageKb = strtoul(token + strlen("kernelpagesize_kB="), NULL, 10);
+         }
+      }
+
+      for (unsigned int i = 0; i < nodes; i++)
+         kb[i] += (long)(pages[i] * pageKb);
+      otherKb += (long)(otherPages * pageKb);
+
+      free(line);
+   }
+
+   fclose(fp);
+
+   int home = -1;
+   long total = otherKb;
+   for (unsigned int i = 0; i < nodes; i++) {
+      total += kb[i];
+      if (home < 0 || kb[i] > kb[home])
+         home = (int)i;
+   }
+
+   memcpy(process->numa_kb, kb, sizeof(kb));
+   process->numa_nodes = nodes;
+   process->numa_home = home;
+   process->m_numa_remote = home >= 0 ? total - kb[home] : 0;
+   return true;
+}
+
+/* The TCP sockets of the network namespace of the process, read on first use in a scan period */
+static const SocketTable* LinuxProcessTable_getSocketTable(LinuxProcessTable* this, openat_arg_t procFd, pid_t pid) {
+   struct stat sb;
+#if defined(HAVE_OPENAT) && defined(HAVE_FSTATAT)
+   int res = fstatat(procFd, "ns/net", &sb, 0);
+#else
+   char path[PATH_MAX];
+   xSnprintf(path, sizeof(path), "%s/ns/net", procFd);
+   int res = stat(path, &sb);
+#endif
+   if (res != 0)
+      return NULL;
+
+   for (size_t i = 0; i < this->socketNamespaceCount; i++) {
+      if (this->socketNamespaces[i].inode == sb.st_ino)
+         return &this->socketNamespaces[i].sockets;
+   }
+
+   this->socketNamespaces = xReallocArray(this->socketNamespaces, this->socketNamespaceCount + 1, sizeof(LinuxSocketNamespace));
+   LinuxSocketNamespace* ns = &this->socketNamespaces[this->socketNamespaceCount++];
+   ns->inode = sb.st_ino;
+   SocketTable_read(&ns->sockets, pid, (1U << SOCKET_TCP) | (1U << SOCKET_TCP6));
+   return &ns->sockets;
+}
+
+/*
+ * Count the sockets in /proc/<pid>/fd (process-shared data). Only the links
+ * are read; the TCP state comes from the table of the network namespace.
+ */
+static void LinuxProcessTable_readSockets(LinuxProcessTable* this, LinuxProcess* process, openat_arg_t procFd) {
+   process->sock_tcp_established = -1;
+   process->sock_tcp_listen = -1;
+   process->sock_total = -1;
+
+#ifdef HAVE_OPENAT
+   int fdDirFd = openat(procFd, "fd", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+   if (fdDirFd < 0)
+      return;
+   DIR* dir = fdopendir(fdDirFd);
+   if (!dir) {
+      close(fdDirFd);
+      return;
+   }
+   openat_arg_t fdDir = fdDirFd;
+#else
+   char fdDir[4096];
+   xSnprintf(fdDir, sizeof(fdDir), "%s/fd", procFd);
+   DIR* dir = opendir(fdDir);
+   if (!dir)
+      return;
+#endif
+
+   const SocketTable* sockets = NULL;
+   int established = 0;
+   int listen = 0;
+   int total = 0;
+
+   for (const struct dirent* entry; (entry = readdir(dir)); ) {
+      if (entry->d_name[0] == '.')
+         continue;
+
+      char link[32];
+      ssize_t len = Compat_readlink(fdDir, entry->d_name, link, sizeof(link) - 1);
+      if (len <= 0)
+         continue;
+      link[len] = '\0';
+
+      if (!String_startsWith(link, "socket:["))
+         continue;
+
+      total++;
+      if (!sockets)
+         sockets = LinuxProcessTable_getSocketTable(this, procFd, Process_getPid(&process->super));
+      if (!sockets)
+         continue;
+
+      const SocketEntry* socket = SocketTable_find(sockets, strtoull(link + strlen("socket:["), NULL, 10));
+      if (!socket)
+         continue;
+
+      if (socket->state == SOCKET_TCP_ESTABLISHED)
+         established++;
+      else if (socket->state == SOCKET_TCP_LISTEN)
+         listen++;
+   }
+
+   closedir(dir);
+
+   process->sock_tcp_established = established;
+   process->sock_tcp_listen = listen;
+   process->sock_total = total;
+}
+
 /*
  * Read /proc/<pid>/cgroup (thread-specific data)
  */
 static void LinuxProcessTable_readCGroupFile(LinuxProcess* process, openat_arg_t procFd) {
    FILE* file = fopenat(procFd, "cgroup", "r");
    if (!file) {
-      if (process->cgroup) {
-         free(process->cgroup);
-         process->cgroup = NULL;
-      }
-      if (process->cgroup_short) {
-         free(process->cgroup_short);
-         process->cgroup_short = NULL;
-      }
-      if (process->container_short) {
-         free(process->container_short);
-         process->container_short = NULL;
-      }
+      CGroupName_release(process->cgroup);
+      process->cgroup = NULL;
+      process->rollup_group = NULL;
       return;
    }
    char output[PROC_LINE_LENGTH + 1];
-   output[0] = '\0';
-   char* at = output;
-   size_t left = PROC_LINE_LENGTH;
-   while (!feof(file) && left > 0) {
+   const size_t maxLen = PROC_LINE_LENGTH - 1;
+   size_t len = 0;
+   while (!feof(file) && len < maxLen) {
       char buffer[PROC_LINE_LENGTH + 1];
       const char* ok = fgets(buffer, PROC_LINE_LENGTH, file);
       if (!ok)
@@ -950,70 +1197,36 @@ static void LinuxProcessTable_readCGroupFile(LinuxProcess* process, openat_arg_t
          group++;
       }
 
-      const char* eol = String_strchrnul(group, '\n');
-      char* eol_w = &buffer[eol - buffer];
-      *eol_w = '\0';
+      size_t groupLen = (size_t)(String_strchrnul(group, '\n') - group);
 
-      if (at != output) {
-         *at = ';';
-         at++;
-         left--;
-      }
+      if (len > 0)
+         output[len++] = ';';
+
+      size_t copied = MINIMUM(groupLen, maxLen - len);
+      memcpy(&output[len], group, copied);
+      len += copied;
 
-      int wrote = snprintf(at, left, "%s", group);
-      if (wrote < 0 || (size_t)wrote >= left) {
+      if (copied < groupLen) {
          // Output was truncated, we are done
          break;
       }
-
-      at += (size_t)wrote;
-      left -= (size_t)wrote;
    }
    fclose(file);
 
-   bool changed = !process->cgroup || !String_eq(process->cgroup, output);
-
-   Row_updateFieldWidth(CGROUP, strlen(output));
-   free_and_xStrdup(&process->cgroup, output);
-
-   if (!changed) {
-      if (process->cgroup_short) {
-         Row_updateFieldWidth(CCGROUP, strlen(process->cgroup_short));
-      } else {
-         //CCGROUP is alias to normal CGROUP if shortening fails
-         Row_updateFieldWidth(CCGROUP, strlen(process->cgroup));
-      }
-      if (process->container_short) {
-         Row_updateFieldWidth(CONTAINER, strlen(process->container_short));
-      } else {
-         Row_updateFieldWidth(CONTAINER, strlen("N/A"));
-      }
-      return;
+   /* most processes stay in their cgroup, so compare before looking it up */
+   CGroupName* name = process->cgroup;
+   if (!name || name->pathLen != len || memcmp(name->path, output, len) != 0) {
+      CGroupName_release(name);
+      name = CGroupName_intern(output, len);
+      process->cgroup = name;
+      process->rollup_group = NULL;
    }
 
-   char* cgroup_short = CGroup_filterName(process->cgroup);
-   if (cgroup_short) {
-      Row_updateFieldWidth(CCGROUP, strlen(cgroup_short));
-      free_and_xStrdup(&process->cgroup_short, cgroup_short);
-      free(cgroup_short);
-   } else {
-      //CCGROUP is alias to normal CGROUP if shortening fails
-      Row_updateFieldWidth(CCGROUP, strlen(process->cgroup));
-      free(process->cgroup_short);
-      process->cgroup_short = NULL;
-   }
-
-   char* container_short = CGroup_filterContainer(process->cgroup);
-   if (container_short) {
-      Row_updateFieldWidth(CONTAINER, strlen(container_short));
-      free_and_xStrdup(&process->container_short, container_short);
-      free(container_short);
-   } else {
-      //CONTAINER is just "N/A" if shortening fails
-      Row_updateFieldWidth(CONTAINER, strlen("N/A"));
-      free(process->container_short);
-      process->container_short = NULL;
-   }
+   Row_updateFieldWidth(CGROUP, name->pathLen);
+   //CCGROUP is alias to normal CGROUP if shortening fails
+   Row_updateFieldWidth(CCGROUP, name->shortName ? name->shortNameLen : name->pathLen);
+   //CONTAINER is just "N/A" if shortening fails
+   Row_updateFieldWidth(CONTAINER, name->container ? name->containerLen : strlen("N/A"));
 }
 
 /*
@@ -1463,6 +1676,39 @@ static char* LinuxProcessTable_updateTtyDevice(TtyDriver* ttyDrivers, unsigned l
    return out;
 }
 
+/*
+ * The pid of a process (identified by pid and start time) was taken over by
+ * a new one: drop the counters the next deltas would be computed against.
+ */
+static void LinuxProcessTable_resetReusedProcess(LinuxProcess* lp) {
+   Process_resetReused(&lp->super);
+
+   lp->io_read_bytes = 0;
+   lp->io_write_bytes = 0;
+   lp->io_last_scan_time_ms = 0;
+   lp->io_rate_read_bps = NAN;
+   lp->io_rate_write_bps = NAN;
+   lp->ctxt_total = 0;
+   lp->ctxt_diff = 0;
+   lp->gpu_time = 0;
+   lp->gpu_percent = 0.0F;
+   lp->gpu_activityMs = 0;
+#ifdef HAVE_DELAYACCT
+   lp->delay_read_time = 0;
+   lp->cpu_delay_total = 0;
+   lp->blkio_delay_total = 0;
+   lp->swapin_delay_total = 0;
+#endif
+   lp->last_mlrs_calctime = 0;
+   lp->m_lrs = 0;
+
+   /* force rereads instead of waiting for the next slow scan period */
+   lp->sock_epoch = 0;
+   lp->fd_epoch = 0;
+   lp->wchan_epoch = 0;
+   lp->wchan[0] = '\0';
+}
+
 static bool isOlderThan(const Process* proc, unsigned int seconds) {
    const Machine* host = proc->super.host;
 
@@ -1508,6 +1754,8 @@ static bool LinuxProcessTable_recurseProcTree(LinuxProcessTable* this, openat_ar
    const bool hideKernelThreads = settings->hideKernelThreads;
    const bool hideUserlandThreads = settings->hideUserlandThreads;
    const bool hideRunningInContainer = settings->hideRunningInContainer;
+   /* collectors skipped this cycle to stay within the overhead budget; their values go stale */
+   const uint32_t suppressedFlags = host->budget.suppressedFlags;
    while ((entry = readdir(dir)) != NULL) {
       const char* name = entry->d_name;
 
@@ -1548,6 +1796,9 @@ static bool LinuxProcessTable_recurseProcTree(LinuxProcessTable* this, openat_ar
       bool preExisting;
       Process* proc = ProcessTable_getProcess(pt, pid, &preExisting, LinuxProcess_new);
       LinuxProcess* lp = (LinuxProcess*) proc;
+      char statCommand[MAX_NAME + 1] = "";
+      bool parentRead = false;
+      bool ownerRead = false;
 
       Process_setThreadGroup(proc, mainTask ? Process_getPid(&mainTask->super) : pid);
       proc->isUserlandThread = Process_getPid(proc) != Process_getThreadGroup(proc);
@@ -1591,23 +1842,33 @@ static bool LinuxProcessTable_recurseProcTree(LinuxProcessTable* this, openat_ar
 
       const bool scanMainThread = !hideUserlandThreads && !Process_isKernelThread(proc) && !mainTask;
 
-      if (!LinuxProcessTable_readStatmFile(lp, procFd, lhost, mainTask))
+      PROFILER_BEGIN(statmPhase, "LinuxProcessTable_readStatmFile", false);
+      bool statmOk = LinuxProcessTable_readStatmFile(lp, procFd, lhost, mainTask);
+      PROFILER_END(statmPhase);
+      if (!statmOk)
          goto errorReadingProcess;
 
       {
          bool prev = proc->usesDeletedLib;
 
+         const bool checkDeletedLib = settings->highlightDeletedExe && !proc->procExeDeleted && isOlderThan(proc, 10);
+
          if (!proc->isKernelThread && !proc->isUserlandThread &&
-             ((ss->flags & PROCESS_FLAG_LINUX_LRS_FIX) || (settings->highlightDeletedExe && !proc->procExeDeleted && isOlderThan(proc, 10)))) {
+             ((ss->flags & PROCESS_FLAG_LINUX_LRS_FIX) || checkDeletedLib)) {
 
             // Check if we really should recalculate the M_LRS value for this process
             uint64_t passedTimeInMs = host->realtimeMs - lp->last_mlrs_calctime;
 
             uint64_t recheck = ((uint64_t)rand()) % 2048;
 
-            if (passedTimeInMs > recheck) {
+            // While the budget suppresses M_LRS, the maps are still read for the deleted library check
+            const bool calcSize = (ss->flags & PROCESS_FLAG_LINUX_LRS_FIX) && !(suppressedFlags & PROCESS_FLAG_LINUX_LRS_FIX);
+
+            if (passedTimeInMs > recheck && (calcSize || checkDeletedLib)) {
                lp->last_mlrs_calctime = host->realtimeMs;
-               LinuxProcessTable_readMaps(lp, procFd, lhost, ss->flags & PROCESS_FLAG_LINUX_LRS_FIX, settings->highlightDeletedExe);
+               PROFILER_BEGIN(mapsPhase, "LinuxProcessTable_readMaps", false);
+               LinuxProcessTable_readMaps(lp, procFd, lhost, calcSize, settings->highlightDeletedExe);
+               PROFILER_END(mapsPhase);
             }
          } else {
             /* Copy from process structure in threads and reset if setting got disabled */
@@ -1619,12 +1880,34 @@ static bool LinuxProcessTable_recurseProcTree(LinuxProcessTable* this, openat_ar
             proc->mergedCommand.lastUpdate = 0;
       }
 
-      char statCommand[MAX_NAME + 1];
       unsigned long long int lasttimes = (lp->utime + lp->stime);
+      unsigned long long int laststart = lp->starttime;
+      time_t last_starttime_ctime = proc->starttime_ctime;
+      pid_t last_parent = Process_getParent(proc);
       unsigned long int last_tty_nr = proc->tty_nr;
-      if (!LinuxProcessTable_readStatFile(lp, procFd, lhost, scanMainThread, statCommand, sizeof(statCommand)))
+      PROFILER_BEGIN(statPhase, "LinuxProcessTable_readStatFile", false);
+      bool statOk = LinuxProcessTable_readStatFile(lp, procFd, lhost, scanMainThread, statCommand, sizeof(statCommand));
+      PROFILER_END(statPhase);
+      if (!statOk)
          goto errorReadingProcess;
 
+      /* A different start time means the pid was reused since the last scan */
+      parentRead = true;
+
+      bool reused = preExisting && lp->starttime != laststart;
+      if (reused) {
+         /* the previous owner has exited; log it as last seen, its names are not reread yet */
+         Process previous = *proc;
+         Process_setParent(&previous, last_parent);
+         previous.starttime_ctime = last_starttime_ctime;
+         previous.time = lasttimes;
+         previous.m_resident = 0;  /* its last value is already in m_resident_max */
+         ProcessTable_logExit(pt, &previous, NULL);
+
+         LinuxProcessTable_resetReusedProcess(lp);
+         lasttimes = 0;
+      }
+
       if (lp->flags & PF_KTHREAD) {
          proc->isKernelThread = true;
       }
@@ -1643,8 +1926,12 @@ static bool LinuxProcessTable_recurseProcTree(LinuxProcessTable* this, openat_ar
       proc->percent_mem = proc->m_resident / (double)(host->totalMem) * 100.0;
       Process_updateCPUFieldWidths(proc->percent_cpu);
 
-      if (!LinuxProcessTable_updateUser(host, proc, procFd, mainTask))
+      PROFILER_BEGIN(userPhase, "LinuxProcessTable_updateUser", false);
+      bool userOk = LinuxProcessTable_updateUser(host, proc, procFd, mainTask);
+      PROFILER_END(userPhase);
+      if (!userOk)
          goto errorReadingProcess;
+      ownerRead = true;
 
       /* Check if the process is inside a different PID namespace. */
       if (proc->isRunningInContainer == TRI_INITIAL && rootPidNs != (ino_t)-1) {
@@ -1661,11 +1948,14 @@ static bool LinuxProcessTable_recurseProcTree(LinuxProcessTable* this, openat_ar
          }
       }
 
-      if (ss->flags & PROCESS_FLAG_LINUX_CTXT
+      if (ss->flags & (PROCESS_FLAG_LINUX_CTXT | PROCESS_FLAG_LINUX_NUMA)
          || ((hideRunningInContainer || ss->flags & PROCESS_FLAG_LINUX_CONTAINER) && proc->isRunningInContainer == TRI_INITIAL)
       ) {
          proc->isRunningInContainer = TRI_OFF;
-         if (!LinuxProcessTable_readStatusFile(proc, procFd))
+         PROFILER_BEGIN(statusPhase, "LinuxProcessTable_readStatusFile", false);
+         bool statusOk = LinuxProcessTable_readStatusFile(proc, procFd);
+         PROFILER_END(statusPhase);
+         if (!statusOk)
             goto errorReadingProcess;
       }
 
@@ -1684,7 +1974,7 @@ static bool LinuxProcessTable_recurseProcTree(LinuxProcessTable* this, openat_ar
 
          ProcessTable_add(pt, proc);
       } else {
-         if (settings->updateProcessNames && proc->state != ZOMBIE) {
+         if (reused || (settings->updateProcessNames && proc->state != ZOMBIE)) {
             if (proc->isKernelThread) {
                Process_updateCmdline(proc, NULL, 0, 0);
             } else {
@@ -1694,6 +1984,9 @@ static bool LinuxProcessTable_recurseProcTree(LinuxProcessTable* this, openat_ar
                LinuxProcessList_readComm(proc, procFd);
             }
          }
+
+         if (reused)
+            Process_fillStarttimeBuffer(proc);
       }
 
       /*
@@ -1714,15 +2007,20 @@ static bool LinuxProcessTable_recurseProcTree(LinuxProcessTable* this, openat_ar
          }
       }
 
-      if (ss->flags & PROCESS_FLAG_LINUX_CGROUP)
+      if ((ss->flags & PROCESS_FLAG_LINUX_CGROUP) || this->readCGroups) {
+         PROFILER_BEGIN(cgroupPhase, "LinuxProcessTable_readCGroupFile", false);
          LinuxProcessTable_readCGroupFile(lp, procFd);
+         PROFILER_END(cgroupPhase);
+      }
 
-      if ((ss->flags & PROCESS_FLAG_LINUX_SMAPS) && !Process_isKernelThread(proc)) {
+      if ((ss->flags & PROCESS_FLAG_LINUX_SMAPS) && !(suppressedFlags & PROCESS_FLAG_LINUX_SMAPS) && !Process_isKernelThread(proc)) {
          if (!mainTask) {
             // Read smaps file of each process only every second pass to improve performance
             static int smaps_flag = 0;
             if ((pid & 1) == smaps_flag) {
+               PROFILER_BEGIN(smapsPhase, "LinuxProcessTable_readSmapsFile", false);
                LinuxProcessTable_readSmapsFile(lp, procFd, this->haveSmapsRollup);
+               PROFILER_END(smapsPhase);
             }
             if (pid == 1) {
                smaps_flag = !smaps_flag;
@@ -1735,18 +2033,78 @@ static bool LinuxProcessTable_recurseProcTree(LinuxProcessTable* this, openat_ar
          }
       }
 
+      if ((ss->flags & PROCESS_FLAG_LINUX_NUMA) && !(suppressedFlags & PROCESS_FLAG_LINUX_NUMA) && !Process_isKernelThread(proc)) {
+         if (!mainTask) {
+            // Walking the page tables is as costly as smaps, so alternate passes the same way
+            static int numa_flag = 0;
+            if ((pid & 1) == numa_flag) {
+               PROFILER_BEGIN(numaPhase, "LinuxProcessTable_readNumaMapsFile", false);
+               LinuxProcessTable_readNumaMapsFile(lp, procFd);
+               PROFILER_END(numaPhase);
+            }
+            if (pid == 1) {
+               numa_flag = !numa_flag;
+            }
+         } else {
+            memcpy(lp->numa_kb, mainTask->numa_kb, sizeof(lp->numa_kb));
+            lp->numa_nodes    = mainTask->numa_nodes;
+            lp->numa_home     = mainTask->numa_home;
+            lp->m_numa_remote = mainTask->m_numa_remote;
+         }
+      }
+
+      if ((ss->flags & PROCESS_FLAG_LINUX_SOCKETS) && !(suppressedFlags & PROCESS_FLAG_LINUX_SOCKETS) && !Process_isKernelThread(proc)) {
+         if (!mainTask) {
+            if (lp->sock_epoch != this->slowScanEpoch) {
+               PROFILER_BEGIN(socketsPhase, "LinuxProcessTable_readSockets", false);
+               LinuxProcessTable_readSockets(this, lp, procFd);
+               PROFILER_END(socketsPhase);
+               lp->sock_epoch = this->slowScanEpoch;
+            }
+         } else {
+            lp->sock_tcp_established = mainTask->sock_tcp_established;
+            lp->sock_tcp_listen      = mainTask->sock_tcp_listen;
+            lp->sock_total           = mainTask->sock_total;
+         }
+      }
+
+      if ((ss->flags & PROCESS_FLAG_LINUX_FDCOUNT) && !(suppressedFlags & PROCESS_FLAG_LINUX_FDCOUNT) && !Process_isKernelThread(proc)) {
+         if (!mainTask) {
+            if (lp->fd_epoch != this->slowScanEpoch) {
+               PROFILER_BEGIN(fdCountPhase, "LinuxProcessTable_readFdCount", false);
+               LinuxProcessTable_readFdCount(lp, procFd);
+               PROFILER_END(fdCountPhase);
+               lp->fd_epoch = this->slowScanEpoch;
+            }
+         } else {
+            lp->fd_count = mainTask->fd_count;
+         }
+      }
+
+      if ((ss->flags & PROCESS_FLAG_LINUX_WCHAN) && !(suppressedFlags & PROCESS_FLAG_LINUX_WCHAN)) {
+         PROFILER_BEGIN(wchanPhase, "LinuxProcessTable_readWchan", false);
+         LinuxProcessTable_readWchan(this, lp, procFd);
+         PROFILER_END(wchanPhase);
+      }
+
       if (ss->flags & PROCESS_FLAG_IO) {
+         PROFILER_BEGIN(ioPhase, "LinuxProcessTable_readIoFile", false);
          LinuxProcessTable_readIoFile(lp, procFd, scanMainThread);
+         PROFILER_END(ioPhase);
       }
 
       #ifdef HAVE_DELAYACCT
-      if (ss->flags & PROCESS_FLAG_LINUX_DELAYACCT) {
+      if ((ss->flags & PROCESS_FLAG_LINUX_DELAYACCT) && !(suppressedFlags & PROCESS_FLAG_LINUX_DELAYACCT)) {
+         PROFILER_BEGIN(delayAcctPhase, "LibNl_readDelayAcctData", false);
          LibNl_readDelayAcctData(this, lp);
+         PROFILER_END(delayAcctPhase);
       }
       #endif
 
       if (ss->flags & PROCESS_FLAG_LINUX_OOM) {
+         PROFILER_BEGIN(oomPhase, "LinuxProcessTable_readOomData", false);
          LinuxProcessTable_readOomData(lp, procFd, mainTask);
+         PROFILER_END(oomPhase);
       }
 
       if (ss->flags & PROCESS_FLAG_LINUX_IOPRIO) {
@@ -1754,11 +2112,15 @@ static bool LinuxProcessTable_recurseProcTree(LinuxProcessTable* this, openat_ar
       }
 
       if (ss->flags & PROCESS_FLAG_LINUX_SECATTR) {
+         PROFILER_BEGIN(secattrPhase, "LinuxProcessTable_readSecattrData", false);
          LinuxProcessTable_readSecattrData(lp, procFd, mainTask);
+         PROFILER_END(secattrPhase);
       }
 
       if (ss->flags & PROCESS_FLAG_CWD) {
+         PROFILER_BEGIN(cwdPhase, "LinuxProcessTable_readCwd", false);
          LinuxProcessTable_readCwd(lp, procFd, mainTask);
+         PROFILER_END(cwdPhase);
       }
 
       if ((ss->flags & PROCESS_FLAG_LINUX_AUTOGROUP) && this->haveAutogroup) {
@@ -1771,11 +2133,13 @@ static bool LinuxProcessTable_recurseProcTree(LinuxProcessTable* this, openat_ar
       }
       #endif
 
-      if (ss->flags & PROCESS_FLAG_LINUX_GPU || GPUMeter_active()) {
+      if ((ss->flags & PROCESS_FLAG_LINUX_GPU || GPUMeter_active()) && !(suppressedFlags & PROCESS_FLAG_LINUX_GPU)) {
          if (mainTask) {
             lp->gpu_time = mainTask->gpu_time;
          } else {
+            PROFILER_BEGIN(gpuPhase, "GPU_readProcessData", false);
             GPU_readProcessData(this, lp, procFd);
+            PROFILER_END(gpuPhase);
          }
       }
 
@@ -1827,6 +2191,14 @@ errorReadingProcess:
          } else {
             /* A really short-lived process that we don't have full info about */
             assert(ProcessTable_findProcess(pt, Process_getPid(proc)) == NULL);
+            if (kill(Process_getPid(proc), 0) < 0 && errno == ESRCH) {
+               /* log what was not read before it vanished as unknown, not as 0 */
+               if (!parentRead)
+                  Process_setParent(proc, -1);
+               if (!ownerRead)
+                  proc->st_uid = (uid_t)-1;
+               ProcessTable_logExit(pt, proc, statCommand);
+            }
             Process_delete((Object*)proc);
          }
       }
@@ -1851,6 +2223,18 @@ void ProcessTable_goThroughEntries(ProcessTable* super) {
       this->haveAutogroup = false;
    }
 
+   /* Socket and fd counts and the wait channels of sleeping tasks are refreshed on a slower cadence; each period rereads the socket tables */
+   if (settings->ss->flags & (PROCESS_FLAG_LINUX_SOCKETS | PROCESS_FLAG_LINUX_FDCOUNT | PROCESS_FLAG_LINUX_WCHAN)) {
+      if (!this->slowScanMs || host->monotonicMs - this->slowScanMs >= LINUX_SLOW_SCAN_INTERVAL_MS) {
+         LinuxProcessTable_dropSocketTables(this);
+         this->slowScanMs = host->monotonicMs;
+         this->slowScanEpoch++;
+      }
+   } else if (this->slowScanMs) {
+      LinuxProcessTable_dropSocketTables(this);
+      this->slowScanMs = 0;
+   }
+
    /* Shift GPU values */
    {
       lhost->prevGpuTime = lhost->curGpuTime;
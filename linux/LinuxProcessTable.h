@@ -8,9 +8,18 @@ in the source distribution for its full text.
 */
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
 
 #include "ProcessTable.h"
 
+#include "linux/SocketTable.h"
+
+
+/* Time between two updates of the columns refreshed on a slower cadence (sockets, fds) */
+#define LINUX_SLOW_SCAN_INTERVAL_MS 5000
+
 
 typedef struct TtyDriver_ {
    char* path;
@@ -19,6 +28,11 @@ typedef struct TtyDriver_ {
    unsigned int minorTo;
 } TtyDriver;
 
+typedef struct LinuxSocketNamespace_ {
+   ino_t inode;
+   SocketTable sockets;
+} LinuxSocketNamespace;
+
 typedef struct LinuxProcessTable_ {
    ProcessTable super;
 
@@ -26,6 +40,17 @@ typedef struct LinuxProcessTable_ {
    bool haveSmapsRollup;
    bool haveAutogroup;
 
+   /* Read cgroups even without a cgroup column, e.g. for the rollup screen */
+   bool readCGroups;
+
+   /* Period of the slowly refreshed columns; values from an older epoch are stale */
+   uint64_t slowScanMs;
+   unsigned int slowScanEpoch;
+
+   /* TCP sockets per network namespace, read lazily once per slow scan period */
+   LinuxSocketNamespace* socketNamespaces;
+   size_t socketNamespaceCount;
+
    #ifdef HAVE_DELAYACCT
    int netlink_family;
    struct nl_sock* netlink_socket;
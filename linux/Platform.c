@@ -21,6 +21,7 @@ in the source distribution for its full text.
 #include <string.h>
 #include <time.h>
 #include <unistd.h>
+#include <sys/stat.h>
 #include <sys/sysmacros.h>
 
 #include "BatteryMeter.h"
@@ -31,6 +32,8 @@ in the source distribution for its full text.
 #include "GPUMeter.h"
 #include "HostnameMeter.h"
 #include "HugePageMeter.h"
+#include "IODevices.h"
+#include "IODevicesMeter.h"
 #include "LoadAverageMeter.h"
 #include "Machine.h"
 #include "Macros.h"
@@ -39,7 +42,9 @@ in the source distribution for its full text.
 #include "MemoryMeter.h"
 #include "MemorySwapMeter.h"
 #include "NetworkIOMeter.h"
+#include "NUMAMemoryMeter.h"
 #include "Object.h"
+#include "OverheadMeter.h"
 #include "Panel.h"
 #include "PressureStallMeter.h"
 #include "ProvideCurses.h"
@@ -48,14 +53,21 @@ in the source distribution for its full text.
 #include "SysArchMeter.h"
 #include "TasksMeter.h"
 #include "UptimeMeter.h"
+#include "linux/CGroupRollupScreen.h"
+#include "linux/CGroupScreen.h"
 #include "linux/Compat.h"
 #include "linux/IOPriority.h"
 #include "linux/IOPriorityPanel.h"
+#include "linux/KernelStackScreen.h"
 #include "linux/LinuxMachine.h"
 #include "linux/LinuxProcess.h"
+#include "linux/ProcFile.h"
+#include "linux/ProcLocks.h"
 #include "linux/OpenRCMeter.h"
 #include "linux/SELinuxMeter.h"
+#include "linux/SocketTable.h"
 #include "linux/SystemdMeter.h"
+#include "linux/WchanScreen.h"
 #include "linux/ZramMeter.h"
 #include "linux/ZramStats.h"
 #include "linux/ZswapMeter.h"
@@ -220,7 +232,56 @@ static Htop_Reaction Platform_actionLowerAutogroupPriority(State* st) {
    return changed ? HTOP_REFRESH : HTOP_OK;
 }
 
+static Htop_Reaction Platform_actionShowCGroups(ATTR_UNUSED State* st) {
+   CGroupScreen* cs = CGroupScreen_new();
+   InfoScreen_run((InfoScreen*)cs);
+   CGroupScreen_delete((Object*)cs);
+   clear();
+   CRT_enableDelay();
+   return HTOP_REFRESH | HTOP_REDRAW_BAR;
+}
+
+static Htop_Reaction Platform_actionShowCGroupRollup(State* st) {
+   CGroupRollupScreen* crs = CGroupRollupScreen_new(st->host, st->pauseUpdate);
+   InfoScreen_run((InfoScreen*)crs);
+   CGroupRollupScreen_delete((Object*)crs);
+   clear();
+   CRT_enableDelay();
+   return HTOP_REFRESH | HTOP_REDRAW_BAR;
+}
+
+static Htop_Reaction Platform_actionShowKernelStack(State* st) {
+   if (st->host->settings->ss->dynamic)
+      return HTOP_OK;
+
+   const Process* p = (Process*) Panel_getSelected((Panel*)st->mainPanel);
+   if (!p)
+      return HTOP_OK;
+
+   assert(Object_isA((const Object*) p, (const ObjectClass*) &Process_class));
+
+   KernelStackScreen* kss = KernelStackScreen_new(p);
+   InfoScreen_run((InfoScreen*)kss);
+   KernelStackScreen_delete((Object*)kss);
+   clear();
+   CRT_enableDelay();
+   return HTOP_REFRESH | HTOP_REDRAW_BAR;
+}
+
+static Htop_Reaction Platform_actionShowWchans(ATTR_UNUSED State* st) {
+   WchanScreen* ws = WchanScreen_new();
+   InfoScreen_run((InfoScreen*)ws);
+   WchanScreen_delete((Object*)ws);
+   clear();
+   CRT_enableDelay();
+   return HTOP_REFRESH | HTOP_REDRAW_BAR;
+}
+
 void Platform_setBindings(Htop_Action* keys) {
+   keys['B'] = Platform_actionShowKernelStack;
+   keys['G'] = Platform_actionShowCGroups;
+   keys['R'] = Platform_actionShowCGroupRollup;
+   keys['W'] = Platform_actionShowWchans;
    keys['i'] = Platform_actionSetIOPriority;
    keys['{'] = Platform_actionLowerAutogroupPriority;
    keys['}'] = Platform_actionHigherAutogroupPriority;
@@ -238,6 +299,7 @@ const MeterClass* const Platform_meterTypes[] = {
    &MemoryMeter_class,
    &SwapMeter_class,
    &MemorySwapMeter_class,
+   &NUMAMemoryMeter_class,
    &SysArchMeter_class,
    &HugePageMeter_class,
    &TasksMeter_class,
@@ -257,6 +319,10 @@ const MeterClass* const Platform_meterTypes[] = {
    &RightCPUs4Meter_class,
    &LeftCPUs8Meter_class,
    &RightCPUs8Meter_class,
+   &CPUHeatmapMeter_class,
+   &CoreHeatmapMeter_class,
+   &CCDHeatmapMeter_class,
+   &NodeHeatmapMeter_class,
    &BlankMeter_class,
    &PressureStallCPUSomeMeter_class,
    &PressureStallIOSomeMeter_class,
@@ -273,12 +339,14 @@ const MeterClass* const Platform_meterTypes[] = {
    &DiskIOTimeMeter_class,
    &DiskIOMeter_class,
    &NetworkIOMeter_class,
+   &IODevicesMeter_class,
    &SELinuxMeter_class,
    &SystemdMeter_class,
    &SystemdUserMeter_class,
    &OpenRCMeter_class,
    &OpenRCUserMeter_class,
    &FileDescriptorMeter_class,
+   &OverheadMeter_class,
    &GPUMeter_class,
    NULL
 };
@@ -395,6 +463,42 @@ double Platform_setCPUValues(Meter* this, unsigned int cpu) {
    return percent;
 }
 
+bool Platform_getCPULoads(const Machine* host, CPUGrouping grouping, double* loads, int* groups) {
+   const LinuxMachine* lhost = (const LinuxMachine*) host;
+
+   for (unsigned int i = 0; i < host->existingCPUs; i++) {
+      const CPUData* cpuData = &lhost->cpuData[i + 1];
+
+      switch (grouping) {
+         case CPU_GROUP_THREAD:
+            groups[i] = (int)i;
+            break;
+         case CPU_GROUP_CORE:
+            groups[i] = cpuData->coreIndex;
+            break;
+         case CPU_GROUP_CCD:
+            /* without chiplet information, a socket is the closest unit */
+            groups[i] = cpuData->ccdID >= 0 ? cpuData->ccdID : MAXIMUM(cpuData->physicalID, 0);
+            break;
+         case CPU_GROUP_NODE:
+            groups[i] = cpuData->nodeID;
+            break;
+      }
+
+      if (!cpuData->online) {
+         loads[i] = NAN;
+         continue;
+      }
+
+      /* same sum as the non-detailed CPU meter bar */
+      double total = (double) (cpuData->totalPeriod == 0 ? 1 : cpuData->totalPeriod);
+      unsigned long long int busy = cpuData->nicePeriod + cpuData->userPeriod + cpuData->systemAllPeriod + cpuData->stealPeriod + cpuData->guestPeriod;
+      loads[i] = MINIMUM(busy / total * 100.0, 100.0);
+   }
+
+   return true;
+}
+
 void Platform_setGPUValues(Meter* this, double* totalUsage, unsigned long long* totalGPUTimeDiff) {
    const Machine* host = this->host;
    const LinuxMachine* lhost = (const LinuxMachine*) host;
@@ -555,7 +659,35 @@ char* Platform_getProcessEnv(pid_t pid) {
    return env;
 }
 
-FileLocks_ProcessData* Platform_getProcessLocks(pid_t pid) {
+/* "lock:\t1: POSIX  ADVISORY  WRITE 1234 08:01:5678 0 EOF", as in /proc/locks */
+static bool Platform_parseFdinfoLock(const char* line, pid_t pid, int fd, FileLocks_Data* data) {
+   if (!strchr(line, '\n') || !String_startsWith(line, "lock:\t"))
+      return false;
+
+   *data = (FileLocks_Data) {.pid = pid, .fd = fd};
+   int _;
+   unsigned int maj, min;
+   char lock_end[25], locktype[32], exclusive[32], readwrite[32];
+   if (10 != sscanf(line + strlen("lock:\t"), "%d: %31s %31s %31s %d %x:%x:%"PRIu64" %"PRIu64" %24s",
+      &_, locktype, exclusive, readwrite, &_,
+      &maj, &min, &data->inode,
+      &data->start, lock_end))
+      return false;
+
+   data->locktype = xStrdup(locktype);
+   data->exclusive = xStrdup(exclusive);
+   data->readwrite = xStrdup(readwrite);
+   data->dev = makedev(maj, min);
+
+   if (String_eq(lock_end, "EOF"))
+      data->end = ULLONG_MAX;
+   else
+      data->end = strtoull(lock_end, NULL, 10);
+
+   return true;
+}
+
+static FileLocks_ProcessData* Platform_getProcessLocksFromFdinfo(pid_t pid) {
    FileLocks_ProcessData* pdata = xCalloc(1, sizeof(FileLocks_ProcessData));
    DIR* dirp;
    int dfd;
@@ -595,32 +727,10 @@ FileLocks_ProcessData* Platform_getProcessLocks(pid_t pid) {
       }
 
       for (char buffer[1024]; fgets(buffer, sizeof(buffer), fp); ) {
-         if (!strchr(buffer, '\n'))
-            continue;
-
-         if (!String_startsWith(buffer, "lock:\t"))
+         FileLocks_Data data;
+         if (!Platform_parseFdinfoLock(buffer, pid, file, &data))
             continue;
 
-         FileLocks_Data data = {.fd = file};
-         int _;
-         unsigned int maj, min;
-         char lock_end[25], locktype[32], exclusive[32], readwrite[32];
-         if (10 != sscanf(buffer + strlen("lock:\t"), "%d: %31s %31s %31s %d %x:%x:%"PRIu64" %"PRIu64" %24s",
-            &_, locktype, exclusive, readwrite, &_,
-            &maj, &min, &data.inode,
-            &data.start, lock_end))
-            continue;
-
-         data.locktype = xStrdup(locktype);
-         data.exclusive = xStrdup(exclusive);
-         data.readwrite = xStrdup(readwrite);
-         data.dev = makedev(maj, min);
-
-         if (String_eq(lock_end, "EOF"))
-            data.end = ULLONG_MAX;
-         else
-            data.end = strtoull(lock_end, NULL, 10);
-
          xSnprintf(path, sizeof(path), PROCDIR "/%d/fd/%s", pid, de->d_name);
          char link[PATH_MAX];
          ssize_t link_len;
@@ -643,6 +753,425 @@ err:
    return pdata;
 }
 
+static FileLocks_LockData* Platform_newLockData(const ProcLocks_Entry* entry) {
+   FileLocks_LockData* ldata = xCalloc(1, sizeof(FileLocks_LockData));
+   FileLocks_Data* data = &ldata->data;
+
+   data->pid = entry->pid;
+   data->fd = -1;
+   if (entry->blocked)
+      xAsprintf(&data->locktype, "->%s", entry->locktype);
+   else
+      data->locktype = xStrdup(entry->locktype);
+   data->exclusive = xStrdup(entry->exclusive);
+   data->readwrite = xStrdup(entry->readwrite);
+   data->dev = entry->dev;
+   data->inode = entry->inode;
+   data->start = entry->start;
+   data->end = entry->end == UINT64_MAX ? ULLONG_MAX : entry->end;
+
+   return ldata;
+}
+
+typedef struct Platform_MountDevice_ {
+   int id;
+   dev_t dev;
+} Platform_MountDevice;
+
+/*
+ * The device of each mount seen by the process, as /proc/locks reports it.
+ * This is not always st_dev: btrfs gives each subvolume a device of its own.
+ */
+static Platform_MountDevice* Platform_readMountDevices(pid_t pid, size_t* count) {
+   *count = 0;
+
+   char path[64];
+   xSnprintf(path, sizeof(path), PROCDIR "/%d/mountinfo", pid);
+
+   ProcFile file;
+   ProcFile_init(&file, path);
+   if (!ProcFile_read(&file)) {
+      ProcFile_done(&file);
+      return NULL;
+   }
+
+   /* "36 35 98:0 /mnt1 /mnt2 rw,noatime master:1 - ext3 /dev/root rw" */
+   Platform_MountDevice* mounts = NULL;
+   size_t size = 0;
+   for (const char* line = file.buffer; *line; line = ProcFile_nextLine(line)) {
+      int id;
+      unsigned int maj, min;
+      if (sscanf(line, "%d %*d %u:%u", &id, &maj, &min) != 3)
+         continue;
+
+      if (*count == size) {
+         size = size ? size * 2 : 64;
+         mounts = xReallocArray(mounts, size, sizeof(Platform_MountDevice));
+      }
+      mounts[(*count)++] = (Platform_MountDevice) { .id = id, .dev = makedev(maj, min) };
+   }
+
+   ProcFile_done(&file);
+   return mounts;
+}
+
+/*
+ * Reads the fdinfo of one descriptor for its mount id and, if tail is given,
+ * appends the open file description locks held through it. The kernel lists
+ * these in /proc/locks with a PID of -1, so they are only found this way.
+ */
+static int Platform_readFdinfo(pid_t pid, int fd, const char* filename, FileLocks_LockData*** tail) {
+   char path[64];
+   xSnprintf(path, sizeof(path), PROCDIR "/%d/fdinfo/%d", pid, fd);
+
+   FILE* fp = fopen(path, "r");
+   if (!fp)
+      return -1;
+
+   int mntId = -1;
+   for (char buffer[1024]; fgets(buffer, sizeof(buffer), fp); ) {
+      if (String_startsWith(buffer, "mnt_id:")) {
+         mntId = atoi(buffer + strlen("mnt_id:"));
+         continue;
+      }
+
+      if (!tail || !strstr(buffer, " OFDLCK "))
+         continue;
+
+      FileLocks_Data data;
+      if (!Platform_parseFdinfoLock(buffer, pid, fd, &data))
+         continue;
+
+      data.filename = filename ? xStrdup(filename) : NULL;
+      **tail = xCalloc(1, sizeof(FileLocks_LockData));
+      (**tail)->data = data;
+      *tail = &(**tail)->next;
+   }
+
+   fclose(fp);
+   return mntId;
+}
+
+/*
+ * Finds the descriptors of the locked files by inode, reading the fdinfo
+ * only of those on a locked inode: for the device of their mount when
+ * st_dev does not match, and for the open file description locks (ofd).
+ */
+static void Platform_resolveLockFiles(pid_t pid, FileLocks_ProcessData* pdata, size_t unresolved, const ProcLocks_Entry* ofd, size_t ofdCount) {
+   char path[PATH_MAX];
+   xSnprintf(path, sizeof(path), PROCDIR "/%d/fd", pid);
+
+   DIR* dirp = opendir(path);
+   if (!dirp)
+      return;
+
+   FileLocks_LockData** tail = &pdata->locks;
+   while (*tail)
+      tail = &(*tail)->next;
+
+   Platform_MountDevice* mounts = NULL;
+   size_t mountCount = 0;
+   bool mountsRead = false;
+
+   int dfd = dirfd(dirp);
+   for (const struct dirent* de; (unresolved || ofdCount) && (de = readdir(dirp)); ) {
+      char* end;
+      unsigned long int fdnum = strtoul(de->d_name, &end, 10);
+      if (end == de->d_name || *end || fdnum >= INT_MAX)
+         continue;
+      int fd = (int)fdnum;
+
+      struct stat st;
+      if (fstatat(dfd, de->d_name, &st, 0) != 0)
+         continue;
+
+      bool ownLock = false;
+      bool devMatches = false;
+      for (const FileLocks_LockData* ldata = pdata->locks; ldata; ldata = ldata->next) {
+         if (ldata->data.fd < 0 && ldata->data.inode == (uint64_t)st.st_ino) {
+            ownLock = true;
+            devMatches |= ldata->data.dev == st.st_dev;
+         }
+      }
+
+      bool ofdLock = false;
+      for (size_t i = 0; i < ofdCount && !ofdLock; i++)
+         ofdLock = ofd[i].inode == (uint64_t)st.st_ino;
+
+      if (!ownLock && !ofdLock)
+         continue;
+
+      char link[PATH_MAX];
+      ssize_t len = readlinkat(dfd, de->d_name, link, sizeof(link) - 1);
+      if (len > 0)
+         link[len] = '\0';
+      const char* filename = len > 0 ? link : NULL;
+
+      dev_t mountDev = st.st_dev;
+      if (ofdLock || !devMatches) {
+         int mntId = Platform_readFdinfo(pid, fd, filename, ofdLock ? &tail : NULL);
+
+         if (!mountsRead) {
+            mounts = Platform_readMountDevices(pid, &mountCount);
+            mountsRead = true;
+         }
+         for (size_t i = 0; i < mountCount; i++) {
+            if (mounts[i].id == mntId) {
+               mountDev = mounts[i].dev;
+               break;
+            }
+         }
+      }
+
+      for (FileLocks_LockData* ldata = pdata->locks; ownLock && ldata; ldata = ldata->next) {
+         FileLocks_Data* data = &ldata->data;
+         if (data->fd >= 0 || data->inode != (uint64_t)st.st_ino)
+            continue;
+         if (data->dev != st.st_dev && data->dev != mountDev)
+            continue;
+
+         data->fd = fd;
+         if (filename)
+            data->filename = xStrdup(filename);
+         unresolved--;
+      }
+   }
+
+   free(mounts);
+   closedir(dirp);
+}
+
+FileLocks_ProcessData* Platform_getProcessLocks(pid_t pid) {
+   ProcLocks locks;
+   if (!ProcLocks_read(&locks))
+      return Platform_getProcessLocksFromFdinfo(pid);
+
+   FileLocks_ProcessData* pdata = xCalloc(1, sizeof(FileLocks_ProcessData));
+
+   size_t count;
+   const ProcLocks_Entry* entries = ProcLocks_find(&locks, pid, &count);
+
+   FileLocks_LockData** data_ref = &pdata->locks;
+   for (size_t i = 0; i < count; i++) {
+      *data_ref = Platform_newLockData(&entries[i]);
+      data_ref = &(*data_ref)->next;
+   }
+
+   size_t ofdCount;
+   const ProcLocks_Entry* ofd = ProcLocks_find(&locks, -1, &ofdCount);
+
+   if (count || ofdCount)
+      Platform_resolveLockFiles(pid, pdata, count, ofd, ofdCount);
+
+   ProcLocks_done(&locks);
+
+   return pdata;
+}
+
+FileLocks_ProcessData* Platform_getFileLocks(void) {
+   FileLocks_ProcessData* pdata = xCalloc(1, sizeof(FileLocks_ProcessData));
+
+   ProcLocks locks;
+   if (!ProcLocks_read(&locks)) {
+      pdata->error = true;
+      return pdata;
+   }
+
+   FileLocks_LockData** data_ref = &pdata->locks;
+   for (size_t i = 0; i < locks.count; i++) {
+      *data_ref = Platform_newLockData(&locks.entries[i]);
+      data_ref = &(*data_ref)->next;
+   }
+
+   ProcLocks_done(&locks);
+   return pdata;
+}
+
+static void Platform_setOpenFileStat(OpenFiles_ProcessData* pdata, OpenFiles_Data* item, const struct stat* st) {
+   char buffer[32];
+
+   bool device = S_ISCHR(st->st_mode) || S_ISBLK(st->st_mode);
+   dev_t dev = device ? st->st_rdev : st->st_dev;
+   xSnprintf(buffer, sizeof(buffer), "%u,%u", major(dev), minor(dev));
+   OpenFiles_Data_set(pdata, item, 'D', buffer);
+
+   xSnprintf(buffer, sizeof(buffer), "%"PRIu64, (uint64_t)st->st_ino);
+   OpenFiles_Data_set(pdata, item, 'i', buffer);
+
+   if (S_ISREG(st->st_mode) || S_ISDIR(st->st_mode)) {
+      xSnprintf(buffer, sizeof(buffer), "%"PRIu64, (uint64_t)st->st_size);
+      OpenFiles_Data_set(pdata, item, 's', buffer);
+   }
+}
+
+static const char* Platform_openFileType(const struct stat* st, const char* link) {
+   if (S_ISREG(st->st_mode))
+      return "REG";
+   if (S_ISDIR(st->st_mode))
+      return "DIR";
+   if (S_ISCHR(st->st_mode))
+      return "CHR";
+   if (S_ISBLK(st->st_mode))
+      return "BLK";
+   if (S_ISFIFO(st->st_mode))
+      return "FIFO";
+   if (S_ISSOCK(st->st_mode))
+      return "sock";
+   if (S_ISLNK(st->st_mode))
+      return "LINK";
+   if (String_startsWith(link, "anon_inode:"))
+      return "a_inode";
+   return "unknown";
+}
+
+/* Reads the offset and the access mode of a descriptor from /proc/<pid>/fdinfo/<fd> */
+static void Platform_readOpenFileInfo(OpenFiles_ProcessData* pdata, OpenFiles_Data* item, int infofd, const char* name) {
+   /* pos and flags come first; the rest may be cut off for epoll or inotify */
+   char buffer[256];
+   if (Compat_readfileat(infofd, name, buffer, sizeof(buffer)) <= 0)
+      return;
+
+   for (const char* line = buffer; *line; line = ProcFile_nextLine(line)) {
+      unsigned long long value = 0;
+      if (String_startsWith(line, "pos:")) {
+         const char* start = ProcFile_skipSpaces(line + strlen("pos:"));
+         if (ProcFile_parseNumber(start, &value) != start) {
+            char offset[24];
+            xSnprintf(offset, sizeof(offset), "%llu", value);
+            OpenFiles_Data_set(pdata, item, 'o', offset);
+         }
+      } else if (String_startsWith(line, "flags:")) {
+         unsigned long flags = strtoul(line + strlen("flags:"), NULL, 8);
+         switch (flags & O_ACCMODE) {
+            case O_RDONLY: OpenFiles_Data_set(pdata, item, 'a', "r"); break;
+            case O_WRONLY: OpenFiles_Data_set(pdata, item, 'a', "w"); break;
+            case O_RDWR:   OpenFiles_Data_set(pdata, item, 'a', "u"); break;
+         }
+      }
+   }
+}
+
+static void Platform_describeSocket(OpenFiles_ProcessData* pdata, OpenFiles_Data* item, const SocketEntry* entry) {
+   char name[PATH_MAX];
+   SocketEntry_describe(entry, name, sizeof(name));
+   OpenFiles_Data_set(pdata, item, 'n', name);
+   OpenFiles_Data_set(pdata, item, 't', entry->protocol == SOCKET_UNIX ? "unix" : SocketEntry_isInet6(entry) ? "IPv6" : "IPv4");
+}
+
+/*
+ * Lists the open files from /proc/<pid>/fd and fdinfo instead of running
+ * lsof. Socket links are resolved against one read of the socket tables
+ * of the namespace of the process, done only if the process has sockets.
+ */
+OpenFiles_ProcessData* Platform_getProcessOpenFiles(pid_t pid) {
+   char path[64];
+   xSnprintf(path, sizeof(path), PROCDIR "/%d", pid);
+
+   int procfd = open(path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+   if (procfd < 0)
+      return NULL;
+
+   int dfd = openat(procfd, "fd", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+   DIR* dirp = dfd >= 0 ? fdopendir(dfd) : NULL;
+   if (!dirp) {
+      if (dfd >= 0)
+         close(dfd);
+      close(procfd);
+      return NULL;
+   }
+
+   int infofd = openat(procfd, "fdinfo", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+   OpenFiles_ProcessData* pdata = OpenFiles_ProcessData_new();
+   OpenFiles_FileData** fdata_ref = &pdata->files;
+
+   SocketTable sockets;
+   bool socketsRead = false;
+
+   static const struct {
+      const char* link;
+      const char* fd;
+   } special[] = {
+      { "cwd",  "cwd" },
+      { "root", "rtd" },
+      { "exe",  "txt" },
+   };
+
+   for (size_t i = 0; i < ARRAYSIZE(special); i++) {
+      char link[PATH_MAX];
+      ssize_t len = readlinkat(procfd, special[i].link, link, sizeof(link) - 1);
+      if (len <= 0)
+         continue;
+      link[len] = '\0';
+
+      *fdata_ref = xCalloc(1, sizeof(OpenFiles_FileData));
+      OpenFiles_Data* item = &(*fdata_ref)->data;
+      fdata_ref = &(*fdata_ref)->next;
+
+      OpenFiles_Data_set(pdata, item, 'f', special[i].fd);
+      OpenFiles_Data_set(pdata, item, 'n', link);
+
+      struct stat st;
+      if (fstatat(procfd, special[i].link, &st, 0) == 0) {
+         OpenFiles_Data_set(pdata, item, 't', Platform_openFileType(&st, link));
+         Platform_setOpenFileStat(pdata, item, &st);
+      }
+   }
+
+   for (const struct dirent* de; (de = readdir(dirp)); ) {
+      char* end;
+      unsigned long int fdnum = strtoul(de->d_name, &end, 10);
+      if (end == de->d_name || *end || fdnum >= INT_MAX)
+         continue;
+
+      char link[PATH_MAX];
+      ssize_t len = readlinkat(dfd, de->d_name, link, sizeof(link) - 1);
+      if (len <= 0)
+         continue;
+      link[len] = '\0';
+
+      *fdata_ref = xCalloc(1, sizeof(OpenFiles_FileData));
+      OpenFiles_Data* item = &(*fdata_ref)->data;
+      fdata_ref = &(*fdata_ref)->next;
+
+      OpenFiles_Data_set(pdata, item, 'f', de->d_name);
+      OpenFiles_Data_set(pdata, item, 'n', link);
+
+      struct stat st;
+      if (fstatat(dfd, de->d_name, &st, 0) == 0) {
+         OpenFiles_Data_set(pdata, item, 't', Platform_openFileType(&st, link));
+         Platform_setOpenFileStat(pdata, item, &st);
+
+         if (S_ISSOCK(st.st_mode)) {
+            if (!socketsRead) {
+               SocketTable_read(&sockets, pid, ~0U);
+               socketsRead = true;
+            }
+
+            const SocketEntry* entry = SocketTable_find(&sockets, (uint64_t)st.st_ino);
+            if (entry)
+               Platform_describeSocket(pdata, item, entry);
+         }
+      }
+
+      if (infofd >= 0)
+         Platform_readOpenFileInfo(pdata, item, infofd, de->d_name);
+   }
+
+   if (socketsRead)
+      SocketTable_done(&sockets);
+   if (infofd >= 0)
+      close(infofd);
+   closedir(dirp);
+   close(procfd);
+
+   return pdata;
+}
+
+double Platform_getProcessIORate(const Process* proc) {
+   return LinuxProcess_totalIORate((const LinuxProcess*) proc);
+}
+
 void Platform_getPressureStall(const char* file, bool some, double* ten, double* sixty, double* threehundred) {
    *ten = *sixty = *threehundred = 0;
    char procname[128];
@@ -679,77 +1208,344 @@ void Platform_getFileDescriptors(double* used, double* max) {
    }
 }
 
-bool Platform_getDiskIO(DiskIOData* data) {
-   FILE* fp = fopen(PROCDIR "/diskstats", "r");
-   if (!fp)
+static int Platform_selfIOFd = -1;
+
+const OverheadCollector* Platform_getOverheadCollectors(void) {
+   static const OverheadCollector collectors[] = {
+      { .flag = PROCESS_FLAG_LINUX_SMAPS,     .name = "smaps" },
+      { .flag = PROCESS_FLAG_LINUX_LRS_FIX,   .name = "maps" },
+      { .flag = PROCESS_FLAG_LINUX_GPU,       .name = "GPU" },
+      { .flag = PROCESS_FLAG_LINUX_DELAYACCT, .name = "delayacct" },
+      { .flag = PROCESS_FLAG_LINUX_NUMA,      .name = "numa_maps" },
+      { .flag = PROCESS_FLAG_LINUX_SOCKETS,   .name = "sockets" },
+      { .flag = PROCESS_FLAG_LINUX_FDCOUNT,   .name = "fd count" },
+      { .flag = PROCESS_FLAG_LINUX_WCHAN,     .name = "wchan" },
+      { .flag = 0, .name = NULL }
+   };
+   return collectors;
+}
+
+bool Platform_getSelfIOCounters(uint64_t* reads, uint64_t* writes, uint64_t* bytes) {
+   /* Cost of our own earlier samples, kept out of the reported counters */
+   static uint64_t ownReads = 0;
+   static uint64_t ownBytes = 0;
+
+   if (Platform_selfIOFd < 0) {
+      Platform_selfIOFd = open(PROCDIR "/self/io", O_RDONLY);
+      if (Platform_selfIOFd < 0)
+         return false;
+   }
+
+   char buffer[256];
+   ssize_t r = pread(Platform_selfIOFd, buffer, sizeof(buffer) - 1, 0);
+   if (r <= 0)
       return false;
 
-   char lastTopDisk[32] = { '\0' };
+   buffer[r] = '\0';
+
+   uint64_t rchar = 0;
+   uint64_t syscr = 0;
+   uint64_t syscw = 0;
+   const char* line = buffer;
+   while (line) {
+      if (String_startsWith(line, "rchar: "))
+         rchar = strtoull(line + strlen("rchar: "), NULL, 10);
+      else if (String_startsWith(line, "syscr: "))
+         syscr = strtoull(line + strlen("syscr: "), NULL, 10);
+      else if (String_startsWith(line, "syscw: "))
+         syscw = strtoull(line + strlen("syscw: "), NULL, 10);
+
+      line = strchr(line, '\n');
+      if (line)
+         line++;
+   }
 
-   uint64_t read_sum = 0, write_sum = 0, timeSpend_sum = 0;
-   uint64_t numDisks = 0;
+   /* The kernel accounts a read after producing its content */
+   *reads = syscr - ownReads;
+   *writes = syscw;
+   *bytes = rchar - ownBytes;
+   ownReads += 1;
+   ownBytes += (uint64_t)r;
+   return true;
+}
 
-   char lineBuffer[256];
-   while (fgets(lineBuffer, sizeof(lineBuffer), fp)) {
-      char diskname[32];
-      unsigned long long int read_tmp, write_tmp, timeSpend_tmp;
-      if (sscanf(lineBuffer, "%*d %*d %31s %*u %*u %llu %*u %*u %*u %llu %*u %*u %llu", diskname, &read_tmp, &write_tmp, &timeSpend_tmp) == 4) {
-         if (String_startsWith(diskname, "dm-") ||
-             String_startsWith(diskname, "loop") ||
-             String_startsWith(diskname, "md") ||
-             String_startsWith(diskname, "zram"))
-            continue;
+typedef struct PlatformNode_ {
+   unsigned int id;
+   char* path;
+   ProcFile meminfo;
+} PlatformNode;
+
+static PlatformNode* Platform_nodes;
+static size_t Platform_nodeCount;
+static bool Platform_nodesScanned;
 
-         /* only count root disks, e.g. do not count IO from sda and sda1 twice */
-         if (lastTopDisk[0] && String_startsWith(diskname, lastTopDisk))
+static void Platform_scanNodes(void) {
+   Platform_nodesScanned = true;
+
+   DIR* dir = opendir("/sys/devices/system/node");
+   if (!dir)
+      return;
+
+   size_t size = 0;
+   const struct dirent* entry;
+   while ((entry = readdir(dir)) != NULL) {
+      if (!String_startsWith(entry->d_name, "node"))
+         continue;
+
+      char* endp;
+      unsigned long int id = strtoul(entry->d_name + 4, &endp, 10);
+      if (id >= UINT_MAX || endp == entry->d_name + 4 || *endp != '\0')
+         continue;
+
+      if (Platform_nodeCount == size) {
+         size = size ? size * 2 : 4;
+         Platform_nodes = xReallocArray(Platform_nodes, size, sizeof(PlatformNode));
+      }
+
+      /* readdir() iterates with no specific order, keep the nodes sorted */
+      size_t pos = Platform_nodeCount++;
+      while (pos > 0 && Platform_nodes[pos - 1].id > id) {
+         Platform_nodes[pos] = Platform_nodes[pos - 1];
+         pos--;
+      }
+
+      PlatformNode* node = &Platform_nodes[pos];
+      node->id = (unsigned int)id;
+      xAsprintf(&node->path, "/sys/devices/system/node/%s/meminfo", entry->d_name);
+   }
+
+   closedir(dir);
+
+   /* ProcFile keeps the path pointer, initialize once the array is final */
+   for (size_t i = 0; i < Platform_nodeCount; i++)
+      ProcFile_init(&Platform_nodes[i].meminfo, Platform_nodes[i].path);
+}
+
+size_t Platform_getNodeMemory(NodeMemory* nodes, size_t max) {
+   if (!Platform_nodesScanned)
+      Platform_scanNodes();
+
+   size_t count = 0;
+   for (size_t i = 0; i < Platform_nodeCount && count < max; i++) {
+      PlatformNode* node = &Platform_nodes[i];
+      if (!ProcFile_read(&node->meminfo))
+         continue;
+
+      unsigned long long total = 0, memFree = 0, filePages = 0, shmem = 0, sreclaimable = 0;
+
+      /* lines look like "Node 0 MemTotal:       16315520 kB" */
+      for (const char* line = node->meminfo.buffer; *line; line = ProcFile_nextLine(line)) {
+         const char* p = line;
+         if (!String_startsWith(p, "Node "))
             continue;
 
-         /* This assumes disks are listed directly before any of their partitions */
-         String_safeStrncpy(lastTopDisk, diskname, sizeof(lastTopDisk));
+         p = ProcFile_skipSpaces(p + strlen("Node "));
+         while (*p >= '0' && *p <= '9')
+            p++;
+         p = ProcFile_skipSpaces(p);
 
-         read_sum += read_tmp;
-         write_sum += write_tmp;
-         timeSpend_sum += timeSpend_tmp;
-         numDisks++;
+         #define tryReadNode(label, variable)                                                     \
+            if (String_startsWith(p, label)) {                                                    \
+               ProcFile_parseNumber(ProcFile_skipSpaces(p + strlen(label)), &(variable));         \
+               continue;                                                                          \
+            }
+
+         tryReadNode("MemTotal:", total)
+         tryReadNode("MemFree:", memFree)
+         tryReadNode("FilePages:", filePages)
+         tryReadNode("Shmem:", shmem)
+         tryReadNode("SReclaimable:", sreclaimable)
+
+         #undef tryReadNode
       }
+
+      if (!total)
+         continue;
+
+      /* same split as the Memory meter; FilePages includes shared memory */
+      unsigned long long cache = saturatingSub(filePages, shmem) + sreclaimable;
+      nodes[count] = (NodeMemory) {
+         .id = node->id,
+         .total = total,
+         .shared = shmem,
+         .cache = cache,
+         .used = saturatingSub(saturatingSub(total, memFree), shmem + cache),
+      };
+      count++;
    }
-   fclose(fp);
-   /* multiply with sector size */
-   data->totalBytesRead = 512 * read_sum;
-   data->totalBytesWritten = 512 * write_sum;
-   data->totalMsTimeSpend = timeSpend_sum;
-   data->numDisks = numDisks;
-   return true;
+
+   return count;
 }
 
-bool Platform_getNetworkIO(NetworkIOData* data) {
-   FILE* fp = fopen(PROCDIR "/net/dev", "r");
-   if (!fp)
+static ProcFile Platform_diskStatsFile;
+static ProcFile Platform_netDevFile;
+static IODeviceTable Platform_ioDevices;
+
+static const char* Platform_nextToken(const char* p, size_t* len) {
+   p = ProcFile_skipSpaces(p);
+
+   const char* end = p;
+   while (*end && *end != ' ' && *end != '\t' && *end != '\n')
+      end++;
+
+   *len = (size_t)(end - p);
+   return p;
+}
+
+static const char* Platform_parseFields(const char* p, unsigned long long* fields, size_t count) {
+   for (size_t i = 0; i < count; i++) {
+      fields[i] = 0;
+      p = ProcFile_parseNumber(ProcFile_skipSpaces(p), &fields[i]);
+   }
+   return p;
+}
+
+/* "sda1" of "sda", "nvme0n1p1" of "nvme0n1" */
+static bool Platform_isPartitionOf(const char* name, const char* disk) {
+   size_t len = strlen(disk);
+   if (len == 0 || strncmp(name, disk, len) != 0)
       return false;
 
-   char lineBuffer[512];
-   while (fgets(lineBuffer, sizeof(lineBuffer), fp)) {
-      char interfaceName[32];
-      unsigned long long int bytesReceived, packetsReceived, bytesTransmitted, packetsTransmitted;
-      if (sscanf(lineBuffer, "%31s %llu %llu %*u %*u %*u %*u %*u %*u %llu %llu",
-                             interfaceName,
-                             &bytesReceived,
-                             &packetsReceived,
-                             &bytesTransmitted,
-                             &packetsTransmitted) != 5)
+   /* disks whose name ends in a digit separate their partitions with a 'p' */
+   const char* suffix = name + len;
+   if (disk[len - 1] >= '0' && disk[len - 1] <= '9' && *suffix++ != 'p')
+      return false;
+   if (!*suffix)
+      return false;
+
+   for (; *suffix; suffix++) {
+      if (*suffix < '0' || *suffix > '9')
+         return false;
+   }
+   return true;
+}
+
+static void Platform_classifyDisk(const IODeviceTable* table, IODevice* device) {
+   /* only count root disks, e.g. do not count IO from sda and sda1 twice */
+   char path[128];
+   char sysName[IODEVICE_NAME_LEN];
+   String_safeStrncpy(sysName, device->name, sizeof(sysName));
+   for (char* c = sysName; *c; c++) {
+      if (*c == '/')
+         *c = '!';
+   }
+
+   bool isPartition;
+   xSnprintf(path, sizeof(path), "/sys/class/block/%s", sysName);
+   if (access(path, F_OK) == 0) {
+      xSnprintf(path, sizeof(path), "/sys/class/block/%s/partition", sysName);
+      isPartition = access(path, F_OK) == 0;
+   } else {
+      /* no sysfs (e.g. in containers): match the names of the disks listed so far */
+      isPartition = false;
+      for (size_t i = 0; i < table->count && !isPartition; i++) {
+         const IODevice* disk = &table->devices[i];
+         isPartition = disk != device && disk->kind == IODEVICE_DISK && disk->listed && Platform_isPartitionOf(device->name, disk->name);
+      }
+   }
+
+   device->listed = !isPartition;
+   device->summed = !isPartition &&
+                    !String_startsWith(device->name, "dm-") &&
+                    !String_startsWith(device->name, "loop") &&
+                    !String_startsWith(device->name, "md") &&
+                    !String_startsWith(device->name, "zram");
+}
+
+static void Platform_scanDiskStats(IODeviceTable* table) {
+   if (!ProcFile_read(&Platform_diskStatsFile))
+      return;
+
+   for (const char* line = Platform_diskStatsFile.buffer; *line; line = ProcFile_nextLine(line)) {
+      /* major minor name reads merged sectors ms writes merged sectors ms inflight io_ms ... */
+      unsigned long long ids[2];
+      const char* p = Platform_parseFields(line, ids, ARRAYSIZE(ids));
+
+      size_t nameLen;
+      const char* name = Platform_nextToken(p, &nameLen);
+
+      unsigned long long f[10];
+      Platform_parseFields(name + nameLen, f, ARRAYSIZE(f));
+
+      IODevice* device = IODeviceTable_update(table, IODEVICE_DISK, name, nameLen, 512 * f[2], 512 * f[6], f[0], f[4], f[9]);
+      if (device && device->isNew)
+         Platform_classifyDisk(table, device);
+   }
+}
+
+static void Platform_scanNetDev(IODeviceTable* table) {
+   if (!ProcFile_read(&Platform_netDevFile))
+      return;
+
+   for (const char* line = Platform_netDevFile.buffer; *line; line = ProcFile_nextLine(line)) {
+      /* "  eth0: rx_bytes rx_packets errs drop fifo frame compressed multicast tx_bytes tx_packets ..."
+         the two header lines contain no ':' before their end */
+      const char* name = ProcFile_skipSpaces(line);
+      const char* colon = name;
+      while (*colon && *colon != ':' && *colon != '\n')
+         colon++;
+      if (*colon != ':')
          continue;
 
-      if (String_eq(interfaceName, "lo:"))
+      unsigned long long f[10];
+      Platform_parseFields(colon + 1, f, ARRAYSIZE(f));
+
+      size_t nameLen = (size_t)(colon - name);
+      IODevice* device = IODeviceTable_update(table, IODEVICE_NETWORK, name, nameLen, f[0], f[8], f[1], f[9], 0);
+      if (device && device->isNew)
+         device->summed = !String_eq(device->name, "lo");
+   }
+}
+
+const IODeviceTable* Platform_getIODevices(void) {
+   uint64_t now;
+   Platform_gettime_monotonic(&now);
+
+   IODeviceTable* table = &Platform_ioDevices;
+   if (IODeviceTable_beginSample(table, now)) {
+      Platform_scanDiskStats(table);
+      Platform_scanNetDev(table);
+      IODeviceTable_endSample(table);
+   }
+
+   return table;
+}
+
+bool Platform_getDiskIO(DiskIOData* data) {
+   const IODeviceTable* table = Platform_getIODevices();
+   if (!table->haveDisks)
+      return false;
+
+   *data = (DiskIOData) { .sampleMs = table->sampleMs };
+   for (size_t i = 0; i < table->count; i++) {
+      const IODevice* device = &table->devices[i];
+      if (device->kind != IODEVICE_DISK || !device->summed)
          continue;
 
-      data->bytesReceived += bytesReceived;
-      data->packetsReceived += packetsReceived;
-      data->bytesTransmitted += bytesTransmitted;
-      data->packetsTransmitted += packetsTransmitted;
+      data->totalBytesRead += device->readBytes;
+      data->totalBytesWritten += device->writeBytes;
+      data->totalMsTimeSpend += device->busyMs;
+      data->numDisks++;
    }
+   return true;
+}
 
-   fclose(fp);
+bool Platform_getNetworkIO(NetworkIOData* data) {
+   const IODeviceTable* table = Platform_getIODevices();
+   if (!table->haveNetwork)
+      return false;
+
+   data->sampleMs = table->sampleMs;
+   for (size_t i = 0; i < table->count; i++) {
+      const IODevice* device = &table->devices[i];
+      if (device->kind != IODEVICE_NETWORK || !device->summed)
+         continue;
 
+      data->bytesReceived += device->readBytes;
+      data->packetsReceived += device->readOps;
+      data->bytesTransmitted += device->writeBytes;
+      data->packetsTransmitted += device->writeOps;
+   }
    return true;
 }
 
@@ -1145,6 +1941,10 @@ bool Platform_init(void) {
    LibSensors_init();
 #endif
 
+   ProcFile_init(&Platform_diskStatsFile, PROCDIR "/diskstats");
+   ProcFile_init(&Platform_netDevFile, PROCDIR "/net/dev");
+   IODeviceTable_init(&Platform_ioDevices);
+
    char target[PATH_MAX];
    ssize_t ret = readlink(PROCDIR "/self/ns/pid", target, sizeof(target) - 1);
    if (ret > 0) {
@@ -1176,4 +1976,21 @@ void Platform_done(void) {
 #ifdef HAVE_SENSORS_SENSORS_H
    LibSensors_cleanup();
 #endif
+
+   if (Platform_selfIOFd >= 0) {
+      close(Platform_selfIOFd);
+      Platform_selfIOFd = -1;
+   }
+   ProcFile_done(&Platform_diskStatsFile);
+   ProcFile_done(&Platform_netDevFile);
+   IODeviceTable_done(&Platform_ioDevices);
+
+   for (size_t i = 0; i < Platform_nodeCount; i++) {
+      ProcFile_done(&Platform_nodes[i].meminfo);
+      free(Platform_nodes[i].path);
+   }
+   free(Platform_nodes);
+   Platform_nodes = NULL;
+   Platform_nodeCount = 0;
+   Platform_nodesScanned = false;
 }
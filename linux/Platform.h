@@ -16,11 +16,16 @@ in the source distribution for its full text.
 
 #include "Action.h"
 #include "BatteryMeter.h"
+#include "CPUMeter.h"
 #include "DiskIOMeter.h"
 #include "Hashtable.h"
+#include "IODevices.h"
 #include "Macros.h"
 #include "MemoryMeter.h"
 #include "NetworkIOMeter.h"
+#include "NUMAMemoryMeter.h"
+#include "OpenFilesScreen.h"
+#include "OverheadBudget.h"
 #include "Panel.h"
 #include "Process.h"
 #include "ProcessLocksScreen.h"
@@ -68,10 +73,16 @@ pid_t Platform_getMaxPid(void);
 
 double Platform_setCPUValues(Meter* this, unsigned int cpu);
 
+/* Fills the utilisation (NAN if offline) and group of every existing CPU in one pass */
+bool Platform_getCPULoads(const Machine* host, CPUGrouping grouping, double* loads, int* groups);
+
 void Platform_setGPUValues(Meter* this, double* totalUsage, unsigned long long* totalGPUTimeDiff);
 
 void Platform_setMemoryValues(Meter* this);
 
+/* Fills up to max NUMA nodes in ascending id order; returns the count */
+size_t Platform_getNodeMemory(NodeMemory* nodes, size_t max);
+
 void Platform_setSwapValues(Meter* this);
 
 void Platform_setZramValues(Meter* this);
@@ -84,14 +95,31 @@ char* Platform_getProcessEnv(pid_t pid);
 
 FileLocks_ProcessData* Platform_getProcessLocks(pid_t pid);
 
+/* Every file lock of the system, ordered by PID; fd and filename are not resolved */
+FileLocks_ProcessData* Platform_getFileLocks(void);
+
+OpenFiles_ProcessData* Platform_getProcessOpenFiles(pid_t pid);
+
+/* Storage read and write rate of a process in bytes per second, NAN if unknown */
+double Platform_getProcessIORate(const Process* proc);
+
 void Platform_getPressureStall(const char* file, bool some, double* ten, double* sixty, double* threehundred);
 
 void Platform_getFileDescriptors(double* used, double* max);
 
+/* read(2) and write(2) calls and bytes read by htop itself, for the self-profiler */
+bool Platform_getSelfIOCounters(uint64_t* reads, uint64_t* writes, uint64_t* bytes);
+
+/* per-process collectors the overhead budget may throttle, most expensive first */
+const OverheadCollector* Platform_getOverheadCollectors(void);
+
 bool Platform_getDiskIO(DiskIOData* data);
 
 bool Platform_getNetworkIO(NetworkIOData* data);
 
+/* per-device counters and rates behind the two totals above */
+const IODeviceTable* Platform_getIODevices(void);
+
 void Platform_getBattery(double* percent, ACPresence* isOnAC);
 
 static inline void Platform_getHostname(char* buffer, size_t size) {
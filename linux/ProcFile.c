@@ -0,0 +1,100 @@
+/*
+htop - linux/ProcFile.c
+(C) 2026 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/ProcFile.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "XUtils.h"
+
+
+void ProcFile_init(ProcFile* this, const char* path) {
+   *this = (ProcFile) {
+      .path = path,
+      .fd = -1,
+   };
+}
+
+void ProcFile_done(ProcFile* this) {
+   if (this->fd >= 0)
+      close(this->fd);
+
+   free(this->buffer);
+   ProcFile_init(this, this->path);
+}
+
+bool ProcFile_read(ProcFile* this) {
+   if (this->fd < 0) {
+      this->fd = open(this->path, O_RDONLY | O_CLOEXEC);
+      if (this->fd < 0)
+         return false;
+   }
+
+   if (!this->buffer) {
+      this->size = 4096;
+      this->buffer = xMalloc(this->size);
+   }
+
+   size_t length = 0;
+   for (;;) {
+      if (length + 1 >= this->size) {
+         this->size *= 2;
+         this->buffer = xRealloc(this->buffer, this->size);
+      }
+
+      ssize_t n = pread(this->fd, this->buffer + length, this->size - length - 1, (off_t)length);
+      if (n < 0) {
+         if (errno == EINTR)
+            continue;
+
+         close(this->fd);
+         this->fd = -1;
+         return false;
+      }
+      if (n == 0)
+         break;
+
+      length += (size_t)n;
+   }
+
+   this->buffer[length] = '\0';
+   this->length = length;
+   return true;
+}
+
+bool ProcFile_parseCPUTimes(const char* line, int* cpuId, unsigned long long values[PROCFILE_CPU_FIELDS]) {
+   if (line[0] != 'c' || line[1] != 'p' || line[2] != 'u')
+      return false;
+
+   const char* p = line + 3;
+   if (*p == ' ') {
+      *cpuId = -1;
+   } else {
+      unsigned long long id;
+      const char* end = ProcFile_parseNumber(p, &id);
+      if (end == p || *end != ' ' || id > INT_MAX)
+         return false;
+
+      *cpuId = (int)id;
+      p = end;
+   }
+
+   for (size_t i = 0; i < PROCFILE_CPU_FIELDS; i++) {
+      values[i] = 0;
+
+      p = ProcFile_skipSpaces(p);
+      p = ProcFile_parseNumber(p, &values[i]);
+   }
+
+   return true;
+}
@@ -0,0 +1,69 @@
+#ifndef HEADER_ProcFile
+#define HEADER_ProcFile
+/*
+htop - linux/ProcFile.h
+(C) 2026 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+
+
+/* Number of time fields on a "cpu" line of /proc/stat (user .. guest_nice) */
+#define PROCFILE_CPU_FIELDS 10
+
+/*
+ * A system-wide proc file that is read every scan. The descriptor stays
+ * open and the whole file is fetched with pread() from offset 0 into a
+ * buffer that only ever grows, so a scan costs no open/close and no
+ * stdio buffering. The buffer is always NUL-terminated.
+ */
+typedef struct ProcFile_ {
+   const char* path;
+   int fd;
+   char* buffer;
+   size_t size;
+   size_t length;
+} ProcFile;
+
+void ProcFile_init(ProcFile* this, const char* path);
+
+void ProcFile_done(ProcFile* this);
+
+bool ProcFile_read(ProcFile* this);
+
+static inline const char* ProcFile_skipSpaces(const char* p) {
+   while (*p == ' ' || *p == '\t')
+      p++;
+   return p;
+}
+
+/* Parses a decimal number; returns p unchanged if there is none */
+static inline const char* ProcFile_parseNumber(const char* p, unsigned long long* value) {
+   unsigned long long v = 0;
+   const char* start = p;
+
+   while (*p >= '0' && *p <= '9') {
+      v = v * 10 + (unsigned long long)(*p - '0');
+      p++;
+   }
+
+   if (p != start)
+      *value = v;
+   return p;
+}
+
+/* Returns the start of the following line, or the terminating NUL */
+static inline const char* ProcFile_nextLine(const char* p) {
+   while (*p && *p != '\n')
+      p++;
+   return *p ? p + 1 : p;
+}
+
+/* Parses a "cpu" (cpuId -1) or "cpuN" line of /proc/stat. Fields missing on
+ * older kernels are set to zero. Returns false for any other line. */
+bool ProcFile_parseCPUTimes(const char* line, int* cpuId, unsigned long long values[PROCFILE_CPU_FIELDS]);
+
+#endif
@@ -0,0 +1,163 @@
+/*
+htop - linux/ProcLocks.c
+(C) 2026 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/ProcLocks.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/sysmacros.h>
+
+#include "XUtils.h"
+
+#include "linux/ProcFile.h"
+
+
+static const char* ProcLocks_token(const char* p, char* out, size_t size) {
+   p = ProcFile_skipSpaces(p);
+
+   size_t len = 0;
+   while (*p && *p != ' ' && *p != '\t' && *p != '\n') {
+      if (len + 1 < size)
+         out[len++] = *p;
+      p++;
+   }
+   out[len] = '\0';
+
+   return p;
+}
+
+static const char* ProcLocks_hex(const char* p, unsigned long long* value) {
+   unsigned long long v = 0;
+   for (;; p++) {
+      if (*p >= '0' && *p <= '9')
+         v = v * 16 + (unsigned long long)(*p - '0');
+      else if (*p >= 'a' && *p <= 'f')
+         v = v * 16 + (unsigned long long)(*p - 'a' + 10);
+      else
+         break;
+   }
+   *value = v;
+   return p;
+}
+
+/* "1: POSIX  ADVISORY  WRITE 1234 08:01:5678 0 EOF", waiters as "1: -> POSIX ..." */
+static bool ProcLocks_parseLine(const char* p, ProcLocks_Entry* entry) {
+   unsigned long long id;
+   const char* q = ProcFile_parseNumber(p, &id);
+   if (q == p || *q != ':')
+      return false;
+
+   entry->id = (unsigned int)id;
+   p = ProcFile_skipSpaces(q + 1);
+   entry->blocked = String_startsWith(p, "->");
+   if (entry->blocked)
+      p += 2;
+
+   p = ProcLocks_token(p, entry->locktype, sizeof(entry->locktype));
+   p = ProcLocks_token(p, entry->exclusive, sizeof(entry->exclusive));
+   p = ProcLocks_token(p, entry->readwrite, sizeof(entry->readwrite));
+
+   p = ProcFile_skipSpaces(p);
+   bool negative = *p == '-';
+   unsigned long long pid = 0;
+   q = ProcFile_parseNumber(p + negative, &pid);
+   if (q == p + negative)
+      return false;
+   entry->pid = negative ? -1 : (pid_t)pid;
+
+   unsigned long long major, minor, inode = 0;
+   p = ProcLocks_hex(ProcFile_skipSpaces(q), &major);
+   if (*p != ':')
+      return false;
+   p = ProcLocks_hex(p + 1, &minor);
+   if (*p != ':')
+      return false;
+   p = ProcFile_parseNumber(p + 1, &inode);
+   entry->dev = makedev((unsigned int)major, (unsigned int)minor);
+   entry->inode = inode;
+
+   unsigned long long start = 0, end = 0;
+   p = ProcFile_parseNumber(ProcFile_skipSpaces(p), &start);
+   p = ProcFile_skipSpaces(p);
+   entry->start = start;
+   if (String_startsWith(p, "EOF")) {
+      entry->end = UINT64_MAX;
+   } else {
+      ProcFile_parseNumber(p, &end);
+      entry->end = end;
+   }
+
+   return true;
+}
+
+static int ProcLocks_compare(const void* v1, const void* v2) {
+   const ProcLocks_Entry* e1 = v1;
+   const ProcLocks_Entry* e2 = v2;
+   if (e1->pid != e2->pid)
+      return e1->pid < e2->pid ? -1 : 1;
+
+   /* keep the kernel's order within a process */
+   if (e1->id != e2->id)
+      return e1->id < e2->id ? -1 : 1;
+
+   return (int)e1->blocked - (int)e2->blocked;
+}
+
+bool ProcLocks_read(ProcLocks* this) {
+   *this = (ProcLocks) { .entries = NULL };
+
+   ProcFile file;
+   ProcFile_init(&file, PROCDIR "/locks");
+   if (!ProcFile_read(&file)) {
+      ProcFile_done(&file);
+      return false;
+   }
+
+   size_t size = 0;
+   for (const char* line = file.buffer; *line; line = ProcFile_nextLine(line)) {
+      if (this->count == size) {
+         size = size ? size * 2 : 32;
+         this->entries = xReallocArray(this->entries, size, sizeof(ProcLocks_Entry));
+      }
+
+      if (ProcLocks_parseLine(line, &this->entries[this->count]))
+         this->count++;
+   }
+
+   ProcFile_done(&file);
+
+   if (this->count > 1)
+      qsort(this->entries, this->count, sizeof(ProcLocks_Entry), ProcLocks_compare);
+
+   return true;
+}
+
+void ProcLocks_done(ProcLocks* this) {
+   free(this->entries);
+   *this = (ProcLocks) { .entries = NULL };
+}
+
+const ProcLocks_Entry* ProcLocks_find(const ProcLocks* this, pid_t pid, size_t* count) {
+   size_t lo = 0;
+   size_t hi = this->count;
+   while (lo < hi) {
+      size_t mid = lo + (hi - lo) / 2;
+      if (this->entries[mid].pid < pid)
+         lo = mid + 1;
+      else
+         hi = mid;
+   }
+
+   size_t end = lo;
+   while (end < this->count && this->entries[end].pid == pid)
+      end++;
+
+   *count = end - lo;
+   return *count ? &this->entries[lo] : NULL;
+}
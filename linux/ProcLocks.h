@@ -0,0 +1,46 @@
+#ifndef HEADER_ProcLocks
+#define HEADER_ProcLocks
+/*
+htop - linux/ProcLocks.h
+(C) 2026 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+
+typedef struct ProcLocks_Entry_ {
+   unsigned int id;       /* position in /proc/locks, shared by a lock and its waiters */
+   pid_t pid;             /* -1 for open file description locks */
+   bool blocked;          /* waiting for the lock listed before it */
+   char locktype[16];
+   char exclusive[16];
+   char readwrite[16];
+   dev_t dev;
+   uint64_t inode;
+   uint64_t start;
+   uint64_t end;          /* UINT64_MAX for "EOF" */
+} ProcLocks_Entry;
+
+/*
+ * All file locks of the system from a single read of /proc/locks,
+ * ordered by PID so the locks of one process are looked up by bisection
+ * instead of scanning each of its file descriptors.
+ */
+typedef struct ProcLocks_ {
+   ProcLocks_Entry* entries;
+   size_t count;
+} ProcLocks;
+
+bool ProcLocks_read(ProcLocks* this);
+
+void ProcLocks_done(ProcLocks* this);
+
+/* Returns the first lock held or awaited by pid and their number in count */
+const ProcLocks_Entry* ProcLocks_find(const ProcLocks* this, pid_t pid, size_t* count);
+
+#endif
@@ -49,6 +49,15 @@ in the source distribution for its full text.
    GPU_PERCENT = 133,            \
    ISCONTAINER = 134,            \
    M_EPSS = 135,                 \
+   NUMA_HOME = 136,              \
+   M_NUMA_REMOTE = 137,          \
+   NUMA_PAGES = 138,             \
+   NUMA_MEMS = 139,              \
+   SOCK_ESTABLISHED = 140,       \
+   SOCK_LISTEN = 141,            \
+   SOCKETS = 142,                \
+   FD_COUNT = 143,               \
+   WCHAN = 144,                  \
    // End of list
 
 
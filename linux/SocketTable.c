@@ -0,0 +1,265 @@
+/*
+htop - linux/SocketTable.c
+(C) 2026 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/SocketTable.h"
+
+#include <arpa/inet.h>
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Macros.h"
+#include "XUtils.h"
+
+#include "linux/ProcFile.h"
+
+
+static const char* const SocketTable_files[SOCKET_PROTOCOL_COUNT] = {
+   [SOCKET_TCP]  = "tcp",
+   [SOCKET_TCP6] = "tcp6",
+   [SOCKET_UDP]  = "udp",
+   [SOCKET_UDP6] = "udp6",
+   [SOCKET_UNIX] = "unix",
+};
+
+static const char* const SocketTable_tcpStates[] = {
+   [1] = "ESTABLISHED",
+   [2] = "SYN_SENT",
+   [3] = "SYN_RECV",
+   [4] = "FIN_WAIT1",
+   [5] = "FIN_WAIT2",
+   [6] = "TIME_WAIT",
+   [7] = "CLOSE",
+   [8] = "CLOSE_WAIT",
+   [9] = "LAST_ACK",
+   [10] = "LISTEN",
+   [11] = "CLOSING",
+};
+
+static const char* SocketTable_hex(const char* p, uint32_t* value) {
+   uint32_t v = 0;
+   for (;; p++) {
+      if (*p >= '0' && *p <= '9')
+         v = v * 16 + (uint32_t)(*p - '0');
+      else if (*p >= 'A' && *p <= 'F')
+         v = v * 16 + (uint32_t)(*p - 'A' + 10);
+      else if (*p >= 'a' && *p <= 'f')
+         v = v * 16 + (uint32_t)(*p - 'a' + 10);
+      else
+         break;
+   }
+   *value = v;
+   return p;
+}
+
+/* The kernel prints each 32 bit word of the address as a native integer */
+static const char* SocketTable_parseAddress(const char* p, uint8_t* address, size_t words, uint16_t* port) {
+   for (size_t i = 0; i < words; i++) {
+      char word[9];
+      for (size_t j = 0; j < 8; j++) {
+         /* stops at the terminating NUL of a truncated line */
+         if (!isxdigit((unsigned char)p[j]))
+            return NULL;
+         word[j] = p[j];
+      }
+      word[8] = '\0';
+
+      uint32_t value;
+      SocketTable_hex(word, &value);
+      memcpy(address + 4 * i, &value, sizeof(value));
+      p += 8;
+   }
+
+   if (*p != ':')
+      return NULL;
+
+   uint32_t value;
+   p = SocketTable_hex(p + 1, &value);
+   *port = (uint16_t)value;
+   return p;
+}
+
+/* "  0: 0100007F:0016 00000000:0000 0A 00000000:00000000 00:00000000 00000000  0  0 12345 ..." */
+static bool SocketTable_parseInet(const char* line, SocketEntry* entry) {
+   size_t words = SocketEntry_isInet6(entry) ? 4 : 1;
+
+   const char* p = strchr(line, ':');
+   if (!p)
+      return false;
+
+   p = SocketTable_parseAddress(ProcFile_skipSpaces(p + 1), entry->local, words, &entry->localPort);
+   if (!p)
+      return false;
+   p = SocketTable_parseAddress(ProcFile_skipSpaces(p), entry->remote, words, &entry->remotePort);
+   if (!p)
+      return false;
+
+   uint32_t state;
+   p = SocketTable_hex(ProcFile_skipSpaces(p), &state);
+   entry->state = state;
+
+   /* skip tx_queue:rx_queue, tr:tm->when, retrnsmt, uid and timeout */
+   for (int field = 0; field < 5; field++) {
+      p = ProcFile_skipSpaces(p);
+      while (*p && *p != ' ' && *p != '\n')
+         p++;
+   }
+
+   unsigned long long inode = 0;
+   const char* start = ProcFile_skipSpaces(p);
+   if (ProcFile_parseNumber(start, &inode) == start)
+      return false;
+
+   entry->inode = inode;
+   return true;
+}
+
+/* "0000000000000000: 00000002 00000000 00010000 0001 01 12345 /run/socket" */
+static bool SocketTable_parseUnix(const char* line, SocketEntry* entry) {
+   const char* p = strchr(line, ':');
+   if (!p)
+      return false;
+
+   p++;
+   uint32_t value;
+   for (int field = 0; field < 4; field++)
+      p = SocketTable_hex(ProcFile_skipSpaces(p), &value);
+
+   p = SocketTable_hex(ProcFile_skipSpaces(p), &value);
+   entry->state = value;
+
+   unsigned long long inode = 0;
+   const char* start = ProcFile_skipSpaces(p);
+   p = ProcFile_parseNumber(start, &inode);
+   if (p == start)
+      return false;
+
+   entry->inode = inode;
+
+   p = ProcFile_skipSpaces(p);
+   const char* end = p;
+   while (*end && *end != '\n')
+      end++;
+   if (end > p)
+      entry->path = xStrndup(p, (size_t)(end - p));
+
+   return true;
+}
+
+static int SocketTable_compare(const void* v1, const void* v2) {
+   const SocketEntry* e1 = v1;
+   const SocketEntry* e2 = v2;
+   return SPACESHIP_NUMBER(e1->inode, e2->inode);
+}
+
+bool SocketTable_read(SocketTable* this, pid_t pid, unsigned int protocols) {
+   *this = (SocketTable) { .entries = NULL };
+
+   bool any = false;
+   for (int protocol = 0; protocol < SOCKET_PROTOCOL_COUNT; protocol++) {
+      if (!(protocols & (1U << protocol)))
+         continue;
+
+      char path[64];
+      xSnprintf(path, sizeof(path), PROCDIR "/%d/net/%s", pid, SocketTable_files[protocol]);
+
+      ProcFile file;
+      ProcFile_init(&file, path);
+      if (!ProcFile_read(&file)) {
+         ProcFile_done(&file);
+         continue;
+      }
+      any = true;
+
+      /* the first line holds the column titles */
+      for (const char* line = ProcFile_nextLine(file.buffer); *line; line = ProcFile_nextLine(line)) {
+         if (this->count == this->size) {
+            this->size = this->size ? this->size * 2 : 64;
+            this->entries = xReallocArray(this->entries, this->size, sizeof(SocketEntry));
+         }
+
+         SocketEntry* entry = &this->entries[this->count];
+         *entry = (SocketEntry) { .protocol = (SocketProtocol)protocol };
+
+         bool ok = protocol == SOCKET_UNIX ? SocketTable_parseUnix(line, entry) : SocketTable_parseInet(line, entry);
+         if (ok && entry->inode)
+            this->count++;
+         else
+            free(entry->path);
+      }
+
+      ProcFile_done(&file);
+   }
+
+   if (this->count > 1)
+      qsort(this->entries, this->count, sizeof(SocketEntry), SocketTable_compare);
+
+   return any;
+}
+
+void SocketTable_done(SocketTable* this) {
+   for (size_t i = 0; i < this->count; i++)
+      free(this->entries[i].path);
+   free(this->entries);
+   *this = (SocketTable) { .entries = NULL };
+}
+
+const SocketEntry* SocketTable_find(const SocketTable* this, uint64_t inode) {
+   size_t lo = 0;
+   size_t hi = this->count;
+   while (lo < hi) {
+      size_t mid = lo + (hi - lo) / 2;
+      if (this->entries[mid].inode < inode)
+         lo = mid + 1;
+      else
+         hi = mid;
+   }
+
+   return lo < this->count && this->entries[lo].inode == inode ? &this->entries[lo] : NULL;
+}
+
+static void SocketEntry_formatEndpoint(const SocketEntry* this, const uint8_t* address, uint16_t port, char* buffer, size_t size) {
+   static const uint8_t any[16] = { 0 };
+   bool inet6 = SocketEntry_isInet6(this);
+
+   char host[INET6_ADDRSTRLEN] = "*";
+   if (memcmp(address, any, inet6 ? 16 : 4) != 0)
+      inet_ntop(inet6 ? AF_INET6 : AF_INET, address, host, sizeof(host));
+
+   char portText[8] = "*";
+   if (port)
+      xSnprintf(portText, sizeof(portText), "%u", port);
+
+   xSnprintf(buffer, size, inet6 && host[0] != '*' ? "[%s]:%s" : "%s:%s", host, portText);
+}
+
+void SocketEntry_describe(const SocketEntry* this, char* buffer, size_t size) {
+   if (this->protocol == SOCKET_UNIX) {
+      xSnprintf(buffer, size, "%s", this->path ? this->path : "unix socket");
+      return;
+   }
+
+   bool tcp = this->protocol == SOCKET_TCP || this->protocol == SOCKET_TCP6;
+
+   char local[INET6_ADDRSTRLEN + 16];
+   SocketEntry_formatEndpoint(this, this->local, this->localPort, local, sizeof(local));
+
+   char remote[INET6_ADDRSTRLEN + 16] = "";
+   if (this->remotePort) {
+      remote[0] = '-';
+      remote[1] = '>';
+      SocketEntry_formatEndpoint(this, this->remote, this->remotePort, remote + 2, sizeof(remote) - 2);
+   }
+
+   const char* state = tcp && this->state < ARRAYSIZE(SocketTable_tcpStates) ? SocketTable_tcpStates[this->state] : NULL;
+   if (state)
+      xSnprintf(buffer, size, "%s %s%s (%s)", tcp ? "TCP" : "UDP", local, remote, state);
+   else
+      xSnprintf(buffer, size, "%s %s%s", tcp ? "TCP" : "UDP", local, remote);
+}
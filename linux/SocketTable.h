@@ -0,0 +1,65 @@
+#ifndef HEADER_SocketTable
+#define HEADER_SocketTable
+/*
+htop - linux/SocketTable.h
+(C) 2026 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+
+typedef enum SocketProtocol_ {
+   SOCKET_TCP,
+   SOCKET_TCP6,
+   SOCKET_UDP,
+   SOCKET_UDP6,
+   SOCKET_UNIX,
+   SOCKET_PROTOCOL_COUNT
+} SocketProtocol;
+
+/* TCP states as numbered by the kernel in /proc/net/tcp */
+#define SOCKET_TCP_ESTABLISHED 1
+#define SOCKET_TCP_LISTEN      10
+
+typedef struct SocketEntry_ {
+   uint64_t inode;
+   SocketProtocol protocol;
+   unsigned int state;
+   uint16_t localPort;
+   uint16_t remotePort;
+   uint8_t local[16];     /* network order, the first 4 bytes for IPv4 */
+   uint8_t remote[16];
+   char* path;            /* bound path of unix sockets, or NULL */
+} SocketEntry;
+
+/*
+ * The sockets of one network namespace, from a single parse of the
+ * /proc/<pid>/net tables, sorted by inode so that the "socket:[inode]"
+ * links of a process are resolved by bisection.
+ */
+typedef struct SocketTable_ {
+   SocketEntry* entries;
+   size_t count;
+   size_t size;
+} SocketTable;
+
+/* Reads the protocols selected in the mask (1 << SocketProtocol) as seen by pid */
+bool SocketTable_read(SocketTable* this, pid_t pid, unsigned int protocols);
+
+void SocketTable_done(SocketTable* this);
+
+const SocketEntry* SocketTable_find(const SocketTable* this, uint64_t inode);
+
+/* Formats the entry like lsof, e.g. "TCP 127.0.0.1:22->127.0.0.1:40506 (ESTABLISHED)" */
+void SocketEntry_describe(const SocketEntry* this, char* buffer, size_t size);
+
+static inline bool SocketEntry_isInet6(const SocketEntry* this) {
+   return this->protocol == SOCKET_TCP6 || this->protocol == SOCKET_UDP6;
+}
+
+#endif
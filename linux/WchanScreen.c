@@ -0,0 +1,205 @@
+/*
+htop - linux/WchanScreen.c
+(C) 2026 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/WchanScreen.h"
+
+#include <dirent.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+
+#include "Macros.h"
+#include "Panel.h"
+#include "Platform.h"
+#include "ProvideCurses.h"
+#include "Vector.h"
+#include "XUtils.h"
+
+#include "linux/LinuxProcess.h"
+#include "linux/LinuxProcessTable.h"
+
+
+WchanScreen* WchanScreen_new(void) {
+   WchanScreen* this = xMalloc(sizeof(WchanScreen));
+   Object_setClass(this, Class(WchanScreen));
+   this->histogram = (WchanHistogram) { .entries = NULL };
+   this->collectedMs = 0;
+   return (WchanScreen*) InfoScreen_init(&this->super, NULL, NULL, LINES - 2, "      D       S  WCHAN");
+}
+
+void WchanScreen_delete(Object* cast) {
+   WchanScreen* this = (WchanScreen*) cast;
+   free(this->histogram.entries);
+   free(InfoScreen_done(&this->super));
+}
+
+static void WchanScreen_draw(InfoScreen* this) {
+   InfoScreen_drawTitled(this, "Wait channels of blocked (D) and sleeping (S) tasks, every %d s", LINUX_SLOW_SCAN_INTERVAL_MS / 1000);
+}
+
+static void WchanHistogram_add(WchanHistogram* this, const char* name, char state) {
+   if (this->count == this->size) {
+      this->size = this->size ? this->size * 2 : 256;
+      this->entries = xReallocArray(this->entries, this->size, sizeof(WchanCount));
+   }
+
+   WchanCount* entry = &this->entries[this->count++];
+   String_safeStrncpy(entry->name, name, sizeof(entry->name));
+   entry->blocked = state == 'D';
+   entry->sleeping = state == 'S';
+
+   if (state == 'D')
+      this->blocked++;
+   else
+      this->sleeping++;
+}
+
+static void WchanHistogram_scanProcess(WchanHistogram* this, pid_t pid) {
+   char path[64];
+   xSnprintf(path, sizeof(path), PROCDIR "/%d/task", pid);
+
+   DIR* dir = opendir(path);
+   if (!dir)
+      return;
+
+   const struct dirent* entry;
+   while ((entry = readdir(dir))) {
+      if (entry->d_name[0] < '0' || entry->d_name[0] > '9')
+         continue;
+
+      pid_t tid = atoi(entry->d_name);
+      char state = LinuxProcess_readTaskState(pid, tid);
+      if (state != 'D' && state != 'S')
+         continue;
+
+      char wchan[64];
+      if (!LinuxProcess_readWchan(pid, tid, wchan, sizeof(wchan)))
+         xSnprintf(wchan, sizeof(wchan), "?");
+
+      WchanHistogram_add(this, wchan, state);
+   }
+
+   closedir(dir);
+}
+
+static int WchanCount_compareName(const void* a, const void* b) {
+   return strcmp(((const WchanCount*)a)->name, ((const WchanCount*)b)->name);
+}
+
+/* Most blocked tasks first, then most sleeping tasks */
+static int WchanCount_compareCount(const void* a, const void* b) {
+   const WchanCount* ca = a;
+   const WchanCount* cb = b;
+   if (ca->blocked != cb->blocked)
+      return ca->blocked > cb->blocked ? -1 : 1;
+   if (ca->sleeping != cb->sleeping)
+      return ca->sleeping > cb->sleeping ? -1 : 1;
+   return strcmp(ca->name, cb->name);
+}
+
+static void WchanHistogram_collapse(WchanHistogram* this) {
+   if (this->count == 0)
+      return;
+
+   qsort(this->entries, this->count, sizeof(WchanCount), WchanCount_compareName);
+
+   size_t kept = 0;
+   for (size_t i = 1; i < this->count; i++) {
+      WchanCount* last = &this->entries[kept];
+      if (String_eq(last->name, this->entries[i].name)) {
+         last->blocked += this->entries[i].blocked;
+         last->sleeping += this->entries[i].sleeping;
+      } else {
+         this->entries[++kept] = this->entries[i];
+      }
+   }
+   this->count = kept + 1;
+
+   qsort(this->entries, this->count, sizeof(WchanCount), WchanCount_compareCount);
+}
+
+/* Walks every task of the system; false if PROCDIR cannot be read */
+static bool WchanScreen_collect(WchanScreen* this) {
+   WchanHistogram* histogram = &this->histogram;
+   histogram->count = 0;
+   histogram->blocked = 0;
+   histogram->sleeping = 0;
+   Platform_gettime_monotonic(&this->collectedMs);
+
+   DIR* dir = opendir(PROCDIR);
+   if (!dir)
+      return false;
+
+   const struct dirent* entry;
+   while ((entry = readdir(dir))) {
+      if (entry->d_name[0] < '0' || entry->d_name[0] > '9')
+         continue;
+
+      WchanHistogram_scanProcess(histogram, atoi(entry->d_name));
+   }
+   closedir(dir);
+
+   WchanHistogram_collapse(histogram);
+   return true;
+}
+
+static void WchanScreen_scan(InfoScreen* super) {
+   WchanScreen* this = (WchanScreen*) super;
+   Panel* panel = super->display;
+   int idx = MAXIMUM(Panel_getSelectedIndex(panel), 0);
+
+   Panel_prune(panel);
+
+   if (!WchanScreen_collect(this)) {
+      InfoScreen_addLine(super, "Could not read " PROCDIR ".");
+      return;
+   }
+
+   const WchanHistogram* histogram = &this->histogram;
+   char line[96];
+   xSnprintf(line, sizeof(line), "%7u %7u  (total)", histogram->blocked, histogram->sleeping);
+   InfoScreen_addLine(super, line);
+
+   for (size_t i = 0; i < histogram->count; i++) {
+      const WchanCount* count = &histogram->entries[i];
+      xSnprintf(line, sizeof(line), "%7u %7u  %s", count->blocked, count->sleeping, count->name);
+      InfoScreen_addLine(super, line);
+   }
+
+   Panel_setSelected(panel, idx);
+}
+
+/*
+ * Walking all tasks is the heaviest /proc load htop generates, and it is
+ * most likely wanted while the system is stuck: keep the last histogram
+ * until the slow-scan interval has passed. F5 walks the tasks at once.
+ */
+static void WchanScreen_refresh(InfoScreen* super) {
+   const WchanScreen* this = (const WchanScreen*) super;
+
+   uint64_t nowMs;
+   Platform_gettime_monotonic(&nowMs);
+   if (nowMs - this->collectedMs < LINUX_SLOW_SCAN_INTERVAL_MS)
+      return;
+
+   Vector_prune(super->lines);
+   WchanScreen_scan(super);
+   InfoScreen_draw(super);
+}
+
+const InfoScreenClass WchanScreen_class = {
+   .super = {
+      .extends = Class(Object),
+      .delete = WchanScreen_delete
+   },
+   .scan = WchanScreen_scan,
+   .draw = WchanScreen_draw,
+   .onErr = WchanScreen_refresh
+};
@@ -0,0 +1,43 @@
+#ifndef HEADER_WchanScreen
+#define HEADER_WchanScreen
+/*
+htop - linux/WchanScreen.h
+(C) 2026 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "InfoScreen.h"
+#include "Object.h"
+
+
+typedef struct WchanCount_ {
+   char name[64];
+   unsigned int blocked;   /* tasks in state D */
+   unsigned int sleeping;  /* tasks in state S */
+} WchanCount;
+
+typedef struct WchanHistogram_ {
+   WchanCount* entries;
+   size_t count;
+   size_t size;
+   unsigned int blocked;
+   unsigned int sleeping;
+} WchanHistogram;
+
+typedef struct WchanScreen_ {
+   InfoScreen super;
+   WchanHistogram histogram;   /* kept between refreshes */
+   uint64_t collectedMs;       /* monotonic time of the last walk of all tasks */
+} WchanScreen;
+
+extern const InfoScreenClass WchanScreen_class;
+
+WchanScreen* WchanScreen_new(void);
+
+void WchanScreen_delete(Object* this);
+
+#endif
@@ -271,6 +271,9 @@ const ProcessClass NetBSDProcess_class = {
       .isVisible = Process_rowIsVisible,
       .matchesFilter = Process_rowMatchesFilter,
       .compareByParent = Process_compareByParent,
+      .subtreeReset = Process_subtreeReset,
+      .subtreeAdd = Process_subtreeAdd,
+      .sortKeyValue = Process_rowSortKeyValue,
       .sortKeyString = Process_rowGetSortKey,
       .writeField = NetBSDProcess_rowWriteField
    },
@@ -10,6 +10,7 @@ Released under the GNU GPLv2+, see the COPYING file
 in the source distribution for its full text.
 */
 
+#include <math.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
@@ -18,9 +19,14 @@ in the source distribution for its full text.
 
 #include "Action.h"
 #include "BatteryMeter.h"
+#include "CPUMeter.h"
 #include "DiskIOMeter.h"
+#include "IODevices.h"
 #include "MemoryMeter.h"
 #include "NetworkIOMeter.h"
+#include "NUMAMemoryMeter.h"
+#include "OpenFilesScreen.h"
+#include "OverheadBudget.h"
 #include "Process.h"
 #include "ProcessLocksScreen.h"
 #include "SignalsPanel.h"
@@ -63,16 +69,48 @@ pid_t Platform_getMaxPid(void);
 
 double Platform_setCPUValues(Meter* this, int cpu);
 
+static inline bool Platform_getCPULoads(ATTR_UNUSED const Machine* host, ATTR_UNUSED CPUGrouping grouping, ATTR_UNUSED double* loads, ATTR_UNUSED int* groups) {
+   return false;
+}
+
 void Platform_setMemoryValues(Meter* this);
 
+static inline size_t Platform_getNodeMemory(ATTR_UNUSED NodeMemory* nodes, ATTR_UNUSED size_t max) {
+   return 0;
+}
+
 void Platform_setSwapValues(Meter* this);
 
 char* Platform_getProcessEnv(pid_t pid);
 
 FileLocks_ProcessData* Platform_getProcessLocks(pid_t pid);
 
+static inline FileLocks_ProcessData* Platform_getFileLocks(void) {
+   return NULL;
+}
+
+static inline OpenFiles_ProcessData* Platform_getProcessOpenFiles(ATTR_UNUSED pid_t pid) {
+   return NULL;
+}
+
+static inline double Platform_getProcessIORate(ATTR_UNUSED const Process* proc) {
+   return NAN;
+}
+
 void Platform_getFileDescriptors(double* used, double* max);
 
+static inline bool Platform_getSelfIOCounters(ATTR_UNUSED uint64_t* reads, ATTR_UNUSED uint64_t* writes, ATTR_UNUSED uint64_t* bytes) {
+   return false;
+}
+
+static inline const OverheadCollector* Platform_getOverheadCollectors(void) {
+   return NULL;
+}
+
+static inline const IODeviceTable* Platform_getIODevices(void) {
+   return NULL;
+}
+
 bool Platform_getDiskIO(DiskIOData* data);
 
 bool Platform_getNetworkIO(NetworkIOData* data);
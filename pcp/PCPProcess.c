@@ -117,7 +117,7 @@ static void PCPProcess_printDelay(float delay_percent, char* buffer, size_t n) {
    }
 }
 
-static double PCPProcess_totalIORate(const PCPProcess* pp) {
+double PCPProcess_totalIORate(const PCPProcess* pp) {
    double totalRate = NAN;
    if (isNonnegative(pp->io_rate_read_bps)) {
       totalRate = pp->io_rate_read_bps;
@@ -163,7 +163,7 @@ static void PCPProcess_rowWriteField(const Row* super, RichString* str, ProcessF
    case CNCLWB: Row_printBytes(str, pp->io_cancelled_write_bytes, coloring); return;
    case IO_READ_RATE:  Row_printRate(str, pp->io_rate_read_bps, coloring); return;
    case IO_WRITE_RATE: Row_printRate(str, pp->io_rate_write_bps, coloring); return;
-   case IO_RATE: Row_printRate(str, PCPProcess_totalIORate(pp), coloring); return;
+   case IO_RATE: Row_printRate(str, Process_showsSubtree(&pp->super) ? pp->super.subtree_io_rate : PCPProcess_totalIORate(pp), coloring); return;
    case CGROUP: xSnprintf(buffer, n, "%-35.35s ", pp->cgroup ? pp->cgroup : "N/A"); break;
    case CCGROUP: xSnprintf(buffer, n, "%-35.35s ", pp->cgroup_short ? pp->cgroup_short : (pp->cgroup ? pp->cgroup : "N/A")); break;
    case CONTAINER: xSnprintf(buffer, n, "%-35.35s ", pp->container_short ? pp->container_short : "N/A"); break;
@@ -303,6 +303,9 @@ const ProcessClass PCPProcess_class = {
       .isVisible = Process_rowIsVisible,
       .matchesFilter = Process_rowMatchesFilter,
       .compareByParent = Process_compareByParent,
+      .subtreeReset = Process_subtreeReset,
+      .subtreeAdd = Process_subtreeAdd,
+      .sortKeyValue = Process_rowSortKeyValue,
       .sortKeyString = Process_rowGetSortKey,
       .writeField = PCPProcess_rowWriteField,
    },
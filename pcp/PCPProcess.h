@@ -98,6 +98,9 @@ Process* PCPProcess_new(const Machine* host);
 
 void Process_delete(Object* cast);
 
+/* Storage read and write rate in bytes per second, NAN if unknown */
+double PCPProcess_totalIORate(const PCPProcess* pp);
+
 bool Process_isThread(const Process* this);
 
 #endif
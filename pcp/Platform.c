@@ -32,6 +32,7 @@ in the source distribution for its full text.
 #include "MemorySwapMeter.h"
 #include "Meter.h"
 #include "NetworkIOMeter.h"
+#include "OverheadMeter.h"
 #include "ProcessTable.h"
 #include "Settings.h"
 #include "SwapMeter.h"
@@ -48,6 +49,7 @@ in the source distribution for its full text.
 #include "pcp/PCPDynamicMeter.h"
 #include "pcp/PCPDynamicScreen.h"
 #include "pcp/PCPMachine.h"
+#include "pcp/PCPProcess.h"
 #include "pcp/PCPProcessTable.h"
 #include "zfs/ZfsArcMeter.h"
 #include "zfs/ZfsArcStats.h"
@@ -141,6 +143,7 @@ const MeterClass* const Platform_meterTypes[] = {
    &NetworkIOMeter_class,
    &SysArchMeter_class,
    &FileDescriptorMeter_class,
+   &OverheadMeter_class,
    &BlankMeter_class,
    &DynamicMeter_class,
    NULL
@@ -852,6 +855,10 @@ bool Platform_getNetworkIO(NetworkIOData* data) {
    return true;
 }
 
+double Platform_getProcessIORate(const Process* proc) {
+   return PCPProcess_totalIORate((const PCPProcess*) proc);
+}
+
 void Platform_getFileDescriptors(double* used, double* max) {
    *used = NAN;
    *max = 65536;
@@ -27,6 +27,7 @@ in the source distribution for its full text.
 #include "CPUMeter.h"
 #include "MemoryMeter.h"
 #include "MemorySwapMeter.h"
+#include "OverheadMeter.h"
 #include "SwapMeter.h"
 #include "TasksMeter.h"
 #include "LoadAverageMeter.h"
@@ -126,6 +127,7 @@ const MeterClass* const Platform_meterTypes[] = {
    &HostnameMeter_class,
    &SysArchMeter_class,
    &UptimeMeter_class,
+   &OverheadMeter_class,
    &SecondsUptimeMeter_class,
    &AllCPUsMeter_class,
    &AllCPUs2Meter_class,
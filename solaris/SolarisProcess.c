@@ -129,6 +129,41 @@ static int SolarisProcess_compareByKey(const Process* v1, const Process* v2, Pro
    }
 }
 
+static bool SolarisProcess_sortKeyValue(const Process* super, ProcessField key, uint64_t* value) {
+   const SolarisProcess* sp = (const SolarisProcess*) super;
+
+   switch (key) {
+   case ZONEID:
+      *value = Row_sortKeySigned(sp->zoneid);
+      return true;
+   case PROJID:
+      *value = Row_sortKeySigned(sp->projid);
+      return true;
+   case TASKID:
+      *value = Row_sortKeySigned(sp->taskid);
+      return true;
+   case POOLID:
+      *value = Row_sortKeySigned(sp->poolid);
+      return true;
+   case CONTID:
+      *value = Row_sortKeySigned(sp->contid);
+      return true;
+   case PID:
+      *value = Row_sortKeySigned(sp->realpid);
+      return true;
+   case PPID:
+      *value = Row_sortKeySigned(sp->realppid);
+      return true;
+   case LWPID:
+      *value = Row_sortKeySigned(sp->lwpid);
+      return true;
+   case ZONE:
+      return false;
+   default:
+      return Process_sortKeyValue_Base(super, key, value);
+   }
+}
+
 const ProcessClass SolarisProcess_class = {
    .super = {
       .super = {
@@ -141,8 +176,12 @@ const ProcessClass SolarisProcess_class = {
       .isVisible = Process_rowIsVisible,
       .matchesFilter = Process_rowMatchesFilter,
       .compareByParent = Process_compareByParent,
+      .subtreeReset = Process_subtreeReset,
+      .subtreeAdd = Process_subtreeAdd,
+      .sortKeyValue = Process_rowSortKeyValue,
       .sortKeyString = Process_rowGetSortKey,
       .writeField = SolarisProcess_rowWriteField
    },
-   .compareByKey = SolarisProcess_compareByKey
+   .compareByKey = SolarisProcess_compareByKey,
+   .sortKeyValue = SolarisProcess_sortKeyValue
 };